@@ -31,6 +31,7 @@
 #include "xeve.h"
 #include "xeve_app_util.h"
 #include "xeve_app_args.h"
+#include "xeve_app_io.h"
 
 #if LINUX
 #include <signal.h>
@@ -951,10 +952,15 @@ int main(int argc, const char **argv)
     double             bitrate;
     double             psnr[3] = { 0, };
     double             psnr_avg[3] = { 0, };
+    double             ssim_avg = 0;
+    double             split_cand = 0, split_pruned = 0;
+    double             static_cu = 0;
     int                encod_frames = 0;
-    IMGB_LIST          ilist_org[MAX_BUMP_FRM_CNT];
-    IMGB_LIST          ilist_rec[MAX_BUMP_FRM_CNT];
+    IMGB_LIST          ilist_org[MAX_BUMP_FRM_CNT] = { 0, };
+    IMGB_LIST          ilist_rec[MAX_BUMP_FRM_CNT] = { 0, };
     IMGB_LIST        * ilist_t = NULL;
+    APP_READER         reader = { 0, };
+    APP_WRITER         writer = { 0, };
     static int         is_first_enc = 1;
     int                is_y4m = 0;
     Y4M_INFO           y4m;
@@ -963,6 +969,7 @@ int main(int argc, const char **argv)
     ARGS_PARSER      * args = NULL;
     char               fname_inp[MAX_INP_STR_SIZE], fname_out[MAX_INP_STR_SIZE], fname_rec[MAX_INP_STR_SIZE];
     int                is_out = 0, is_rec = 0;
+    int                keep_org, use_rec;
     int                max_frames = 0;
     int                skip_frames = 0;
     int                is_max_frames = 0, is_skip_frames = 0;
@@ -1127,6 +1134,14 @@ int main(int argc, const char **argv)
         ret = -1; goto ERR;
     }
 
+    /* the encoder measures PSNR on its own copy of the original, except with
+       DRA where it only holds the converted picture */
+    keep_org = (op_verbose == VERBOSE_FRAME) && param->tool_dra;
+    if (op_verbose == VERBOSE_FRAME && !param->tool_dra && param->calc_metrics == 0)
+    {
+        param->calc_metrics = 1;
+    }
+
     if (args->get_str(args, "output", fname_out, &is_out))
     {
         logerr("cannot get 'output' option\n");
@@ -1181,17 +1196,33 @@ int main(int argc, const char **argv)
     width = (param->w + 7) & 0xFFF8;
     height = (param->h + 7) & 0xFFF8;
     /* create image lists */
-    if(imgb_list_alloc(ilist_org, width, height, args->input_depth, color_format))
+    use_rec = is_rec || keep_org;
+    if(imgb_list_alloc(ilist_org, keep_org ? MAX_BUMP_FRM_CNT : 1, width, height, args->input_depth, color_format))
     {
         logerr("cannot allocate image list for input pictures\n");
         ret = -1; goto ERR;
     }
-    if(imgb_list_alloc(ilist_rec, width, height, param->codec_bit_depth, color_format))
+    if(imgb_list_alloc(ilist_rec, use_rec ? MAX_BUMP_FRM_CNT : 0, width, height, param->codec_bit_depth, color_format))
     {
         logerr("cannot allocate image list for reconstructed pictures\n");
         ret = -1; goto ERR;
     }
 
+    /* create input reader and output writer */
+    if(reader_create(&reader, args->async_io, fp_inp, param->w, param->h, is_y4m,
+                     is_max_frames ? skip_frames + max_frames : -1,
+                     width, height, XEVE_CS_SET(color_format, args->input_depth, 0)))
+    {
+        logerr("cannot create input reader\n");
+        ret = -1; goto ERR;
+    }
+    if(writer_create(&writer, args->async_io, is_out ? fname_out : NULL, is_rec ? args->fname_rec : NULL,
+                     param->w, param->h, width, height, XEVE_CS_SET(color_format, param->codec_bit_depth, 0)))
+    {
+        logerr("cannot create output writer\n");
+        ret = -1; goto ERR;
+    }
+
     print_config(args, param);
     print_stat_init(args);
 
@@ -1222,7 +1253,7 @@ int main(int argc, const char **argv)
                     logerr("cannot get empty orignal buffer\n");
                     ret = -1; goto ERR;
                 }
-                if(imgb_read(fp_inp, ilist_t->imgb, param->w, param->h, is_y4m))
+                if(reader_get(&reader, ilist_t))
                 {
                     logv3("reached end of original file (or reading error)\n");
                     ret = -1; goto ERR;
@@ -1246,7 +1277,7 @@ int main(int argc, const char **argv)
                 ret = -1; goto ERR;
             }
             /* read original image */
-            ret = imgb_read(fp_inp, ilist_t->imgb, param->w, param->h, is_y4m);
+            ret = reader_get(&reader, ilist_t);
             if ((ret < 0) || (is_max_frames && (pic_icnt >= max_frames)))
             {
                 if(ret < 0)
@@ -1269,6 +1300,11 @@ int main(int argc, const char **argv)
                 ret = -1; goto ERR;
             }
             pic_icnt++;
+            if (!keep_org)
+            {
+                /* the encoder has its own copy */
+                imgb_list_make_unused(ilist_t);
+            }
         }
         /* encoding */
         clk_beg = xeve_clk_get();
@@ -1293,34 +1329,42 @@ int main(int argc, const char **argv)
         {
             if(is_out && stat.write > 0)
             {
-                if(write_data(fname_out, bs_buf, stat.write))
+                if(writer_put_bs(&writer, bs_buf, stat.write))
                 {
                     logerr("cannot write bitstream\n");
                     ret = -1; goto ERR;
                 }
             }
 
-            /* get reconstructed image */
-            size = sizeof(XEVE_IMGB**);
-            ret = xeve_config(id, XEVE_CFG_GET_RECON, (void *)&imgb_rec, &size);
-            if(XEVE_FAILED(ret))
+            if (use_rec)
             {
-                logerr("failed to get reconstruction image\n");
-                ret = -1; goto ERR;
-            }
+                /* get reconstructed image */
+                size = sizeof(XEVE_IMGB**);
+                ret = xeve_config(id, XEVE_CFG_GET_RECON, (void *)&imgb_rec, &size);
+                if(XEVE_FAILED(ret))
+                {
+                    logerr("failed to get reconstruction image\n");
+                    ret = -1; goto ERR;
+                }
 
-            /* store reconstructed image to list */
-            ilist_t = imgb_list_put(ilist_rec, imgb_rec, imgb_rec->ts[XEVE_TS_PTS]);
-            if(ilist_t == NULL)
-            {
-                logerr("cannot put reconstructed image to list\n");
-                ret = -1; goto ERR;
+                /* store reconstructed image to list */
+                ilist_t = imgb_list_put(ilist_rec, imgb_rec, imgb_rec->ts[XEVE_TS_PTS]);
+                if(ilist_t == NULL)
+                {
+                    logerr("cannot put reconstructed image to list\n");
+                    ret = -1; goto ERR;
+                }
             }
 
             /* calculate PSNR */
             if (op_verbose  == VERBOSE_FRAME)
             {
-                if(cal_psnr(ilist_org, ilist_t->imgb, ilist_t->ts,
+                if(!keep_org)
+                {
+                    for (i = 0; i < 3; i++) psnr[i] = stat.psnr[i];
+                    ssim_avg += stat.ssim;
+                }
+                else if(cal_psnr(ilist_org, ilist_t->imgb, ilist_t->ts,
                     args->input_depth, param->codec_bit_depth, psnr))
                 {
                     logerr("cannot calculate PSNR\n");
@@ -1337,25 +1381,38 @@ int main(int argc, const char **argv)
                 }
                 for (i = 0; i < 3; i++) psnr_avg[i] += psnr[i];
             }
-            /* release original image */
-            imgb_list_find_and_make_unused(ilist_org, ilist_t->ts);
-
-            /* release recon image */
-            ilist_t = imgb_list_find(ilist_rec, pic_ocnt);
-            if (ilist_t != NULL)
+            if (!use_rec)
             {
-                if(is_rec)
+                pic_ocnt++;
+            }
+            else
+            {
+                /* release original image */
+                if (keep_org)
+                {
+                    imgb_list_find_and_make_unused(ilist_org, ilist_t->ts);
+                }
+
+                /* release recon image */
+                ilist_t = imgb_list_find(ilist_rec, pic_ocnt);
+                if (ilist_t != NULL)
                 {
-                    if(imgb_write(args->fname_rec, ilist_t->imgb, param->w, param->h))
+                    if(is_rec)
                     {
-                        logerr("cannot write reconstruction image\n");
-                        ret = -1; goto ERR;
+                        if(writer_put_rec(&writer, ilist_t))
+                        {
+                            logerr("cannot write reconstruction image\n");
+                            ret = -1; goto ERR;
+                        }
                     }
+                    imgb_list_make_unused(ilist_t);
+                    pic_ocnt++;
                 }
-                imgb_list_make_unused(ilist_t);
-                pic_ocnt++;
             }
             bitrate += (stat.write - stat.sei_size);
+            split_cand += stat.split_cand;
+            split_pruned += stat.split_pruned;
+            static_cu += stat.static_cu;
 
             if (op_verbose >= VERBOSE_SIMPLE)
             {
@@ -1410,7 +1467,7 @@ int main(int argc, const char **argv)
         {
             if(is_rec)
             {
-                if(imgb_write(args->fname_rec, ilist_t->imgb, param->w, param->h))
+                if(writer_put_rec(&writer, ilist_t))
                 {
                     logerr("cannot write reconstruction image\n");
                     ret = -1; goto ERR;
@@ -1425,6 +1482,13 @@ int main(int argc, const char **argv)
         logv3("number of input(=%d) and output(=%d) is not matched\n", (int)pic_icnt, (int)pic_ocnt);
     }
 
+    reader_delete(&reader);
+    if(writer_delete(&writer))
+    {
+        logerr("cannot write bitstream or reconstruction image\n");
+        ret = -1; goto ERR;
+    }
+
     ret = 0;
 
     logv2_line("Summary");
@@ -1435,6 +1499,10 @@ int main(int argc, const char **argv)
     logv3("  PSNR Y(dB)       : %-5.4f\n", psnr_avg[0]);
     logv3("  PSNR U(dB)       : %-5.4f\n", psnr_avg[1]);
     logv3("  PSNR V(dB)       : %-5.4f\n", psnr_avg[2]);
+    if (!keep_org && param->calc_metrics == 2)
+    {
+        logv3("  SSIM Y           : %-5.4f\n", ssim_avg / pic_ocnt);
+    }
     logv3("  Total bits(bits) : %.0f\n", bitrate * 8);
     bitrate *= ((double)param->fps.num/ param->fps.den * 8);
     bitrate /= pic_ocnt;
@@ -1453,6 +1521,22 @@ int main(int argc, const char **argv)
         (float)xeve_clk_msec(clk_tot)/pic_ocnt);
     logv2("Average encoding speed            = %.3f frames/sec\n",
         ((float)pic_ocnt * 1000) / ((float)xeve_clk_msec(clk_tot)));
+    if (split_cand > 0)
+    {
+        logv2("Fast split pruning rate           = %.2f %% (%.0f / %.0f)\n",
+            split_pruned * 100 / split_cand, split_pruned, split_cand);
+    }
+    if (static_cu > 0)
+    {
+        logv2("Static CUs skipped RDO            = %.0f\n", static_cu);
+    }
+    if (args->async_io)
+    {
+        logv2("I/O wait of encoder (in / out)    = %.3f / %.3f sec\n",
+            (float)(xeve_clk_msec(reader.clk_wait)/1000.0), (float)(xeve_clk_msec(writer.clk_wait)/1000.0));
+        logv2("I/O thread busy (read / write)    = %.3f / %.3f sec\n",
+            (float)(xeve_clk_msec(reader.clk_read)/1000.0), (float)(xeve_clk_msec(writer.clk_write)/1000.0));
+    }
     logv2_line(NULL);
 
     if (is_max_frames && pic_ocnt != max_frames)
@@ -1461,6 +1545,8 @@ int main(int argc, const char **argv)
     }
 
 ERR:
+    reader_delete(&reader);
+    writer_delete(&writer);
     if(id) xeve_delete(id);
     imgb_list_free(ilist_org);
     imgb_list_free(ilist_rec);
@@ -119,6 +119,15 @@ static const ARGS_OPT args_opt_table[] = \
         'm',  "threads", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "force to use a specific number of threads"
     },
+    {
+        ARGS_NO_KEY,  "cpu-set", ARGS_VAL_TYPE_STRING, 0, NULL,
+        "pin encoding threads to a list of CPUs (ex: 0-7,16-23)"
+    },
+    {
+        ARGS_NO_KEY,  "numa-node", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "pin encoding threads and their memory to a NUMA node\n"
+        "      - -1: no binding (default)"
+    },
     {
         'd',  "input-depth", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "input bit depth (8, 10) "
@@ -153,6 +162,63 @@ static const ARGS_OPT args_opt_table[] = \
         "Encoder TUNE"
         "\t [psnr, zerolatency]"
     },
+    {
+        ARGS_NO_KEY,  "ipd-presel", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "number of intra modes pre-selected by 8x8 unit SATD for the\n"
+        "      prediction of CUs larger than 8x8 (main profile)\n"
+        "      - -1: by preset (default)\n"
+        "      - 0: off\n"
+        "      - 1~33: number of modes"
+    },
+    {
+        ARGS_NO_KEY,  "rdo-bit-est", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "bit counting of rate-distortion optimization\n"
+        "      - 0: arithmetic coding (default)\n"
+        "      - 1: table-driven estimation from context states"
+    },
+    {
+        ARGS_NO_KEY,  "intra-refresh", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "periodic intra refresh instead of periodic I pictures (low delay only)\n"
+        "      - 0: off (default)\n"
+        "      - 1: a column of intra CTUs sweeps the picture every keyint frames"
+    },
+    {
+        ARGS_NO_KEY,  "pass", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "multi-pass encoding\n"
+        "      - 0: single pass (default)\n"
+        "      - 1: first pass, use a fast preset and write the stats file\n"
+        "      - 2: second pass, read the stats file"
+    },
+    {
+        ARGS_NO_KEY,  "stats-file", ARGS_VAL_TYPE_STRING, 0, NULL,
+        "statistics file of multi-pass encoding (default: xeve_2pass.stats)"
+    },
+    {
+        ARGS_NO_KEY,  "fcst-level", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "lookahead pyramid level of the forecast cost maps\n"
+        "      - 0: half resolution (default)\n"
+        "      - 1: quarter resolution\n"
+        "      - 2: eighth resolution"
+    },
+    {
+        ARGS_NO_KEY,  "static-th", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "threshold of the static CTU skip fast path in 1/16 of an 8-bit\n"
+        "      luma sample, for screen content and fixed cameras (0: off)"
+    },
+    {
+        ARGS_NO_KEY,  "calc-metrics", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "quality metrics measured by the encoder for each picture\n"
+        "      - 0: off (PSNR is measured by the application at -v 3)\n"
+        "      - 1: PSNR of each plane\n"
+        "      - 2: PSNR and luma SSIM"
+    },
+    {
+        ARGS_NO_KEY,  "mc-cache", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "reuse the prediction of skip, merge and MMVD candidates already\n"
+        "      evaluated in the CTU (main profile, same output)\n"
+        "      - 0: off\n"
+        "      - 1: on (default)"
+    },
     {
         ARGS_NO_KEY,  "aq-mode", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "use adaptive quantization block qp adaptation\n"
@@ -167,6 +233,12 @@ static const ARGS_OPT args_opt_table[] = \
         ARGS_NO_KEY,  "seek", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "number of skipped frames before encoding"
     },
+    {
+        ARGS_NO_KEY,  "async-io", ARGS_VAL_TYPE_INTEGER, 0, NULL,
+        "read input and write outputs in separate threads\n"
+        "      - 0: off\n"
+        "      - 1: on (default)"
+    },
     {
         ARGS_NO_KEY,  "info", ARGS_VAL_TYPE_INTEGER, 0, NULL,
         "embed SEI messages identifying encoder parameters and command line arguments"
@@ -664,6 +736,7 @@ struct _ARGS_PARSER
     int input_depth;
     int input_csp;
     int seek;
+    int async_io;
     char profile[32];
     char preset[32];
     char tune[32];
@@ -1022,6 +1095,8 @@ static int args_init(ARGS_PARSER * args, XEVE_PARAM* param)
     args_set_variable_by_key_long(opts, "input-csp", &args->input_csp);
     args->input_csp = 1; /* default */
     args_set_variable_by_key_long(opts, "seek", &args->seek);
+    args_set_variable_by_key_long(opts, "async-io", &args->async_io);
+    args->async_io = 1; /* default */
     args_set_variable_by_key_long(opts, "profile", args->profile);
     strcpy(args->profile, "baseline"); /* default */
     args_set_variable_by_key_long(opts, "preset", args->preset);
@@ -1092,6 +1167,17 @@ static int args_init(ARGS_PARSER * args, XEVE_PARAM* param)
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, keyint);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, bframes);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, threads);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, cpu_set);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, numa_node);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, ipd_presel);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, rdo_bit_est);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, intra_refresh);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, pass);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, stats_file);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, fcst_level);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, static_th);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, calc_metrics);
+    ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, mc_cache);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, codec_bit_depth);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, closed_gop);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, disable_hgop);
@@ -1117,6 +1203,16 @@ static int args_init(ARGS_PARSER * args, XEVE_PARAM* param)
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, log2_max_mv_length_vertical);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, num_reorder_pics);
     ARGS_SET_PARAM_VAR_KEY_LONG(opts, param, max_dec_pic_buffering);
+    args_set_variable_by_key_long(opts, "tile-uniform-spacing", &param->tile_uniform_spacing_flag);
+    args_set_variable_by_key_long(opts, "num-tile-columns", &param->tile_columns);
+    args_set_variable_by_key_long(opts, "num-tile-rows", &param->tile_rows);
+    args_set_variable_by_key_long(opts, "tile-column-width-array", param->tile_column_width_array);
+    args_set_variable_by_key_long(opts, "tile-row-height-array", param->tile_row_height_array);
+    args_set_variable_by_key_long(opts, "num-slices-in-pic", &param->num_slice_in_pic);
+    args_set_variable_by_key_long(opts, "tile-array-in-slice", param->tile_array_in_slice);
+    args_set_variable_by_key_long(opts, "arbitrary-slice-flag", &param->arbitrary_slice_flag);
+    args_set_variable_by_key_long(opts, "num-remaining-tiles-in-slice", param->num_remaining_tiles_in_slice_minus1);
+    args_set_variable_by_key_long(opts, "lp-filter-across-tiles-en-flag", &param->loop_filter_across_tiles_enabled_flag);
 
 
 #if 0
@@ -0,0 +1,502 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _XEVEA_APP_IO_H_
+#define _XEVEA_APP_IO_H_
+
+/*****************************************************************************
+ * asynchronous file I/O
+ *
+ * a reader thread fills input pictures ahead of the encoder and a writer
+ * thread stores the bitstream and the reconstructed pictures, both through
+ * bounded queues. pictures are handed over by swapping XEVE_IMGB pointers
+ * with the image lists of the encoding loop, so no frame is copied.
+ *****************************************************************************/
+#include "xeve_app_util.h"
+
+#if defined(_WIN64) || defined(_WIN32)
+#include <windows.h>
+typedef HANDLE             APP_THREAD;
+typedef CRITICAL_SECTION   APP_MUTEX;
+typedef CONDITION_VARIABLE APP_COND;
+#define app_mutex_init(m)  InitializeCriticalSection(m)
+#define app_mutex_del(m)   DeleteCriticalSection(m)
+#define app_mutex_lock(m)  EnterCriticalSection(m)
+#define app_mutex_unlock(m) LeaveCriticalSection(m)
+#define app_cond_init(c)   InitializeConditionVariable(c)
+#define app_cond_del(c)
+#define app_cond_wait(c,m) SleepConditionVariableCS(c, m, INFINITE)
+#define app_cond_signal(c) WakeConditionVariable(c)
+#define APP_THREAD_FUNC(f) static DWORD WINAPI f(LPVOID arg)
+
+static int app_thread_create(APP_THREAD * t, LPTHREAD_START_ROUTINE f, void * arg)
+{
+    *t = CreateThread(NULL, 0, f, arg, 0, NULL);
+    return (*t == NULL) ? -1 : 0;
+}
+
+static void app_thread_join(APP_THREAD t)
+{
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+#else
+#include <pthread.h>
+typedef pthread_t          APP_THREAD;
+typedef pthread_mutex_t    APP_MUTEX;
+typedef pthread_cond_t     APP_COND;
+#define app_mutex_init(m)  pthread_mutex_init(m, NULL)
+#define app_mutex_del(m)   pthread_mutex_destroy(m)
+#define app_mutex_lock(m)  pthread_mutex_lock(m)
+#define app_mutex_unlock(m) pthread_mutex_unlock(m)
+#define app_cond_init(c)   pthread_cond_init(c, NULL)
+#define app_cond_del(c)    pthread_cond_destroy(c)
+#define app_cond_wait(c,m) pthread_cond_wait(c, m)
+#define app_cond_signal(c) pthread_cond_signal(c)
+#define APP_THREAD_FUNC(f) static void * f(void * arg)
+
+static int app_thread_create(APP_THREAD * t, void * (*f)(void *), void * arg)
+{
+    return pthread_create(t, NULL, f, arg) ? -1 : 0;
+}
+
+static void app_thread_join(APP_THREAD t)
+{
+    pthread_join(t, NULL);
+}
+#endif
+
+/* number of pictures in flight between a file and the encoding loop */
+#define APP_IO_QUEUE_SIZE          (4)
+
+typedef struct _APP_READER
+{
+    int          async;
+    FILE       * fp;
+    int          w, h, is_y4m;
+    int          max_read; /* -1 for no limit */
+    int          read_cnt;
+
+    XEVE_IMGB  * imgb[APP_IO_QUEUE_SIZE];
+    int          ret[APP_IO_QUEUE_SIZE];
+    int          head, cnt; /* filled slots */
+    int          stop;
+
+    APP_THREAD   thread;
+    APP_MUTEX    mutex;
+    APP_COND     cond_filled;
+    APP_COND     cond_empty;
+
+    XEVE_CLK     clk_wait; /* encoding loop waiting for input */
+    XEVE_CLK     clk_read; /* reader thread reading */
+} APP_READER;
+
+typedef struct _APP_WRITER_ITEM
+{
+    unsigned char * bs;
+    int             bs_size;
+    int             bs_alloc;
+    XEVE_IMGB     * rec; /* NULL for bitstream */
+} APP_WRITER_ITEM;
+
+typedef struct _APP_WRITER
+{
+    int             async;
+    char          * fname_bs;
+    char          * fname_rec;
+    FILE          * fp_bs;
+    FILE          * fp_rec;
+    int             w, h;
+    int             err;
+
+    APP_WRITER_ITEM item[APP_IO_QUEUE_SIZE];
+    XEVE_IMGB     * rec_free[APP_IO_QUEUE_SIZE];
+    int             head, cnt; /* queued items */
+    int             stop;
+
+    APP_THREAD      thread;
+    APP_MUTEX       mutex;
+    APP_COND        cond_queued;
+    APP_COND        cond_done;
+
+    XEVE_CLK        clk_wait; /* encoding loop waiting for a free slot */
+    XEVE_CLK        clk_write; /* writer thread writing */
+} APP_WRITER;
+
+APP_THREAD_FUNC(reader_run)
+{
+    APP_READER * rd = (APP_READER *)arg;
+    XEVE_CLK     clk;
+    int          idx, ret;
+
+    app_mutex_lock(&rd->mutex);
+    while(!rd->stop)
+    {
+        if(rd->cnt == APP_IO_QUEUE_SIZE)
+        {
+            app_cond_wait(&rd->cond_empty, &rd->mutex);
+            continue;
+        }
+        idx = (rd->head + rd->cnt) % APP_IO_QUEUE_SIZE;
+        app_mutex_unlock(&rd->mutex);
+
+        clk = xeve_clk_get();
+        if(rd->max_read >= 0 && rd->read_cnt >= rd->max_read)
+        {
+            ret = -1;
+        }
+        else
+        {
+            ret = imgb_read(rd->fp, rd->imgb[idx], rd->w, rd->h, rd->is_y4m);
+        }
+        rd->read_cnt++;
+
+        app_mutex_lock(&rd->mutex);
+        rd->clk_read += xeve_clk_from(clk);
+        rd->ret[idx] = ret;
+        rd->cnt++;
+        app_cond_signal(&rd->cond_filled);
+        if(ret < 0)
+        {
+            break; /* end of file: the last slot keeps reporting it */
+        }
+    }
+    app_mutex_unlock(&rd->mutex);
+    return 0;
+}
+
+static int reader_create(APP_READER * rd, int async, FILE * fp, int w, int h, int is_y4m,
+                         int max_read, int alloc_w, int alloc_h, int cs)
+{
+    int i;
+
+    memset(rd, 0, sizeof(APP_READER));
+    rd->async = async;
+    rd->fp = fp;
+    rd->w = w;
+    rd->h = h;
+    rd->is_y4m = is_y4m;
+    rd->max_read = max_read;
+    if(!async)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < APP_IO_QUEUE_SIZE; i++)
+    {
+        rd->imgb[i] = imgb_alloc(alloc_w, alloc_h, cs);
+        if(rd->imgb[i] == NULL) return -1;
+    }
+    app_mutex_init(&rd->mutex);
+    app_cond_init(&rd->cond_filled);
+    app_cond_init(&rd->cond_empty);
+    if(app_thread_create(&rd->thread, reader_run, rd))
+    {
+        logerr("cannot create reader thread\n");
+        rd->async = 0;
+        return -1;
+    }
+    return 0;
+}
+
+static void reader_delete(APP_READER * rd)
+{
+    int i;
+
+    if(rd->async)
+    {
+        app_mutex_lock(&rd->mutex);
+        rd->stop = 1;
+        app_cond_signal(&rd->cond_empty);
+        app_mutex_unlock(&rd->mutex);
+        app_thread_join(rd->thread);
+
+        app_cond_del(&rd->cond_filled);
+        app_cond_del(&rd->cond_empty);
+        app_mutex_del(&rd->mutex);
+        rd->async = 0;
+    }
+    for(i = 0; i < APP_IO_QUEUE_SIZE; i++)
+    {
+        if(rd->imgb[i]) { imgb_free(rd->imgb[i]); rd->imgb[i] = NULL; }
+    }
+}
+
+/* get the next input picture into the given list entry, -1 at the end of file */
+static int reader_get(APP_READER * rd, IMGB_LIST * ilist)
+{
+    XEVE_CLK    clk;
+    XEVE_IMGB * imgb;
+    int         ret;
+
+    if(!rd->async)
+    {
+        return imgb_read(rd->fp, ilist->imgb, rd->w, rd->h, rd->is_y4m);
+    }
+
+    clk = xeve_clk_get();
+    app_mutex_lock(&rd->mutex);
+    while(rd->cnt == 0)
+    {
+        app_cond_wait(&rd->cond_filled, &rd->mutex);
+    }
+    rd->clk_wait += xeve_clk_from(clk);
+
+    ret = rd->ret[rd->head];
+    if(ret >= 0)
+    {
+        imgb = ilist->imgb;
+        ilist->imgb = rd->imgb[rd->head];
+        rd->imgb[rd->head] = imgb;
+
+        rd->head = (rd->head + 1) % APP_IO_QUEUE_SIZE;
+        rd->cnt--;
+        app_cond_signal(&rd->cond_empty);
+    }
+    app_mutex_unlock(&rd->mutex);
+    return ret;
+}
+
+static int writer_store(APP_WRITER * wr, APP_WRITER_ITEM * item)
+{
+    if(item->rec)
+    {
+        return imgb_write_fp(wr->fp_rec, item->rec, wr->w, wr->h);
+    }
+    return (fwrite(item->bs, 1, item->bs_size, wr->fp_bs) != (size_t)item->bs_size) ? -1 : 0;
+}
+
+APP_THREAD_FUNC(writer_run)
+{
+    APP_WRITER      * wr = (APP_WRITER *)arg;
+    APP_WRITER_ITEM * item;
+    XEVE_CLK          clk;
+    int               ret;
+
+    app_mutex_lock(&wr->mutex);
+    while(1)
+    {
+        if(wr->cnt == 0)
+        {
+            if(wr->stop) break;
+            app_cond_wait(&wr->cond_queued, &wr->mutex);
+            continue;
+        }
+        item = &wr->item[wr->head];
+        app_mutex_unlock(&wr->mutex);
+
+        clk = xeve_clk_get();
+        ret = writer_store(wr, item);
+
+        app_mutex_lock(&wr->mutex);
+        wr->clk_write += xeve_clk_from(clk);
+        if(ret) wr->err = ret;
+        wr->head = (wr->head + 1) % APP_IO_QUEUE_SIZE;
+        wr->cnt--;
+        app_cond_signal(&wr->cond_done);
+    }
+    app_mutex_unlock(&wr->mutex);
+    return 0;
+}
+
+static int writer_create(APP_WRITER * wr, int async, char * fname_bs, char * fname_rec,
+                         int w, int h, int alloc_w, int alloc_h, int cs_rec)
+{
+    int i;
+
+    memset(wr, 0, sizeof(APP_WRITER));
+    wr->async = async;
+    wr->fname_bs = fname_bs;
+    wr->fname_rec = fname_rec;
+    wr->w = w;
+    wr->h = h;
+    if(!async)
+    {
+        return 0;
+    }
+
+    /* files stay opened while the thread runs */
+    if(fname_bs)
+    {
+        wr->fp_bs = fopen(fname_bs, "ab");
+        if(wr->fp_bs == NULL)
+        {
+            logerr("cannot open an writing file=%s\n", fname_bs);
+            return -1;
+        }
+    }
+    if(fname_rec)
+    {
+        wr->fp_rec = fopen(fname_rec, "ab");
+        if(wr->fp_rec == NULL)
+        {
+            logerr("cannot open file = %s\n", fname_rec);
+            return -1;
+        }
+        for(i = 0; i < APP_IO_QUEUE_SIZE; i++)
+        {
+            wr->rec_free[i] = imgb_alloc(alloc_w, alloc_h, cs_rec);
+            if(wr->rec_free[i] == NULL) return -1;
+        }
+    }
+    app_mutex_init(&wr->mutex);
+    app_cond_init(&wr->cond_queued);
+    app_cond_init(&wr->cond_done);
+    if(app_thread_create(&wr->thread, writer_run, wr))
+    {
+        logerr("cannot create writer thread\n");
+        wr->async = 0;
+        return -1;
+    }
+    return 0;
+}
+
+/* wait for the queued data to be stored, returns the first writing error */
+static int writer_delete(APP_WRITER * wr)
+{
+    int i;
+
+    if(wr->async)
+    {
+        app_mutex_lock(&wr->mutex);
+        wr->stop = 1;
+        app_cond_signal(&wr->cond_queued);
+        app_mutex_unlock(&wr->mutex);
+        app_thread_join(wr->thread);
+
+        app_cond_del(&wr->cond_queued);
+        app_cond_del(&wr->cond_done);
+        app_mutex_del(&wr->mutex);
+        wr->async = 0;
+    }
+    for(i = 0; i < APP_IO_QUEUE_SIZE; i++)
+    {
+        if(wr->item[i].rec) { imgb_free(wr->item[i].rec); wr->item[i].rec = NULL; }
+        if(wr->item[i].bs) { free(wr->item[i].bs); wr->item[i].bs = NULL; }
+        if(wr->rec_free[i]) { imgb_free(wr->rec_free[i]); wr->rec_free[i] = NULL; }
+    }
+    if(wr->fp_bs) { fclose(wr->fp_bs); wr->fp_bs = NULL; }
+    if(wr->fp_rec) { fclose(wr->fp_rec); wr->fp_rec = NULL; }
+    return wr->err;
+}
+
+/* get a free queue slot, the mutex stays locked until writer_push() */
+static APP_WRITER_ITEM * writer_get_slot(APP_WRITER * wr)
+{
+    APP_WRITER_ITEM * item;
+    XEVE_CLK          clk;
+
+    clk = xeve_clk_get();
+    app_mutex_lock(&wr->mutex);
+    while(wr->cnt == APP_IO_QUEUE_SIZE)
+    {
+        app_cond_wait(&wr->cond_done, &wr->mutex);
+    }
+    wr->clk_wait += xeve_clk_from(clk);
+
+    item = &wr->item[(wr->head + wr->cnt) % APP_IO_QUEUE_SIZE];
+    /* recycle the picture buffer of an already written recon item */
+    if(item->rec)
+    {
+        int i;
+        for(i = 0; i < APP_IO_QUEUE_SIZE; i++)
+        {
+            if(wr->rec_free[i] == NULL) { wr->rec_free[i] = item->rec; break; }
+        }
+        item->rec = NULL;
+    }
+    return item;
+}
+
+/* queue the slot, returns the last writing error */
+static int writer_push(APP_WRITER * wr)
+{
+    int err;
+
+    wr->cnt++;
+    err = wr->err;
+    app_cond_signal(&wr->cond_queued);
+    app_mutex_unlock(&wr->mutex);
+    return err;
+}
+
+static int writer_put_bs(APP_WRITER * wr, unsigned char * bs, int size)
+{
+    APP_WRITER_ITEM * item;
+
+    if(!wr->async)
+    {
+        return write_data(wr->fname_bs, bs, size);
+    }
+
+    item = writer_get_slot(wr);
+    if(item->bs_alloc < size)
+    {
+        if(item->bs) free(item->bs);
+        item->bs = (unsigned char *)malloc(size);
+        if(item->bs == NULL)
+        {
+            item->bs_alloc = 0;
+            app_mutex_unlock(&wr->mutex);
+            return -1;
+        }
+        item->bs_alloc = size;
+    }
+    memcpy(item->bs, bs, size);
+    item->bs_size = size;
+    return writer_push(wr);
+}
+
+/* the picture of the list entry is exchanged with a free buffer of the writer */
+static int writer_put_rec(APP_WRITER * wr, IMGB_LIST * ilist)
+{
+    APP_WRITER_ITEM * item;
+    int               i;
+
+    if(!wr->async)
+    {
+        return imgb_write(wr->fname_rec, ilist->imgb, wr->w, wr->h);
+    }
+
+    item = writer_get_slot(wr);
+    for(i = 0; i < APP_IO_QUEUE_SIZE; i++)
+    {
+        if(wr->rec_free[i])
+        {
+            item->rec = ilist->imgb;
+            ilist->imgb = wr->rec_free[i];
+            wr->rec_free[i] = NULL;
+            break;
+        }
+    }
+    return writer_push(wr);
+}
+
+#endif /* _XEVEA_APP_IO_H_ */
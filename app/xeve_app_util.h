@@ -241,23 +241,16 @@ static int imgb_read(FILE * fp, XEVE_IMGB * img, int width, int height, int is_y
     return 0;
 }
 
-static int imgb_write(char * fname, XEVE_IMGB * imgb, int width, int height)
+static int imgb_write_fp(FILE * fp, XEVE_IMGB * imgb, int width, int height)
 {
     unsigned char * p8;
     int             i, j, bd;
     int             cs_w_off, cs_h_off;
-    FILE          * fp;
 
     int chroma_format = XEVE_CS_GET_FORMAT(imgb->cs);
     int bit_depth = XEVE_CS_GET_BIT_DEPTH(imgb->cs);
     int w_shift = (chroma_format == XEVE_CF_YCBCR420) || (chroma_format == XEVE_CF_YCBCR422) ? 1 : 0;
     int h_shift = chroma_format == XEVE_CF_YCBCR420 ? 1 : 0;
-    fp = fopen(fname, "ab");
-    if(fp == NULL)
-    {
-        logerr("cannot open file = %s\n", fname);
-        return -1;
-    }
     if(bit_depth == 8 && (chroma_format == XEVE_CF_YCBCR400 || chroma_format == XEVE_CF_YCBCR420 || chroma_format == XEVE_CF_YCBCR422 || chroma_format == XEVE_CF_YCBCR444))
     {
         bd = 1;
@@ -273,7 +266,6 @@ static int imgb_write(char * fname, XEVE_IMGB * imgb, int width, int height)
     else
     {
         logerr("cannot support the color space\n");
-        fclose(fp);
         return -1;
     }
 
@@ -291,9 +283,23 @@ static int imgb_write(char * fname, XEVE_IMGB * imgb, int width, int height)
             p8 += imgb->s[i];
         }
     }
+    return 0;
+}
 
+static int imgb_write(char * fname, XEVE_IMGB * imgb, int width, int height)
+{
+    FILE * fp;
+    int    ret;
+
+    fp = fopen(fname, "ab");
+    if(fp == NULL)
+    {
+        logerr("cannot open file = %s\n", fname);
+        return -1;
+    }
+    ret = imgb_write_fp(fp, imgb, width, height);
     fclose(fp);
-    return 0;
+    return ret;
 }
 
 static void imgb_cpy_plane(XEVE_IMGB * dst, XEVE_IMGB * src)
@@ -559,13 +565,14 @@ typedef struct _IMGB_LIST {
     XEVE_MTIME   ts;
 } IMGB_LIST;
 
-static int imgb_list_alloc(IMGB_LIST *list, int w, int h, int bit_depth, int chroma_format)
+/* only the first cnt entries of the list get an image buffer */
+static int imgb_list_alloc(IMGB_LIST *list, int cnt, int w, int h, int bit_depth, int chroma_format)
 {
     int i;
 
     memset(list, 0, sizeof(IMGB_LIST) * MAX_BUMP_FRM_CNT);
 
-    for(i=0; i<MAX_BUMP_FRM_CNT; i++)
+    for(i=0; i<cnt; i++)
     {
         list[i].imgb = imgb_alloc(w, h, XEVE_CS_SET(chroma_format, bit_depth, 0));
         if(list[i].imgb == NULL) goto ERR;
@@ -597,7 +604,7 @@ static IMGB_LIST *imgb_list_put(IMGB_LIST *list, XEVE_IMGB *imgb, XEVE_MTIME ts)
     /* store original imgb for XEVE_TUNE_PSNR */
     for(i=0; i<MAX_BUMP_FRM_CNT; i++)
     {
-        if(list[i].used == 0)
+        if(list[i].used == 0 && list[i].imgb != NULL)
         {
             imgb_cpy(list[i].imgb, imgb);
             list[i].used = 1;
@@ -615,7 +622,7 @@ static IMGB_LIST *imgb_list_get_empty(IMGB_LIST *list)
     /* store original imgb for XEVE_TUNE_PSNR */
     for(i=0; i<MAX_BUMP_FRM_CNT; i++)
     {
-        if(list[i].used == 0)
+        if(list[i].used == 0 && list[i].imgb != NULL)
         {
             return &list[i];
         }
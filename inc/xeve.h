@@ -346,6 +346,12 @@ typedef struct _XEVE_PARAM
     int            profile;
     /* number of thread for parallel proessing */
     int            threads;
+    /* CPUs the encoding threads are pinned to, as a list of CPUs and ranges
+       (e.g. "0-7,16-23"). empty string for no pinning */
+    char           cpu_set[256];
+    /* NUMA node the encoding threads are pinned to, so that picture buffers
+       are allocated on its local memory. -1 for no binding */
+    int            numa_node;
     /* width of input frame */
     int            w;
     /* height of input frame */
@@ -510,6 +516,65 @@ typedef struct _XEVE_PARAM
     /* preset parameter */
     int            ats_intra_fast;
     int            me_fast;
+    /* predictive split early termination
+       - 0 : off
+       - 1 : conservative
+       - 2 : aggressive */
+    int            fast_split;
+    /* intra mode pre-selection (main profile). CUs larger than 8x8 rank the
+       intra modes by the sums of the SATD of their 8x8 units, and predict
+       only this number of best ranked modes along with the most probable
+       modes
+       - -1 : by preset (default)
+       - 0 : off, every mode is predicted
+       - 1 ~ 33 : number of pre-selected modes, at least the RDO list size */
+    int            ipd_presel;
+    /* bit counting of RDO
+       - 0 : run the arithmetic coder
+       - 1 : sum the table-driven fractional bits of context states */
+    int            rdo_bit_est;
+    /* periodic intra refresh of low delay coding
+       - 0 : off
+       - 1 : a column of intra CTUs sweeps the picture every keyint pictures
+             (or every number of CTU columns if keyint is 0) instead of
+             periodic I pictures */
+    int            intra_refresh;
+    /* multi-pass encoding
+       - 0 : single pass
+       - 1 : first pass, writes the analysis of every picture to stats_file
+       - 2 : second pass, reads stats_file for the bit allocation of ABR and
+             to seed the split decision and the motion search */
+    int            pass;
+    /* statistics file of multi-pass encoding */
+    char           stats_file[256];
+    /* level of the lookahead pyramid the forecast cost maps are computed
+       at; coarser levels of wide inputs seed its motion search
+       - 0 : half resolution (default)
+       - 1 : quarter resolution
+       - 2 : eighth resolution */
+    int            fcst_level;
+    /* threshold of the static CTU fast path, in 1/16 of an 8-bit luma sample.
+       a CTU whose mean absolute difference to the collocated block of the
+       first reference picture stays below it tries the skip mode at the
+       largest inter CU size first, and keeps it without further RDO when
+       its root-mean-square luma error is also below the threshold.
+       0 disables */
+    int            static_th;
+    /* quality metrics of each encoded picture reported in XEVE_STAT,
+       measured against the original after in-loop filtering
+       - 0 : off (default)
+       - 1 : sum of squared errors and PSNR of each plane
+       - 2 : 1 and SSIM of the luma plane
+       not measured when DRA is on, as the encoder only holds the converted
+       picture */
+    int            calc_metrics;
+    /* reuse of the motion compensated prediction and distortion of the
+       skip, merge and MMVD candidates already evaluated at the same
+       position, size and motion within a CTU (main profile). the output is
+       identical either way
+       - 0 : off
+       - 1 : on (default) */
+    int            mc_cache;
     /* VUI options*/
     int  sar;
     int  sar_width, sar_height;
@@ -556,10 +621,16 @@ typedef struct _XEVE_PARAM
  *****************************************************************************/
 typedef struct _XEVE_CDSC_EXT XEVE_CDSC_EXT;
 
+typedef void  * XEVE_POOL; /* shared worker pool identifier */
+
 typedef struct _XEVE_CDSC
 {
     int            max_bs_buf_size;
     XEVE_PARAM     param;
+    /* worker pool created by xeve_pool_create() to run the encoder tasks on,
+       NULL to start param.threads threads of its own. param.threads still
+       sets how many tasks a picture is split into */
+    XEVE_POOL      pool;
 } XEVE_CDSC;
 
 /*****************************************************************************
@@ -587,6 +658,21 @@ typedef struct _XEVE_STAT
     int            refpic_num[2];
     /* list of reference pictures */
     int            refpic[2][16];
+    /* number of split candidates considered by fast split prediction */
+    int            split_cand;
+    /* number of split candidates pruned by fast split prediction */
+    int            split_pruned;
+    /* number of largest inter CUs of static CTUs coded as skip without
+       further RDO */
+    int            static_cu;
+    /* sum of squared errors of each plane, when calc_metrics is set */
+    double         sse[3];
+    /* PSNR of each plane in dB with 8-bit peak scaled to the bit depth,
+       100 for a lossless plane, when calc_metrics is set */
+    double         psnr[3];
+    /* mean SSIM of the luma plane over 8x8 windows on a 4-sample grid,
+       when calc_metrics is 2 */
+    double         ssim;
 
 } XEVE_STAT;
 
@@ -612,6 +698,28 @@ XEVE XEVE_EXPORT xeve_create(XEVE_CDSC * cdsc, int * err);
  */
 void XEVE_EXPORT xeve_delete(XEVE id);
 
+/**
+ * @brief Create worker pool to be shared by encoder objects
+ *
+ * Encoders created with the pool in XEVE_CDSC queue their CTU row, tile and
+ * picture tasks to it instead of starting threads of their own. Workers take
+ * one task of each encoder in turn, so the encoders share the threads fairly.
+ *
+ * @param threads number of worker threads
+ * @param[in] cpu_set CPUs the workers run on in "0-7,16" format, NULL for no restriction
+ * @param err error code
+ * @return pool identifier on success, otherwise NULL
+ */
+XEVE_POOL XEVE_EXPORT xeve_pool_create(int threads, const char * cpu_set, int * err);
+
+/**
+ * @brief Destroy worker pool
+ *
+ * @param pool pool identifier returned by xeve_pool_create()
+ * @return XEVE_OK on success, XEVE_ERR_UNEXPECTED while encoders using the pool are not deleted
+ */
+int  XEVE_EXPORT xeve_pool_delete(XEVE_POOL pool);
+
 /**
  * @brief Push input frame to encoder
  *
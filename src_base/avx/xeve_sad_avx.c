@@ -29,6 +29,7 @@
 */
 
 #include "xeve_sad_avx.h"
+#include <math.h>
 
 #if X86_SSE
 static int sad_16b_avx_16nx2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
@@ -201,4 +202,773 @@ const XEVE_FN_SAD xeve_tbl_sad_16b_avx[8][8] =
 };
 // clang-format on
 
+/* SAD of 16bit original against 8bit reference *******************************/
+static int sad_8b_avx_16nx2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1;
+    u8  * s2;
+    __m256i s00, s01, r00, r01, sac0;
+    __m256i ones = _mm256_set1_epi16(1);
+    __m128i sac1;
+    int i, j, sad;
+
+    assert(!(w & 15));
+
+    s1 = (s16 *)src1;
+    s2 = (u8 *)src2;
+
+    sac0 = _mm256_setzero_si256();
+
+    for(i = 0; i < h >> 1; i++)
+    {
+        for(j = 0; j < w; j += 16)
+        {
+            s00 = _mm256_loadu_si256((__m256i*)(s1 + j));
+            s01 = _mm256_loadu_si256((__m256i*)(s1 + s_src1 + j));
+            r00 = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(s2 + j)));
+            r01 = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i*)(s2 + s_src2 + j)));
+
+            s00 = _mm256_abs_epi16(_mm256_sub_epi16(s00, r00));
+            s01 = _mm256_abs_epi16(_mm256_sub_epi16(s01, r01));
+            sac0 = _mm256_add_epi32(sac0, _mm256_madd_epi16(_mm256_add_epi16(s00, s01), ones));
+        }
+        s1 += s_src1 << 1;
+        s2 += s_src2 << 1;
+    }
+
+    sac1 = _mm_add_epi32(_mm256_castsi256_si128(sac0), _mm256_extracti128_si256(sac0, 1));
+    sac1 = _mm_hadd_epi32(sac1, sac1);
+    sac1 = _mm_hadd_epi32(sac1, sac1);
+    sad = _mm_extract_epi32(sac1, 0);
+
+    return (sad >> (bit_depth - 8));
+}
+
+// clang-format off
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SAD xeve_tbl_sad_8b_avx[8][8] =
+{
+    /* width == 1 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b,              /* height == 2 */
+        sad_8b,              /* height == 4 */
+        sad_8b,              /* height == 8 */
+        sad_8b,              /* height == 16 */
+        sad_8b,              /* height == 32 */
+        sad_8b,              /* height == 64 */
+        sad_8b,              /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b,              /* height == 2 */
+        sad_8b,              /* height == 4 */
+        sad_8b,              /* height == 8 */
+        sad_8b,              /* height == 16 */
+        sad_8b,              /* height == 32 */
+        sad_8b,              /* height == 64 */
+        sad_8b,              /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b_sse_4x2n,     /* height == 2 */
+        sad_8b_sse_4x2n,     /* height == 4 */
+        sad_8b_sse_4x2n,     /* height == 8 */
+        sad_8b_sse_4x2n,     /* height == 16 */
+        sad_8b_sse_4x2n,     /* height == 32 */
+        sad_8b_sse_4x2n,     /* height == 64 */
+        sad_8b_sse_4x2n,     /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        sad_8b_sse_8x1n,     /* height == 1 */
+        sad_8b_sse_8x1n,     /* height == 2 */
+        sad_8b_sse_8x1n,     /* height == 4 */
+        sad_8b_sse_8x1n,     /* height == 8 */
+        sad_8b_sse_8x1n,     /* height == 16 */
+        sad_8b_sse_8x1n,     /* height == 32 */
+        sad_8b_sse_8x1n,     /* height == 64 */
+        sad_8b_sse_8x1n,     /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        sad_8b_sse_16nx1n,   /* height == 1 */
+        sad_8b_avx_16nx2n,   /* height == 2 */
+        sad_8b_avx_16nx2n,   /* height == 4 */
+        sad_8b_avx_16nx2n,   /* height == 8 */
+        sad_8b_avx_16nx2n,   /* height == 16 */
+        sad_8b_avx_16nx2n,   /* height == 32 */
+        sad_8b_avx_16nx2n,   /* height == 64 */
+        sad_8b_avx_16nx2n,   /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        sad_8b_sse_16nx1n,   /* height == 1 */
+        sad_8b_avx_16nx2n,   /* height == 2 */
+        sad_8b_avx_16nx2n,   /* height == 4 */
+        sad_8b_avx_16nx2n,   /* height == 8 */
+        sad_8b_avx_16nx2n,   /* height == 16 */
+        sad_8b_avx_16nx2n,   /* height == 32 */
+        sad_8b_avx_16nx2n,   /* height == 64 */
+        sad_8b_avx_16nx2n,   /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        sad_8b_sse_16nx1n,   /* height == 1 */
+        sad_8b_avx_16nx2n,   /* height == 2 */
+        sad_8b_avx_16nx2n,   /* height == 4 */
+        sad_8b_avx_16nx2n,   /* height == 8 */
+        sad_8b_avx_16nx2n,   /* height == 16 */
+        sad_8b_avx_16nx2n,   /* height == 32 */
+        sad_8b_avx_16nx2n,   /* height == 64 */
+        sad_8b_avx_16nx2n,   /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        sad_8b_sse_16nx1n,   /* height == 1 */
+        sad_8b_avx_16nx2n,   /* height == 2 */
+        sad_8b_avx_16nx2n,   /* height == 4 */
+        sad_8b_avx_16nx2n,   /* height == 8 */
+        sad_8b_avx_16nx2n,   /* height == 16 */
+        sad_8b_avx_16nx2n,   /* height == 32 */
+        sad_8b_avx_16nx2n,   /* height == 64 */
+        sad_8b_avx_16nx2n,   /* height == 128 */
+    }
+};
+// clang-format on
+
+
+/* DIFF **********************************************************************/
+static void diff_16b_avx_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+{
+    s16 * s1;
+    s16 * s2;
+    int i, j;
+    __m256i m01, m02;
+
+    s1 = (s16 *)src1;
+    s2 = (s16 *)src2;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += 16)
+        {
+            m01 = _mm256_loadu_si256((__m256i*)(s1 + j));
+            m02 = _mm256_loadu_si256((__m256i*)(s2 + j));
+            _mm256_storeu_si256((__m256i*)(diff + j), _mm256_sub_epi16(m01, m02));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+        diff += s_diff;
+    }
+}
+
+/* SSD ***********************************************************************/
+/* squared differences of 16 16-bit residuals are formed as 32-bit products
+   from the low and high halves of the 16x16 multiplication */
+#define AVX_SSD_16B_16PEL(d, shift, s00, s01, s00a) \
+    s00 = _mm256_mullo_epi16(d, d); \
+    s01 = _mm256_mulhi_epi16(d, d); \
+    d   = _mm256_unpacklo_epi16(s00, s01); \
+    s01 = _mm256_unpackhi_epi16(s00, s01); \
+    s00a = _mm256_add_epi32(s00a, _mm256_srli_epi32(d, shift)); \
+    s00a = _mm256_add_epi32(s00a, _mm256_srli_epi32(s01, shift));
+
+static s64 ssd_16b_avx_sum(__m256i s00a)
+{
+    s64 ssd[4];
+
+    s00a = _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(s00a)),
+                            _mm256_cvtepu32_epi64(_mm256_extracti128_si256(s00a, 1)));
+    _mm256_storeu_si256((__m256i*)ssd, s00a);
+
+    return ssd[0] + ssd[1] + ssd[2] + ssd[3];
+}
+
+static s64 ssd_16b_avx_8x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1;
+    s16 * s2;
+    int     i;
+    const int shift = (bit_depth - 8) << 1;
+    __m256i s00, s01, d00, s00a;
+
+    s1 = (s16 *)src1;
+    s2 = (s16 *)src2;
+
+    s00a = _mm256_setzero_si256();
+
+    for(i = 0; i < h; i += 2)
+    {
+        s00 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i*)s1)),
+                                      _mm_loadu_si128((__m128i*)(s1 + s_src1)), 1);
+        s01 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i*)s2)),
+                                      _mm_loadu_si128((__m128i*)(s2 + s_src2)), 1);
+        d00 = _mm256_sub_epi16(s00, s01);
+        AVX_SSD_16B_16PEL(d00, shift, s00, s01, s00a);
+
+        s1 += s_src1 << 1;
+        s2 += s_src2 << 1;
+    }
+
+    return ssd_16b_avx_sum(s00a);
+}
+
+static s64 ssd_16b_avx_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1;
+    s16 * s2;
+    int     i, j;
+    const int shift = (bit_depth - 8) << 1;
+    __m256i s00, s01, d00, s00a;
+
+    s1 = (s16 *)src1;
+    s2 = (s16 *)src2;
+
+    s00a = _mm256_setzero_si256();
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += 16)
+        {
+            s00 = _mm256_loadu_si256((__m256i*)(s1 + j));
+            s01 = _mm256_loadu_si256((__m256i*)(s2 + j));
+            d00 = _mm256_sub_epi16(s00, s01);
+            AVX_SSD_16B_16PEL(d00, shift, s00, s01, s00a);
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    return ssd_16b_avx_sum(s00a);
+}
+
+/* SATD **********************************************************************/
+/* 8-point butterfly over 8 registers; coefficient order is not natural but
+   only the sum of absolute values and the DC position (index 0) matter */
+#define AVX_HAD_8PT(r, add, sub, t) \
+    t[0] = add(r[0], r[4]); t[4] = sub(r[0], r[4]); \
+    t[1] = add(r[1], r[5]); t[5] = sub(r[1], r[5]); \
+    t[2] = add(r[2], r[6]); t[6] = sub(r[2], r[6]); \
+    t[3] = add(r[3], r[7]); t[7] = sub(r[3], r[7]); \
+    r[0] = add(t[0], t[2]); r[2] = sub(t[0], t[2]); \
+    r[1] = add(t[1], t[3]); r[3] = sub(t[1], t[3]); \
+    r[4] = add(t[4], t[6]); r[6] = sub(t[4], t[6]); \
+    r[5] = add(t[5], t[7]); r[7] = sub(t[5], t[7]); \
+    t[0] = add(r[0], r[1]); t[1] = sub(r[0], r[1]); \
+    t[2] = add(r[2], r[3]); t[3] = sub(r[2], r[3]); \
+    t[4] = add(r[4], r[5]); t[5] = sub(r[4], r[5]); \
+    t[6] = add(r[6], r[7]); t[7] = sub(r[6], r[7]);
+
+/* transpose of 8x8 16-bit blocks held in r[0..7], per 128-bit lane */
+#define AVX_TRANSPOSE_8X8_16B(r, t, unpacklo16, unpackhi16, unpacklo32, unpackhi32, unpacklo64, unpackhi64) \
+    t[0] = unpacklo16(r[0], r[1]); t[1] = unpackhi16(r[0], r[1]); \
+    t[2] = unpacklo16(r[2], r[3]); t[3] = unpackhi16(r[2], r[3]); \
+    t[4] = unpacklo16(r[4], r[5]); t[5] = unpackhi16(r[4], r[5]); \
+    t[6] = unpacklo16(r[6], r[7]); t[7] = unpackhi16(r[6], r[7]); \
+    r[0] = unpacklo32(t[0], t[2]); r[1] = unpackhi32(t[0], t[2]); \
+    r[2] = unpacklo32(t[1], t[3]); r[3] = unpackhi32(t[1], t[3]); \
+    r[4] = unpacklo32(t[4], t[6]); r[5] = unpackhi32(t[4], t[6]); \
+    r[6] = unpacklo32(t[5], t[7]); r[7] = unpackhi32(t[5], t[7]); \
+    t[0] = unpacklo64(r[0], r[4]); t[1] = unpackhi64(r[0], r[4]); \
+    t[2] = unpacklo64(r[1], r[5]); t[3] = unpackhi64(r[1], r[5]); \
+    t[4] = unpacklo64(r[2], r[6]); t[5] = unpackhi64(r[2], r[6]); \
+    t[6] = unpacklo64(r[3], r[7]); t[7] = unpackhi64(r[3], r[7]);
+
+static int hsum_epi32_avx(__m256i v)
+{
+    __m128i m00;
+
+    m00 = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    m00 = _mm_hadd_epi32(m00, m00);
+    m00 = _mm_hadd_epi32(m00, m00);
+
+    return _mm_cvtsi128_si32(m00);
+}
+
+int xeve_had_4x4_avx(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth)
+{
+    xeve_assert(bit_depth == 10);
+    __m128i o01, o23, c01, c23;
+    __m256i d, t, s, m;
+    int satd, dc;
+
+    o01 = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i*)org), _mm_loadl_epi64((__m128i*)(org + s_org)));
+    o23 = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i*)(org + 2 * s_org)), _mm_loadl_epi64((__m128i*)(org + 3 * s_org)));
+    c01 = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i*)cur), _mm_loadl_epi64((__m128i*)(cur + s_cur)));
+    c23 = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i*)(cur + 2 * s_cur)), _mm_loadl_epi64((__m128i*)(cur + 3 * s_cur)));
+
+    /* rows 0,1 in the low lane and rows 2,3 in the high lane */
+    d = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_sub_epi16(o01, c01)), _mm_sub_epi16(o23, c23), 1);
+
+    /* vertical: rows (0,2), (1,3) across lanes, then (0,1) across 64-bit halves */
+    t = _mm256_permute2x128_si256(d, d, 0x01);
+    s = _mm256_add_epi16(d, t);
+    m = _mm256_sub_epi16(d, t);
+    d = _mm256_permute2x128_si256(s, m, 0x20);
+
+    t = _mm256_shuffle_epi32(d, 0x4E);
+    s = _mm256_add_epi16(d, t);
+    m = _mm256_sub_epi16(d, t);
+    d = _mm256_blend_epi32(s, m, 0xCC);
+
+    /* horizontal: columns (0,2), (1,3), then (0,1) inside each row */
+    t = _mm256_shuffle_epi32(d, 0xB1);
+    s = _mm256_add_epi16(d, t);
+    m = _mm256_sub_epi16(d, t);
+    d = _mm256_blend_epi16(s, m, 0xCC);
+
+    t = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(d, 0xB1), 0xB1);
+    s = _mm256_add_epi16(d, t);
+    m = _mm256_sub_epi16(d, t);
+    d = _mm256_blend_epi16(s, m, 0xAA);
+
+    d = _mm256_abs_epi16(d);
+    dc = _mm_extract_epi16(_mm256_castsi256_si128(d), 0);
+
+    satd = hsum_epi32_avx(_mm256_madd_epi16(d, _mm256_set1_epi16(1)));
+    satd = satd - dc + (dc >> 2);
+
+    return ((satd + 1) >> 1);
+}
+
+int xeve_had_8x8_avx(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth)
+{
+    xeve_assert(bit_depth == 10);
+    __m128i r[8], t[8];
+    __m256i q[8], p[8], sum;
+    int i, sad, dc;
+
+    for(i = 0; i < 8; i++)
+    {
+        r[i] = _mm_sub_epi16(_mm_loadu_si128((__m128i*)(org + i * s_org)), _mm_loadu_si128((__m128i*)(cur + i * s_cur)));
+    }
+
+    /* vertical transform in 16-bit */
+    AVX_HAD_8PT(r, _mm_add_epi16, _mm_sub_epi16, t);
+    AVX_TRANSPOSE_8X8_16B(t, r, _mm_unpacklo_epi16, _mm_unpackhi_epi16, _mm_unpacklo_epi32, _mm_unpackhi_epi32,
+                          _mm_unpacklo_epi64, _mm_unpackhi_epi64);
+
+    /* horizontal transform in 32-bit, all eight rows at once */
+    for(i = 0; i < 8; i++)
+    {
+        q[i] = _mm256_cvtepi16_epi32(r[i]);
+    }
+    AVX_HAD_8PT(q, _mm256_add_epi32, _mm256_sub_epi32, p);
+
+    sum = _mm256_abs_epi32(p[0]);
+    dc = _mm_cvtsi128_si32(_mm256_castsi256_si128(sum));
+    for(i = 1; i < 8; i++)
+    {
+        sum = _mm256_add_epi32(sum, _mm256_abs_epi32(p[i]));
+    }
+
+    sad = hsum_epi32_avx(sum);
+    sad = sad - dc + (dc >> 2);
+
+    return ((sad + 2) >> 2);
+}
+
+/* 16x8 and 8x16 share the same core: r[] holds eight 16-bit rows of 16
+   residuals, lanes are the two 8x8 halves which are combined last */
+static int had_16x8_core_avx(__m256i * r)
+{
+    __m256i t[8], a[8], b[8], sum;
+    int i, sad, dc;
+
+    AVX_HAD_8PT(r, _mm256_add_epi16, _mm256_sub_epi16, t);
+    AVX_TRANSPOSE_8X8_16B(t, r, _mm256_unpacklo_epi16, _mm256_unpackhi_epi16, _mm256_unpacklo_epi32, _mm256_unpackhi_epi32,
+                          _mm256_unpacklo_epi64, _mm256_unpackhi_epi64);
+
+    for(i = 0; i < 8; i++)
+    {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(r[i]));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(r[i], 1));
+        a[i] = _mm256_add_epi32(lo, hi);
+        b[i] = _mm256_sub_epi32(lo, hi);
+    }
+    AVX_HAD_8PT(a, _mm256_add_epi32, _mm256_sub_epi32, t);
+    AVX_HAD_8PT(b, _mm256_add_epi32, _mm256_sub_epi32, r);
+
+    sum = _mm256_abs_epi32(t[0]);
+    dc = _mm_cvtsi128_si32(_mm256_castsi256_si128(sum));
+    for(i = 1; i < 8; i++)
+    {
+        sum = _mm256_add_epi32(sum, _mm256_abs_epi32(t[i]));
+    }
+    for(i = 0; i < 8; i++)
+    {
+        sum = _mm256_add_epi32(sum, _mm256_abs_epi32(r[i]));
+    }
+
+    sad = hsum_epi32_avx(sum);
+    sad = sad - dc + (dc >> 2);
+
+    return (int)(sad / sqrt(16.0 * 8) * 2);
+}
+
+int xeve_had_16x8_avx(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth)
+{
+    xeve_assert(bit_depth == 10);
+    __m256i r[8];
+    int i;
+
+    for(i = 0; i < 8; i++)
+    {
+        r[i] = _mm256_sub_epi16(_mm256_loadu_si256((__m256i*)(org + i * s_org)), _mm256_loadu_si256((__m256i*)(cur + i * s_cur)));
+    }
+
+    return had_16x8_core_avx(r);
+}
+
+int xeve_had_8x16_avx(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth)
+{
+    xeve_assert(bit_depth == 10);
+    __m256i r[8];
+    __m128i lo, hi;
+    int i;
+
+    /* row i in the low lane and row i + 8 in the high lane */
+    for(i = 0; i < 8; i++)
+    {
+        lo = _mm_sub_epi16(_mm_loadu_si128((__m128i*)(org + i * s_org)), _mm_loadu_si128((__m128i*)(cur + i * s_cur)));
+        hi = _mm_sub_epi16(_mm_loadu_si128((__m128i*)(org + (i + 8) * s_org)), _mm_loadu_si128((__m128i*)(cur + (i + 8) * s_cur)));
+        r[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    }
+
+    return had_16x8_core_avx(r);
+}
+
+/* block-size specialized SATD: the tiling for each [log2w][log2h] entry follows
+   the selection made at run-time by xeve_had_sse() */
+#define AVX_SATD_16B_TILE(name, had, tw, th) \
+static int name(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth) \
+{ \
+    pel *org = o; \
+    pel *cur = c; \
+    int  x, y; \
+    int sum = 0; \
+    for(y = 0; y < h; y += th) \
+    { \
+        for(x = 0; x < w; x += tw) \
+        { \
+            sum += had(&org[x], &cur[x], s_org, s_cur, 1, bit_depth); \
+        } \
+        org += s_org * th; \
+        cur += s_cur * th; \
+    } \
+    return (sum >> (bit_depth - 8)); \
+}
+
+AVX_SATD_16B_TILE(satd_16b_avx_4nx4n,  xeve_had_4x4_avx,  4,  4)
+AVX_SATD_16B_TILE(satd_16b_avx_8nx8n,  xeve_had_8x8_avx,  8,  8)
+AVX_SATD_16B_TILE(satd_16b_avx_16nx8n, xeve_had_16x8_avx, 16, 8)
+AVX_SATD_16B_TILE(satd_16b_avx_8nx16n, xeve_had_8x16_avx, 8,  16)
+AVX_SATD_16B_TILE(satd_16b_avx_8nx4n,  xeve_had_8x4_sse,  8,  4)
+AVX_SATD_16B_TILE(satd_16b_avx_4nx8n,  xeve_had_4x8_sse,  4,  8)
+
+static int satd_16b_avx_2nx2n(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth)
+{
+    pel *org = o;
+    pel *cur = c;
+    int  x, y;
+    int sum = 0;
+
+    for(y = 0; y < h; y += 2)
+    {
+        for(x = 0; x < w; x += 2)
+        {
+            sum += xeve_had_2x2(&org[x], &cur[x], s_org, s_cur, 1);
+        }
+        org += s_org << 1;
+        cur += s_cur << 1;
+    }
+
+    return (sum >> (bit_depth - 8));
+}
+
+// clang-format off
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SSD xeve_tbl_ssd_16b_avx[8][8] =
+{
+    /* width == 1 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b, /* height == 2 */
+        ssd_16b, /* height == 4 */
+        ssd_16b, /* height == 8 */
+        ssd_16b, /* height == 16 */
+        ssd_16b, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        ssd_16b, /* height == 1 */
+        ssd_16b, /* height == 2 */
+        ssd_16b, /* height == 4 */
+        ssd_16b, /* height == 8 */
+        ssd_16b, /* height == 16 */
+        ssd_16b, /* height == 32 */
+        ssd_16b, /* height == 64 */
+        ssd_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        ssd_16b,          /* height == 1 */
+        ssd_16b_sse_4x2,  /* height == 2 */
+        ssd_16b_sse_4x4,  /* height == 4 */
+        ssd_16b_sse_4x8,  /* height == 8 */
+        ssd_16b_sse_4x16, /* height == 16 */
+        ssd_16b_sse_4x32, /* height == 32 */
+        ssd_16b,          /* height == 64 */
+        ssd_16b,          /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        ssd_16b,          /* height == 1 */
+        ssd_16b_avx_8x2n, /* height == 2 */
+        ssd_16b_avx_8x2n, /* height == 4 */
+        ssd_16b_avx_8x2n, /* height == 8 */
+        ssd_16b_avx_8x2n, /* height == 16 */
+        ssd_16b_avx_8x2n, /* height == 32 */
+        ssd_16b_avx_8x2n, /* height == 64 */
+        ssd_16b_avx_8x2n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        ssd_16b_avx_16nx1n, /* height == 1 */
+        ssd_16b_avx_16nx1n, /* height == 2 */
+        ssd_16b_avx_16nx1n, /* height == 4 */
+        ssd_16b_avx_16nx1n, /* height == 8 */
+        ssd_16b_avx_16nx1n, /* height == 16 */
+        ssd_16b_avx_16nx1n, /* height == 32 */
+        ssd_16b_avx_16nx1n, /* height == 64 */
+        ssd_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        ssd_16b_avx_16nx1n, /* height == 1 */
+        ssd_16b_avx_16nx1n, /* height == 2 */
+        ssd_16b_avx_16nx1n, /* height == 4 */
+        ssd_16b_avx_16nx1n, /* height == 8 */
+        ssd_16b_avx_16nx1n, /* height == 16 */
+        ssd_16b_avx_16nx1n, /* height == 32 */
+        ssd_16b_avx_16nx1n, /* height == 64 */
+        ssd_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        ssd_16b_avx_16nx1n, /* height == 1 */
+        ssd_16b_avx_16nx1n, /* height == 2 */
+        ssd_16b_avx_16nx1n, /* height == 4 */
+        ssd_16b_avx_16nx1n, /* height == 8 */
+        ssd_16b_avx_16nx1n, /* height == 16 */
+        ssd_16b_avx_16nx1n, /* height == 32 */
+        ssd_16b_avx_16nx1n, /* height == 64 */
+        ssd_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        ssd_16b_avx_16nx1n, /* height == 1 */
+        ssd_16b_avx_16nx1n, /* height == 2 */
+        ssd_16b_avx_16nx1n, /* height == 4 */
+        ssd_16b_avx_16nx1n, /* height == 8 */
+        ssd_16b_avx_16nx1n, /* height == 16 */
+        ssd_16b_avx_16nx1n, /* height == 32 */
+        ssd_16b_avx_16nx1n, /* height == 64 */
+        ssd_16b_avx_16nx1n, /* height == 128 */
+    }
+};
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_DIFF xeve_tbl_diff_16b_avx[8][8] =
+{
+    /* width == 1 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b, /* height == 2 */
+        diff_16b, /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        diff_16b, /* height == 1 */
+        diff_16b, /* height == 2 */
+        diff_16b, /* height == 4 */
+        diff_16b, /* height == 8 */
+        diff_16b, /* height == 16 */
+        diff_16b, /* height == 32 */
+        diff_16b, /* height == 64 */
+        diff_16b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        diff_16b,         /* height == 1 */
+        diff_16b_sse_4x2, /* height == 2 */
+        diff_16b_sse_4x4, /* height == 4 */
+        diff_16b,         /* height == 8 */
+        diff_16b,         /* height == 16 */
+        diff_16b,         /* height == 32 */
+        diff_16b,         /* height == 64 */
+        diff_16b,         /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        diff_16b,           /* height == 1 */
+        diff_16b_sse_8nx2n, /* height == 2 */
+        diff_16b_sse_8nx2n, /* height == 4 */
+        diff_16b_sse_8x8,   /* height == 8 */
+        diff_16b_sse_8nx2n, /* height == 16 */
+        diff_16b_sse_8nx2n, /* height == 32 */
+        diff_16b_sse_8nx2n, /* height == 64 */
+        diff_16b_sse_8nx2n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        diff_16b_avx_16nx1n, /* height == 1 */
+        diff_16b_avx_16nx1n, /* height == 2 */
+        diff_16b_avx_16nx1n, /* height == 4 */
+        diff_16b_avx_16nx1n, /* height == 8 */
+        diff_16b_avx_16nx1n, /* height == 16 */
+        diff_16b_avx_16nx1n, /* height == 32 */
+        diff_16b_avx_16nx1n, /* height == 64 */
+        diff_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        diff_16b_avx_16nx1n, /* height == 1 */
+        diff_16b_avx_16nx1n, /* height == 2 */
+        diff_16b_avx_16nx1n, /* height == 4 */
+        diff_16b_avx_16nx1n, /* height == 8 */
+        diff_16b_avx_16nx1n, /* height == 16 */
+        diff_16b_avx_16nx1n, /* height == 32 */
+        diff_16b_avx_16nx1n, /* height == 64 */
+        diff_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        diff_16b_avx_16nx1n, /* height == 1 */
+        diff_16b_avx_16nx1n, /* height == 2 */
+        diff_16b_avx_16nx1n, /* height == 4 */
+        diff_16b_avx_16nx1n, /* height == 8 */
+        diff_16b_avx_16nx1n, /* height == 16 */
+        diff_16b_avx_16nx1n, /* height == 32 */
+        diff_16b_avx_16nx1n, /* height == 64 */
+        diff_16b_avx_16nx1n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        diff_16b_avx_16nx1n, /* height == 1 */
+        diff_16b_avx_16nx1n, /* height == 2 */
+        diff_16b_avx_16nx1n, /* height == 4 */
+        diff_16b_avx_16nx1n, /* height == 8 */
+        diff_16b_avx_16nx1n, /* height == 16 */
+        diff_16b_avx_16nx1n, /* height == 32 */
+        diff_16b_avx_16nx1n, /* height == 64 */
+        diff_16b_avx_16nx1n, /* height == 128 */
+    }
+};
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SATD xeve_tbl_satd_16b_avx[8][8] =
+{
+    /* width == 1 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        xeve_had_sse,       /* height == 1 */
+        satd_16b_avx_2nx2n, /* height == 2 */
+        satd_16b_avx_2nx2n, /* height == 4 */
+        satd_16b_avx_2nx2n, /* height == 8 */
+        satd_16b_avx_2nx2n, /* height == 16 */
+        satd_16b_avx_2nx2n, /* height == 32 */
+        satd_16b_avx_2nx2n, /* height == 64 */
+        satd_16b_avx_2nx2n, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        xeve_had_sse,       /* height == 1 */
+        satd_16b_avx_2nx2n, /* height == 2 */
+        satd_16b_avx_4nx4n, /* height == 4 */
+        satd_16b_avx_4nx8n, /* height == 8 */
+        satd_16b_avx_4nx8n, /* height == 16 */
+        satd_16b_avx_4nx8n, /* height == 32 */
+        satd_16b_avx_4nx8n, /* height == 64 */
+        satd_16b_avx_4nx8n, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        xeve_had_sse,        /* height == 1 */
+        satd_16b_avx_2nx2n,  /* height == 2 */
+        satd_16b_avx_8nx4n,  /* height == 4 */
+        satd_16b_avx_8nx8n,  /* height == 8 */
+        satd_16b_avx_8nx16n, /* height == 16 */
+        satd_16b_avx_8nx16n, /* height == 32 */
+        satd_16b_avx_8nx16n, /* height == 64 */
+        satd_16b_avx_8nx16n, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        xeve_had_sse,        /* height == 1 */
+        satd_16b_avx_2nx2n,  /* height == 2 */
+        satd_16b_avx_8nx4n,  /* height == 4 */
+        satd_16b_avx_16nx8n, /* height == 8 */
+        satd_16b_avx_8nx8n,  /* height == 16 */
+        satd_16b_avx_8nx16n, /* height == 32 */
+        satd_16b_avx_8nx16n, /* height == 64 */
+        satd_16b_avx_8nx16n, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        xeve_had_sse,        /* height == 1 */
+        satd_16b_avx_2nx2n,  /* height == 2 */
+        satd_16b_avx_8nx4n,  /* height == 4 */
+        satd_16b_avx_16nx8n, /* height == 8 */
+        satd_16b_avx_16nx8n, /* height == 16 */
+        satd_16b_avx_8nx8n,  /* height == 32 */
+        satd_16b_avx_8nx16n, /* height == 64 */
+        satd_16b_avx_8nx16n, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        xeve_had_sse,        /* height == 1 */
+        satd_16b_avx_2nx2n,  /* height == 2 */
+        satd_16b_avx_8nx4n,  /* height == 4 */
+        satd_16b_avx_16nx8n, /* height == 8 */
+        satd_16b_avx_16nx8n, /* height == 16 */
+        satd_16b_avx_16nx8n, /* height == 32 */
+        satd_16b_avx_8nx8n,  /* height == 64 */
+        satd_16b_avx_8nx16n, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        xeve_had_sse,        /* height == 1 */
+        satd_16b_avx_2nx2n,  /* height == 2 */
+        satd_16b_avx_8nx4n,  /* height == 4 */
+        satd_16b_avx_16nx8n, /* height == 8 */
+        satd_16b_avx_16nx8n, /* height == 16 */
+        satd_16b_avx_16nx8n, /* height == 32 */
+        satd_16b_avx_16nx8n, /* height == 64 */
+        satd_16b_avx_8nx8n,  /* height == 128 */
+    }
+};
+// clang-format on
+
 #endif
\ No newline at end of file
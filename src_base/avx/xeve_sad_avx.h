@@ -35,6 +35,15 @@
 #include <immintrin.h>
 
 #if X86_SSE
-extern const XEVE_FN_SAD xeve_tbl_sad_16b_avx[8][8];
+extern const XEVE_FN_SAD  xeve_tbl_sad_16b_avx[8][8];
+extern const XEVE_FN_SAD  xeve_tbl_sad_8b_avx[8][8];
+extern const XEVE_FN_SSD  xeve_tbl_ssd_16b_avx[8][8];
+extern const XEVE_FN_DIFF xeve_tbl_diff_16b_avx[8][8];
+extern const XEVE_FN_SATD xeve_tbl_satd_16b_avx[8][8];
+
+int xeve_had_4x4_avx(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int xeve_had_8x8_avx(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int xeve_had_16x8_avx(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int xeve_had_8x16_avx(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
 #endif /* X86_SSE */
 #endif /* _XEVE_SAD_AVX_H_ */
\ No newline at end of file
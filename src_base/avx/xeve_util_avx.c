@@ -0,0 +1,157 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+/* two AQ blocks (32 columns) at a time over all rows, block 0 in a and
+   block 1 in b */
+void xeve_ingest_avx(const void * src, int s_src, int src_8b, pel * dst, int s_dst, int w, int h, int shift, pel * sub, int s_sub, u64 * var)
+{
+    const u8 * s;
+    pel      * d;
+    __m256i    ones = _mm256_set1_epi16(1);
+    __m256i    two = _mm256_set1_epi32(2);
+    __m128i    cnt = _mm_cvtsi32_si128(shift);
+    __m256i    a, b, pa, pb, qa, qb, acc_sa, acc_sb, acc_ssa, acc_ssb;
+    __m128i    t0, t1;
+    u32        sum, ssum;
+    int        x, i;
+
+    for(x = 0; x + 32 <= w; x += 32)
+    {
+        acc_sa = acc_sb = acc_ssa = acc_ssb = qa = qb = _mm256_setzero_si256();
+        for(i = 0; i < h; i++)
+        {
+            s = (const u8 *)src + i * s_src;
+            d = dst + i * s_dst + x;
+            if(src_8b)
+            {
+                a = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(s + x)));
+                b = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(s + x + 16)));
+            }
+            else
+            {
+                a = _mm256_loadu_si256((const __m256i *)((const u16 *)s + x));
+                b = _mm256_loadu_si256((const __m256i *)((const u16 *)s + x + 16));
+            }
+            a = _mm256_sll_epi16(a, cnt);
+            b = _mm256_sll_epi16(b, cnt);
+            _mm256_storeu_si256((__m256i *)d, a);
+            _mm256_storeu_si256((__m256i *)(d + 16), b);
+
+            pa = _mm256_madd_epi16(a, ones);
+            pb = _mm256_madd_epi16(b, ones);
+            acc_sa = _mm256_add_epi32(acc_sa, pa);
+            acc_sb = _mm256_add_epi32(acc_sb, pb);
+            acc_ssa = _mm256_add_epi32(acc_ssa, _mm256_madd_epi16(a, a));
+            acc_ssb = _mm256_add_epi32(acc_ssb, _mm256_madd_epi16(b, b));
+
+            if(sub != NULL)
+            {
+                if(i & 1)
+                {
+                    qa = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(qa, pa), two), 2);
+                    qb = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(qb, pb), two), 2);
+                    /* packus works per 128-bit lane, put the 64-bit groups back in order */
+                    qa = _mm256_permute4x64_epi64(_mm256_packus_epi32(qa, qb), 0xD8);
+                    _mm256_storeu_si256((__m256i *)(sub + (i >> 1) * s_sub + (x >> 1)), qa);
+                }
+                else
+                {
+                    qa = pa;
+                    qb = pb;
+                }
+            }
+        }
+
+        if(var != NULL && h == 16)
+        {
+            t0 = _mm_add_epi32(_mm256_castsi256_si128(acc_sa), _mm256_extracti128_si256(acc_sa, 1));
+            t1 = _mm_add_epi32(_mm256_castsi256_si128(acc_ssa), _mm256_extracti128_si256(acc_ssa, 1));
+            t0 = _mm_hadd_epi32(t0, t1);
+            t0 = _mm_hadd_epi32(t0, t0);
+            sum = (u32)_mm_cvtsi128_si32(t0);
+            ssum = (u32)_mm_extract_epi32(t0, 1);
+            var[x >> 4] = (u64)ssum - (((u64)sum * sum) >> 8);
+
+            t0 = _mm_add_epi32(_mm256_castsi256_si128(acc_sb), _mm256_extracti128_si256(acc_sb, 1));
+            t1 = _mm_add_epi32(_mm256_castsi256_si128(acc_ssb), _mm256_extracti128_si256(acc_ssb, 1));
+            t0 = _mm_hadd_epi32(t0, t1);
+            t0 = _mm_hadd_epi32(t0, t0);
+            sum = (u32)_mm_cvtsi128_si32(t0);
+            ssum = (u32)_mm_extract_epi32(t0, 1);
+            var[(x >> 4) + 1] = (u64)ssum - (((u64)sum * sum) >> 8);
+        }
+    }
+
+    if(x < w)
+    {
+        xeve_ingest_sse((const u8 *)src + (src_8b ? x : x << 1), s_src, src_8b, dst + x, s_dst, w - x, h, shift,
+                        (sub != NULL) ? sub + (x >> 1) : NULL, s_sub, (var != NULL) ? var + (x >> 4) : NULL);
+    }
+}
+
+u64 xeve_sse_avx(const pel * src1, int s_src1, const pel * src2, int s_src2, int w, int h)
+{
+    const pel * s1 = src1, * s2 = src2;
+    __m256i     zero = _mm256_setzero_si256();
+    __m256i     acc, acc64 = zero, d;
+    __m128i     t;
+    u64         sum[2];
+    int         i, j, n, w16 = w & ~15;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w16; )
+        {
+            acc = zero;
+            for(n = 0; n < 64 && j < w16; n++, j += 16)
+            {
+                d = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)(s1 + j)), _mm256_loadu_si256((const __m256i *)(s2 + j)));
+                acc = _mm256_add_epi32(acc, _mm256_madd_epi16(d, d));
+            }
+            acc64 = _mm256_add_epi64(acc64, _mm256_unpacklo_epi32(acc, zero));
+            acc64 = _mm256_add_epi64(acc64, _mm256_unpackhi_epi32(acc, zero));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+    t = _mm_add_epi64(_mm256_castsi256_si128(acc64), _mm256_extracti128_si256(acc64, 1));
+    _mm_storeu_si128((__m128i *)sum, t);
+    sum[0] += sum[1];
+
+    if(w16 < w)
+    {
+        sum[0] += xeve_sse_sse(src1 + w16, s_src1, src2 + w16, s_src2, w - w16, h);
+    }
+    return sum[0];
+}
+#endif /* X86_SSE */
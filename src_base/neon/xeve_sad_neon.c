@@ -297,6 +297,180 @@ const XEVE_FN_SAD xeve_tbl_sad_16b_neon[8][8] =
     }
 };
 
+/* SAD of 16bit original against 8bit reference *******************************/
+int sad_8b_neon_4x2n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth)
+{
+    int16_t const* s1 = src1;
+    uint8_t const* s2 = src2;
+    int i;
+    int16x8_t src_8x16b, pred_8x16b;
+    uint32x2_t pred_4x8b_2;
+    uint32x4_t sad_4x32b = vdupq_n_u32(0);
+
+    for (i = 0; i < h >> 1; i++)
+    {
+        src_8x16b = vcombine_s16(vld1_s16(s1), vld1_s16(s1 + s_src1));
+
+        pred_4x8b_2 = vdup_n_u32(0);
+        pred_4x8b_2 = vld1_lane_u32((uint32_t const*)s2, pred_4x8b_2, 0);
+        pred_4x8b_2 = vld1_lane_u32((uint32_t const*)(s2 + s_src2), pred_4x8b_2, 1);
+        pred_8x16b = vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(pred_4x8b_2)));
+
+        sad_4x32b = vpadalq_u16(sad_4x32b, vreinterpretq_u16_s16(vabdq_s16(src_8x16b, pred_8x16b)));
+
+        s1 += s_src1 << 1;
+        s2 += s_src2 << 1;
+    }
+
+    return ((int)vaddvq_u32(sad_4x32b) >> (bit_depth - 8));
+}
+
+int sad_8b_neon_8x1n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth)
+{
+    int16_t const* s1 = src1;
+    uint8_t const* s2 = src2;
+    int i;
+    int16x8_t src_8x16b, pred_8x16b;
+    uint32x4_t sad_4x32b = vdupq_n_u32(0);
+
+    for (i = 0; i < h; i++)
+    {
+        src_8x16b = vld1q_s16(s1);
+        pred_8x16b = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(s2)));
+
+        sad_4x32b = vpadalq_u16(sad_4x32b, vreinterpretq_u16_s16(vabdq_s16(src_8x16b, pred_8x16b)));
+
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    return ((int)vaddvq_u32(sad_4x32b) >> (bit_depth - 8));
+}
+
+int sad_8b_neon_16nx1n(int w, int h, void* src1, void* src2, int s_src1, int s_src2, int bit_depth)
+{
+    int16_t const* s1 = src1;
+    uint8_t const* s2 = src2;
+    int i, j;
+    int16x8_t src_8x16b, src_8x16b_1, pred_8x16b, pred_8x16b_1;
+    uint8x16_t pred_16x8b;
+    uint16x8_t abs_diff_8x16b;
+    uint32x4_t sad_4x32b = vdupq_n_u32(0);
+
+    for (i = 0; i < h; i++)
+    {
+        for (j = 0; j < w; j += 16)
+        {
+            src_8x16b = vld1q_s16(s1 + j);
+            src_8x16b_1 = vld1q_s16(s1 + j + 8);
+            pred_16x8b = vld1q_u8(s2 + j);
+            pred_8x16b = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(pred_16x8b)));
+            pred_8x16b_1 = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(pred_16x8b)));
+
+            abs_diff_8x16b = vaddq_u16(vreinterpretq_u16_s16(vabdq_s16(src_8x16b, pred_8x16b)),
+                                       vreinterpretq_u16_s16(vabdq_s16(src_8x16b_1, pred_8x16b_1)));
+            sad_4x32b = vpadalq_u16(sad_4x32b, abs_diff_8x16b);
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    return ((int)vaddvq_u32(sad_4x32b) >> (bit_depth - 8));
+}
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SAD xeve_tbl_sad_8b_neon[8][8] =
+{
+    /* width == 1 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b,              /* height == 2 */
+        sad_8b,              /* height == 4 */
+        sad_8b,              /* height == 8 */
+        sad_8b,              /* height == 16 */
+        sad_8b,              /* height == 32 */
+        sad_8b,              /* height == 64 */
+        sad_8b,              /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b,              /* height == 2 */
+        sad_8b,              /* height == 4 */
+        sad_8b,              /* height == 8 */
+        sad_8b,              /* height == 16 */
+        sad_8b,              /* height == 32 */
+        sad_8b,              /* height == 64 */
+        sad_8b,              /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b_neon_4x2n,    /* height == 2 */
+        sad_8b_neon_4x2n,    /* height == 4 */
+        sad_8b_neon_4x2n,    /* height == 8 */
+        sad_8b_neon_4x2n,    /* height == 16 */
+        sad_8b_neon_4x2n,    /* height == 32 */
+        sad_8b_neon_4x2n,    /* height == 64 */
+        sad_8b_neon_4x2n,    /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        sad_8b_neon_8x1n,    /* height == 1 */
+        sad_8b_neon_8x1n,    /* height == 2 */
+        sad_8b_neon_8x1n,    /* height == 4 */
+        sad_8b_neon_8x1n,    /* height == 8 */
+        sad_8b_neon_8x1n,    /* height == 16 */
+        sad_8b_neon_8x1n,    /* height == 32 */
+        sad_8b_neon_8x1n,    /* height == 64 */
+        sad_8b_neon_8x1n,    /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        sad_8b_neon_16nx1n,  /* height == 1 */
+        sad_8b_neon_16nx1n,  /* height == 2 */
+        sad_8b_neon_16nx1n,  /* height == 4 */
+        sad_8b_neon_16nx1n,  /* height == 8 */
+        sad_8b_neon_16nx1n,  /* height == 16 */
+        sad_8b_neon_16nx1n,  /* height == 32 */
+        sad_8b_neon_16nx1n,  /* height == 64 */
+        sad_8b_neon_16nx1n,  /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        sad_8b_neon_16nx1n,  /* height == 1 */
+        sad_8b_neon_16nx1n,  /* height == 2 */
+        sad_8b_neon_16nx1n,  /* height == 4 */
+        sad_8b_neon_16nx1n,  /* height == 8 */
+        sad_8b_neon_16nx1n,  /* height == 16 */
+        sad_8b_neon_16nx1n,  /* height == 32 */
+        sad_8b_neon_16nx1n,  /* height == 64 */
+        sad_8b_neon_16nx1n,  /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        sad_8b_neon_16nx1n,  /* height == 1 */
+        sad_8b_neon_16nx1n,  /* height == 2 */
+        sad_8b_neon_16nx1n,  /* height == 4 */
+        sad_8b_neon_16nx1n,  /* height == 8 */
+        sad_8b_neon_16nx1n,  /* height == 16 */
+        sad_8b_neon_16nx1n,  /* height == 32 */
+        sad_8b_neon_16nx1n,  /* height == 64 */
+        sad_8b_neon_16nx1n,  /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        sad_8b_neon_16nx1n,  /* height == 1 */
+        sad_8b_neon_16nx1n,  /* height == 2 */
+        sad_8b_neon_16nx1n,  /* height == 4 */
+        sad_8b_neon_16nx1n,  /* height == 8 */
+        sad_8b_neon_16nx1n,  /* height == 16 */
+        sad_8b_neon_16nx1n,  /* height == 32 */
+        sad_8b_neon_16nx1n,  /* height == 64 */
+        sad_8b_neon_16nx1n,  /* height == 128 */
+    }
+};
+
 
 /* DIFF **********************************************************************/
 #define NEON_DIFF_16B_4PEL(src1, src2, diff, m00, m01, m02) \
@@ -3956,9 +4130,99 @@ int xeve_had_neon(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_
     return (sum >> (bit_depth - 8));
 }
 
-const XEVE_FN_SATD xeve_tbl_satd_16b_neon[1] =
+// clang-format off
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SATD xeve_tbl_satd_16b_neon[8][8] =
 {
-    xeve_had_neon,
+    /* width == 1 */
+    {
+        xeve_had_neon, /* height == 1 */
+        xeve_had_neon, /* height == 2 */
+        xeve_had_neon, /* height == 4 */
+        xeve_had_neon, /* height == 8 */
+        xeve_had_neon, /* height == 16 */
+        xeve_had_neon, /* height == 32 */
+        xeve_had_neon, /* height == 64 */
+        xeve_had_neon, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        xeve_had_neon, /* height == 1 */
+        xeve_had_neon, /* height == 2 */
+        xeve_had_neon, /* height == 4 */
+        xeve_had_neon, /* height == 8 */
+        xeve_had_neon, /* height == 16 */
+        xeve_had_neon, /* height == 32 */
+        xeve_had_neon, /* height == 64 */
+        xeve_had_neon, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        xeve_had_neon, /* height == 1 */
+        xeve_had_neon, /* height == 2 */
+        xeve_had_neon, /* height == 4 */
+        xeve_had_neon, /* height == 8 */
+        xeve_had_neon, /* height == 16 */
+        xeve_had_neon, /* height == 32 */
+        xeve_had_neon, /* height == 64 */
+        xeve_had_neon, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        xeve_had_neon, /* height == 1 */
+        xeve_had_neon, /* height == 2 */
+        xeve_had_neon, /* height == 4 */
+        xeve_had_neon, /* height == 8 */
+        xeve_had_neon, /* height == 16 */
+        xeve_had_neon, /* height == 32 */
+        xeve_had_neon, /* height == 64 */
+        xeve_had_neon, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        xeve_had_neon, /* height == 1 */
+        xeve_had_neon, /* height == 2 */
+        xeve_had_neon, /* height == 4 */
+        xeve_had_neon, /* height == 8 */
+        xeve_had_neon, /* height == 16 */
+        xeve_had_neon, /* height == 32 */
+        xeve_had_neon, /* height == 64 */
+        xeve_had_neon, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        xeve_had_neon, /* height == 1 */
+        xeve_had_neon, /* height == 2 */
+        xeve_had_neon, /* height == 4 */
+        xeve_had_neon, /* height == 8 */
+        xeve_had_neon, /* height == 16 */
+        xeve_had_neon, /* height == 32 */
+        xeve_had_neon, /* height == 64 */
+        xeve_had_neon, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        xeve_had_neon, /* height == 1 */
+        xeve_had_neon, /* height == 2 */
+        xeve_had_neon, /* height == 4 */
+        xeve_had_neon, /* height == 8 */
+        xeve_had_neon, /* height == 16 */
+        xeve_had_neon, /* height == 32 */
+        xeve_had_neon, /* height == 64 */
+        xeve_had_neon, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        xeve_had_neon, /* height == 1 */
+        xeve_had_neon, /* height == 2 */
+        xeve_had_neon, /* height == 4 */
+        xeve_had_neon, /* height == 8 */
+        xeve_had_neon, /* height == 16 */
+        xeve_had_neon, /* height == 32 */
+        xeve_had_neon, /* height == 64 */
+        xeve_had_neon, /* height == 128 */
+    }
 };
+// clang-format on
 
 #endif
\ No newline at end of file
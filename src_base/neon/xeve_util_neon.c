@@ -0,0 +1,180 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if ARM_NEON
+/* 16 columns (one AQ block) at a time over all rows. the pair sums of a row
+   feed both the block sum and the 2x2 sub-picture average */
+void xeve_ingest_neon(const void * src, int s_src, int src_8b, pel * dst, int s_dst, int w, int h, int shift, pel * sub, int s_sub, u64 * var)
+{
+    const u8  * s;
+    pel       * d;
+    int16x8_t   cnt = vdupq_n_s16(shift);
+    uint16x8_t  a, b;
+    uint32x4_t  pa, pb, qa, qb, acc_s, acc_ss;
+    u32         sum, ssum;
+    int         x, i;
+
+    for(x = 0; x + 16 <= w; x += 16)
+    {
+        acc_s = acc_ss = qa = qb = vdupq_n_u32(0);
+        for(i = 0; i < h; i++)
+        {
+            s = (const u8 *)src + i * s_src;
+            d = dst + i * s_dst + x;
+            if(src_8b)
+            {
+                uint8x16_t t = vld1q_u8(s + x);
+                a = vmovl_u8(vget_low_u8(t));
+                b = vmovl_u8(vget_high_u8(t));
+            }
+            else
+            {
+                a = vld1q_u16((const u16 *)s + x);
+                b = vld1q_u16((const u16 *)s + x + 8);
+            }
+            a = vshlq_u16(a, cnt);
+            b = vshlq_u16(b, cnt);
+            vst1q_u16((u16 *)d, a);
+            vst1q_u16((u16 *)(d + 8), b);
+
+            pa = vpaddlq_u16(a);
+            pb = vpaddlq_u16(b);
+            acc_s = vaddq_u32(acc_s, vaddq_u32(pa, pb));
+            acc_ss = vmlal_u16(acc_ss, vget_low_u16(a), vget_low_u16(a));
+            acc_ss = vmlal_u16(acc_ss, vget_high_u16(a), vget_high_u16(a));
+            acc_ss = vmlal_u16(acc_ss, vget_low_u16(b), vget_low_u16(b));
+            acc_ss = vmlal_u16(acc_ss, vget_high_u16(b), vget_high_u16(b));
+
+            if(sub != NULL)
+            {
+                if(i & 1)
+                {
+                    /* rounding narrow adds the 2 of (a + b + c + d + 2) >> 2 */
+                    vst1q_u16((u16 *)(sub + (i >> 1) * s_sub + (x >> 1)),
+                              vcombine_u16(vrshrn_n_u32(vaddq_u32(qa, pa), 2), vrshrn_n_u32(vaddq_u32(qb, pb), 2)));
+                }
+                else
+                {
+                    qa = pa;
+                    qb = pb;
+                }
+            }
+        }
+
+        if(var != NULL && h == 16)
+        {
+            sum = vaddvq_u32(acc_s);
+            ssum = vaddvq_u32(acc_ss);
+            var[x >> 4] = (u64)ssum - (((u64)sum * sum) >> 8);
+        }
+    }
+
+    if(x < w)
+    {
+        xeve_ingest((const u8 *)src + (src_8b ? x : x << 1), s_src, src_8b, dst + x, s_dst, w - x, h, shift,
+                    (sub != NULL) ? sub + (x >> 1) : NULL, s_sub, NULL);
+    }
+}
+
+/* a 32-bit lane takes at most 128 squared 12-bit differences before it is
+   widened */
+u64 xeve_sse_neon(const pel * src1, int s_src1, const pel * src2, int s_src2, int w, int h)
+{
+    const pel * s1 = src1, * s2 = src2;
+    int16x8_t   d;
+    int32x4_t   acc;
+    uint64x2_t  acc64 = vdupq_n_u64(0);
+    u64         sum;
+    int         i, j, n, w8 = w & ~7;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w8; )
+        {
+            acc = vdupq_n_s32(0);
+            for(n = 0; n < 64 && j < w8; n++, j += 8)
+            {
+                d = vsubq_s16(vld1q_s16(s1 + j), vld1q_s16(s2 + j));
+                acc = vmlal_s16(acc, vget_low_s16(d), vget_low_s16(d));
+                acc = vmlal_s16(acc, vget_high_s16(d), vget_high_s16(d));
+            }
+            acc64 = vpadalq_u32(acc64, vreinterpretq_u32_s32(acc));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+    sum = vaddvq_u64(acc64);
+
+    if(w8 < w)
+    {
+        sum += xeve_sse(src1 + w8, s_src1, src2 + w8, s_src2, w - w8, h);
+    }
+    return sum;
+}
+
+/* two 4x4 blocks at a time, block 0 in the low and block 1 in the high half
+   of each row */
+void xeve_ssim_4x4_neon(const pel * org, int s_org, const pel * rec, int s_rec, int w, s32 (*sums)[4])
+{
+    int16x8_t a, b, s1, s2;
+    int32x4_t ss0, ss1, s120, s121, x, y, lo, hi;
+    int       i, k, w8 = w & ~7;
+
+    for(k = 0; k < w8; k += 8)
+    {
+        s1 = s2 = vdupq_n_s16(0);
+        ss0 = ss1 = s120 = s121 = vdupq_n_s32(0);
+        for(i = 0; i < 4; i++)
+        {
+            a = vld1q_s16(org + i * s_org + k);
+            b = vld1q_s16(rec + i * s_rec + k);
+            s1 = vaddq_s16(s1, a);
+            s2 = vaddq_s16(s2, b);
+            ss0 = vmlal_s16(vmlal_s16(ss0, vget_low_s16(a), vget_low_s16(a)), vget_low_s16(b), vget_low_s16(b));
+            ss1 = vmlal_s16(vmlal_s16(ss1, vget_high_s16(a), vget_high_s16(a)), vget_high_s16(b), vget_high_s16(b));
+            s120 = vmlal_s16(s120, vget_low_s16(a), vget_low_s16(b));
+            s121 = vmlal_s16(s121, vget_high_s16(a), vget_high_s16(b));
+        }
+        x = vpaddq_s32(vpaddlq_s16(s1), vpaddlq_s16(s2));
+        y = vpaddq_s32(vpaddq_s32(ss0, ss1), vpaddq_s32(s120, s121));
+        lo = vzip1q_s32(x, y);
+        hi = vzip2q_s32(x, y);
+        vst1q_s32(sums[k >> 2], vzip1q_s32(lo, hi));
+        vst1q_s32(sums[(k >> 2) + 1], vzip2q_s32(lo, hi));
+    }
+
+    if(w8 < w)
+    {
+        xeve_ssim_4x4(org + w8, s_org, rec + w8, s_rec, w - w8, sums + (w8 >> 2));
+    }
+}
+#endif /* ARM_NEON */
@@ -350,6 +350,214 @@ const XEVE_FN_SAD xeve_tbl_sad_16b_sse[8][8] =
     }
 };
 
+/* SAD of 16bit original against 8bit reference *******************************/
+int sad_8b_sse_4x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1;
+    u8  * s2;
+    __m128i s00, s01, r00, r01, sac0;
+    __m128i ones = _mm_set1_epi16(1);
+    int i, sad;
+
+    s1 = (s16 *)src1;
+    s2 = (u8 *)src2;
+
+    sac0 = _mm_setzero_si128();
+
+    for(i = 0; i < h >> 1; i++)
+    {
+        s00 = _mm_loadl_epi64((__m128i*)s1);
+        s01 = _mm_loadl_epi64((__m128i*)(s1 + s_src1));
+        s00 = _mm_unpacklo_epi64(s00, s01);
+
+        r00 = _mm_cvtsi32_si128(*(int*)s2);
+        r01 = _mm_cvtsi32_si128(*(int*)(s2 + s_src2));
+        r00 = _mm_cvtepu8_epi16(_mm_unpacklo_epi32(r00, r01));
+
+        s00 = _mm_abs_epi16(_mm_sub_epi16(s00, r00));
+        sac0 = _mm_add_epi32(sac0, _mm_madd_epi16(s00, ones));
+
+        s1 += s_src1 << 1;
+        s2 += s_src2 << 1;
+    }
+
+    sac0 = _mm_hadd_epi32(sac0, sac0);
+    sac0 = _mm_hadd_epi32(sac0, sac0);
+    sad = _mm_extract_epi32(sac0, 0);
+
+    return (sad >> (bit_depth - 8));
+}
+
+int sad_8b_sse_8x1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1;
+    u8  * s2;
+    __m128i s00, r00, sac0;
+    __m128i ones = _mm_set1_epi16(1);
+    int i, sad;
+
+    s1 = (s16 *)src1;
+    s2 = (u8 *)src2;
+
+    sac0 = _mm_setzero_si128();
+
+    for(i = 0; i < h; i++)
+    {
+        s00 = _mm_loadu_si128((__m128i*)s1);
+        r00 = _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i*)s2));
+
+        s00 = _mm_abs_epi16(_mm_sub_epi16(s00, r00));
+        sac0 = _mm_add_epi32(sac0, _mm_madd_epi16(s00, ones));
+
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    sac0 = _mm_hadd_epi32(sac0, sac0);
+    sac0 = _mm_hadd_epi32(sac0, sac0);
+    sad = _mm_extract_epi32(sac0, 0);
+
+    return (sad >> (bit_depth - 8));
+}
+
+int sad_8b_sse_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 * s1;
+    u8  * s2;
+    __m128i s00, s01, r00, r01, sac0;
+    __m128i zero = _mm_setzero_si128();
+    __m128i ones = _mm_set1_epi16(1);
+    int i, j, sad;
+
+    assert(!(w & 15));
+
+    s1 = (s16 *)src1;
+    s2 = (u8 *)src2;
+
+    sac0 = _mm_setzero_si128();
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j += 16)
+        {
+            s00 = _mm_loadu_si128((__m128i*)(s1 + j));
+            s01 = _mm_loadu_si128((__m128i*)(s1 + j + 8));
+            r01 = _mm_loadu_si128((__m128i*)(s2 + j));
+            r00 = _mm_unpacklo_epi8(r01, zero);
+            r01 = _mm_unpackhi_epi8(r01, zero);
+
+            s00 = _mm_abs_epi16(_mm_sub_epi16(s00, r00));
+            s01 = _mm_abs_epi16(_mm_sub_epi16(s01, r01));
+            s00 = _mm_add_epi16(s00, s01);
+            sac0 = _mm_add_epi32(sac0, _mm_madd_epi16(s00, ones));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    sac0 = _mm_hadd_epi32(sac0, sac0);
+    sac0 = _mm_hadd_epi32(sac0, sac0);
+    sad = _mm_extract_epi32(sac0, 0);
+
+    return (sad >> (bit_depth - 8));
+}
+
+// clang-format off
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SAD xeve_tbl_sad_8b_sse[8][8] =
+{
+    /* width == 1 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b,              /* height == 2 */
+        sad_8b,              /* height == 4 */
+        sad_8b,              /* height == 8 */
+        sad_8b,              /* height == 16 */
+        sad_8b,              /* height == 32 */
+        sad_8b,              /* height == 64 */
+        sad_8b,              /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b,              /* height == 2 */
+        sad_8b,              /* height == 4 */
+        sad_8b,              /* height == 8 */
+        sad_8b,              /* height == 16 */
+        sad_8b,              /* height == 32 */
+        sad_8b,              /* height == 64 */
+        sad_8b,              /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        sad_8b,              /* height == 1 */
+        sad_8b_sse_4x2n,     /* height == 2 */
+        sad_8b_sse_4x2n,     /* height == 4 */
+        sad_8b_sse_4x2n,     /* height == 8 */
+        sad_8b_sse_4x2n,     /* height == 16 */
+        sad_8b_sse_4x2n,     /* height == 32 */
+        sad_8b_sse_4x2n,     /* height == 64 */
+        sad_8b_sse_4x2n,     /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        sad_8b_sse_8x1n,     /* height == 1 */
+        sad_8b_sse_8x1n,     /* height == 2 */
+        sad_8b_sse_8x1n,     /* height == 4 */
+        sad_8b_sse_8x1n,     /* height == 8 */
+        sad_8b_sse_8x1n,     /* height == 16 */
+        sad_8b_sse_8x1n,     /* height == 32 */
+        sad_8b_sse_8x1n,     /* height == 64 */
+        sad_8b_sse_8x1n,     /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        sad_8b_sse_16nx1n,   /* height == 1 */
+        sad_8b_sse_16nx1n,   /* height == 2 */
+        sad_8b_sse_16nx1n,   /* height == 4 */
+        sad_8b_sse_16nx1n,   /* height == 8 */
+        sad_8b_sse_16nx1n,   /* height == 16 */
+        sad_8b_sse_16nx1n,   /* height == 32 */
+        sad_8b_sse_16nx1n,   /* height == 64 */
+        sad_8b_sse_16nx1n,   /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        sad_8b_sse_16nx1n,   /* height == 1 */
+        sad_8b_sse_16nx1n,   /* height == 2 */
+        sad_8b_sse_16nx1n,   /* height == 4 */
+        sad_8b_sse_16nx1n,   /* height == 8 */
+        sad_8b_sse_16nx1n,   /* height == 16 */
+        sad_8b_sse_16nx1n,   /* height == 32 */
+        sad_8b_sse_16nx1n,   /* height == 64 */
+        sad_8b_sse_16nx1n,   /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        sad_8b_sse_16nx1n,   /* height == 1 */
+        sad_8b_sse_16nx1n,   /* height == 2 */
+        sad_8b_sse_16nx1n,   /* height == 4 */
+        sad_8b_sse_16nx1n,   /* height == 8 */
+        sad_8b_sse_16nx1n,   /* height == 16 */
+        sad_8b_sse_16nx1n,   /* height == 32 */
+        sad_8b_sse_16nx1n,   /* height == 64 */
+        sad_8b_sse_16nx1n,   /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        sad_8b_sse_16nx1n,   /* height == 1 */
+        sad_8b_sse_16nx1n,   /* height == 2 */
+        sad_8b_sse_16nx1n,   /* height == 4 */
+        sad_8b_sse_16nx1n,   /* height == 8 */
+        sad_8b_sse_16nx1n,   /* height == 16 */
+        sad_8b_sse_16nx1n,   /* height == 32 */
+        sad_8b_sse_16nx1n,   /* height == 64 */
+        sad_8b_sse_16nx1n,   /* height == 128 */
+    }
+};
+// clang-format on
+
 
 /* DIFF **********************************************************************/
 #define SSE_DIFF_16B_4PEL(src1, src2, diff, m00, m01, m02) \
@@ -366,7 +574,7 @@ const XEVE_FN_SAD xeve_tbl_sad_16b_sse[8][8] =
 
 // clang-format on
 
-static void diff_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+void diff_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
     s16 * s1;
     s16 * s2;
@@ -379,7 +587,7 @@ static void diff_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1,
     SSE_DIFF_16B_4PEL(s1 + s_src1, s2 + s_src2, diff + s_diff, m04, m05, m06);
 }
 
-static void diff_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+void diff_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
     s16 * s1;
     s16 * s2;
@@ -394,7 +602,7 @@ static void diff_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1,
     SSE_DIFF_16B_4PEL(s1 + s_src1*3, s2 + s_src2*3, diff + s_diff*3, m10, m11, m12);
 }
 
-static void diff_16b_sse_8x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+void diff_16b_sse_8x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
     s16 * s1;
     s16 * s2;
@@ -413,7 +621,7 @@ static void diff_16b_sse_8x8(int w, int h, void * src1, void * src2, int s_src1,
     SSE_DIFF_16B_8PEL(s1 + s_src1*7, s2 + s_src2*7, diff + s_diff*7, m10, m11, m12);
 }
 
-static void diff_16b_sse_8nx2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
+void diff_16b_sse_8nx2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
     s16 * s1;
     s16 * s2;
@@ -634,7 +842,7 @@ const XEVE_FN_DIFF xeve_tbl_diff_16b_sse[8][8] =
 
 // clang-format on
 
-static s64 ssd_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -658,7 +866,7 @@ static s64 ssd_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, i
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -684,7 +892,7 @@ static s64 ssd_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, i
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -714,7 +922,7 @@ static s64 ssd_16b_sse_4x8(int w, int h, void * src1, void * src2, int s_src1, i
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x16(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x16(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -752,7 +960,7 @@ static s64 ssd_16b_sse_4x16(int w, int h, void * src1, void * src2, int s_src1,
     return ssd;
 }
 
-static s64 ssd_16b_sse_4x32(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
+s64 ssd_16b_sse_4x32(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth)
 {
     s64   ssd;
     s16 * s1;
@@ -2755,8 +2963,98 @@ int xeve_had_sse(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_d
     return (sum >> (bit_depth - 8));
 }
 
-const XEVE_FN_SATD xeve_tbl_satd_16b_sse[1] =
+// clang-format off
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SATD xeve_tbl_satd_16b_sse[8][8] =
 {
-    xeve_had_sse,
+    /* width == 1 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        xeve_had_sse, /* height == 1 */
+        xeve_had_sse, /* height == 2 */
+        xeve_had_sse, /* height == 4 */
+        xeve_had_sse, /* height == 8 */
+        xeve_had_sse, /* height == 16 */
+        xeve_had_sse, /* height == 32 */
+        xeve_had_sse, /* height == 64 */
+        xeve_had_sse, /* height == 128 */
+    }
 };
+// clang-format on
 
@@ -35,15 +35,34 @@
 #include "xeve_sad.h"
 #if X86_SSE
 extern const XEVE_FN_SAD xeve_tbl_sad_16b_sse[8][8];
+extern const XEVE_FN_SAD xeve_tbl_sad_8b_sse[8][8];
 extern const XEVE_FN_SSD xeve_tbl_ssd_16b_sse[8][8];
 extern const XEVE_FN_DIFF xeve_tbl_diff_16b_sse[8][8];
-extern const XEVE_FN_SATD xeve_tbl_satd_16b_sse[1];
+extern const XEVE_FN_SATD xeve_tbl_satd_16b_sse[8][8];
 
 int sad_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
 int sad_16b_sse_4x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
 int sad_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
 int sad_16b_sse_8x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
 int sad_16b_sse_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+int sad_8b_sse_4x2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+int sad_8b_sse_8x1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+int sad_8b_sse_16nx1n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+
+void diff_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth);
+void diff_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth);
+void diff_16b_sse_8x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth);
+void diff_16b_sse_8nx2n(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth);
+
+s64 ssd_16b_sse_4x2(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_4x4(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_4x8(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_4x16(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+s64 ssd_16b_sse_4x32(int w, int h, void * src1, void * src2, int s_src1, int s_src2, int bit_depth);
+
+int xeve_had_8x4_sse(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int xeve_had_4x8_sse(pel *org, pel *cur, int s_org, int s_cur, int step, int bit_depth);
+int xeve_had_sse(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth);
 
 #endif /* X86_SSE */
 #endif /* _XEVE_SAD_SSE_H_ */
@@ -0,0 +1,178 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+
+#if X86_SSE
+/* 16 columns (one AQ block) at a time over all rows. the pair sums of a row
+   feed both the block sum and the 2x2 sub-picture average */
+void xeve_ingest_sse(const void * src, int s_src, int src_8b, pel * dst, int s_dst, int w, int h, int shift, pel * sub, int s_sub, u64 * var)
+{
+    const u8 * s;
+    pel      * d;
+    __m128i    ones = _mm_set1_epi16(1);
+    __m128i    two = _mm_set1_epi32(2);
+    __m128i    cnt = _mm_cvtsi32_si128(shift);
+    __m128i    a, b, pa, pb, qa, qb, acc_s, acc_ss;
+    u32        sum, ssum;
+    int        x, i;
+
+    for(x = 0; x + 16 <= w; x += 16)
+    {
+        acc_s = acc_ss = qa = qb = _mm_setzero_si128();
+        for(i = 0; i < h; i++)
+        {
+            s = (const u8 *)src + i * s_src;
+            d = dst + i * s_dst + x;
+            if(src_8b)
+            {
+                a = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(s + x)));
+                b = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(s + x + 8)));
+            }
+            else
+            {
+                a = _mm_loadu_si128((const __m128i *)((const u16 *)s + x));
+                b = _mm_loadu_si128((const __m128i *)((const u16 *)s + x + 8));
+            }
+            a = _mm_sll_epi16(a, cnt);
+            b = _mm_sll_epi16(b, cnt);
+            _mm_storeu_si128((__m128i *)d, a);
+            _mm_storeu_si128((__m128i *)(d + 8), b);
+
+            pa = _mm_madd_epi16(a, ones);
+            pb = _mm_madd_epi16(b, ones);
+            acc_s = _mm_add_epi32(acc_s, _mm_add_epi32(pa, pb));
+            acc_ss = _mm_add_epi32(acc_ss, _mm_add_epi32(_mm_madd_epi16(a, a), _mm_madd_epi16(b, b)));
+
+            if(sub != NULL)
+            {
+                if(i & 1)
+                {
+                    qa = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(qa, pa), two), 2);
+                    qb = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(qb, pb), two), 2);
+                    _mm_storeu_si128((__m128i *)(sub + (i >> 1) * s_sub + (x >> 1)), _mm_packus_epi32(qa, qb));
+                }
+                else
+                {
+                    qa = pa;
+                    qb = pb;
+                }
+            }
+        }
+
+        if(var != NULL && h == 16)
+        {
+            acc_s = _mm_add_epi32(acc_s, _mm_srli_si128(acc_s, 8));
+            acc_s = _mm_add_epi32(acc_s, _mm_srli_si128(acc_s, 4));
+            acc_ss = _mm_add_epi32(acc_ss, _mm_srli_si128(acc_ss, 8));
+            acc_ss = _mm_add_epi32(acc_ss, _mm_srli_si128(acc_ss, 4));
+            sum = (u32)_mm_cvtsi128_si32(acc_s);
+            ssum = (u32)_mm_cvtsi128_si32(acc_ss);
+            var[x >> 4] = (u64)ssum - (((u64)sum * sum) >> 8);
+        }
+    }
+
+    if(x < w)
+    {
+        xeve_ingest((const u8 *)src + (src_8b ? x : x << 1), s_src, src_8b, dst + x, s_dst, w - x, h, shift,
+                    (sub != NULL) ? sub + (x >> 1) : NULL, s_sub, NULL);
+    }
+}
+
+/* a 32-bit lane takes at most 64 squared pairs of 12-bit differences before
+   it is widened */
+u64 xeve_sse_sse(const pel * src1, int s_src1, const pel * src2, int s_src2, int w, int h)
+{
+    const pel * s1 = src1, * s2 = src2;
+    __m128i     zero = _mm_setzero_si128();
+    __m128i     acc, acc64 = zero, d;
+    u64         sum[2];
+    int         i, j, n, w8 = w & ~7;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w8; )
+        {
+            acc = zero;
+            for(n = 0; n < 64 && j < w8; n++, j += 8)
+            {
+                d = _mm_sub_epi16(_mm_loadu_si128((const __m128i *)(s1 + j)), _mm_loadu_si128((const __m128i *)(s2 + j)));
+                acc = _mm_add_epi32(acc, _mm_madd_epi16(d, d));
+            }
+            acc64 = _mm_add_epi64(acc64, _mm_unpacklo_epi32(acc, zero));
+            acc64 = _mm_add_epi64(acc64, _mm_unpackhi_epi32(acc, zero));
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+    _mm_storeu_si128((__m128i *)sum, acc64);
+    sum[0] += sum[1];
+
+    if(w8 < w)
+    {
+        sum[0] += xeve_sse(src1 + w8, s_src1, src2 + w8, s_src2, w - w8, h);
+    }
+    return sum[0];
+}
+
+/* two 4x4 blocks at a time. the block pairs are reduced with horizontal adds
+   to (b0, b1, b0, b1) lanes and interleaved into one row of sums per block */
+void xeve_ssim_4x4_sse(const pel * org, int s_org, const pel * rec, int s_rec, int w, s32 (*sums)[4])
+{
+    __m128i ones = _mm_set1_epi16(1);
+    __m128i a, b, s1, s2, ss, s12, x, y;
+    int     i, k, w8 = w & ~7;
+
+    for(k = 0; k < w8; k += 8)
+    {
+        s1 = s2 = ss = s12 = _mm_setzero_si128();
+        for(i = 0; i < 4; i++)
+        {
+            a = _mm_loadu_si128((const __m128i *)(org + i * s_org + k));
+            b = _mm_loadu_si128((const __m128i *)(rec + i * s_rec + k));
+            s1 = _mm_add_epi16(s1, a);
+            s2 = _mm_add_epi16(s2, b);
+            ss = _mm_add_epi32(ss, _mm_add_epi32(_mm_madd_epi16(a, a), _mm_madd_epi16(b, b)));
+            s12 = _mm_add_epi32(s12, _mm_madd_epi16(a, b));
+        }
+        x = _mm_hadd_epi32(_mm_madd_epi16(s1, ones), _mm_madd_epi16(s2, ones));
+        y = _mm_hadd_epi32(ss, s12);
+        a = _mm_unpacklo_epi32(x, y);
+        b = _mm_unpackhi_epi32(x, y);
+        _mm_storeu_si128((__m128i *)sums[k >> 2], _mm_unpacklo_epi32(a, b));
+        _mm_storeu_si128((__m128i *)sums[(k >> 2) + 1], _mm_unpackhi_epi32(a, b));
+    }
+
+    if(w8 < w)
+    {
+        xeve_ssim_4x4(org + w8, s_org, rec + w8, s_rec, w - w8, sums + (w8 >> 2));
+    }
+}
+#endif /* X86_SSE */
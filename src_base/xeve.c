@@ -54,6 +54,7 @@ XEVE xeve_create(XEVE_CDSC * cdsc, int * err)
 
     /* set default value for encoding parameter */
     xeve_mcpy(&ctx->param, &(cdsc->param), sizeof(XEVE_PARAM));
+    ctx->pool = (THREAD_POOL *)cdsc->pool;
     ret = xeve_set_init_param(ctx, &ctx->param);
     xeve_assert_g(ret == XEVE_OK, ERR);
     xeve_assert_g(ctx->param.profile == XEVE_PROFILE_BASELINE, ERR);
@@ -110,6 +111,16 @@ void xeve_delete(XEVE id)
     xeve_ctx_free(ctx);
 }
 
+XEVE_POOL xeve_pool_create(int threads, const char * cpu_set, int * err)
+{
+    return xeve_pool_alloc(threads, cpu_set, err);
+}
+
+int xeve_pool_delete(XEVE_POOL pool)
+{
+    return xeve_pool_free(pool);
+}
+
 int xeve_encode(XEVE id, XEVE_BITB * bitb, XEVE_STAT * stat)
 {
     XEVE_CTX * ctx;
@@ -289,8 +300,17 @@ int xeve_config(XEVE id, int cfg, void * buf, int * size)
                 }
             }
 
+            /* 8bit pictures are handed out with one byte per sample */
+            if (XEVE_CS_GET_BIT_DEPTH(imgb->cs) == 8)
+            {
+                imgb = xeve_imgb_create_8b(imgb);
+                xeve_assert_rv(imgb != NULL, XEVE_ERR_OUT_OF_MEMORY);
+            }
+            else
+            {
+                imgb->addref(imgb);
+            }
             *((XEVE_IMGB **)buf) = imgb;
-            imgb->addref(imgb);
             break;
         case XEVE_CFG_GET_USE_DEBLOCK:
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
@@ -363,6 +383,15 @@ int xeve_param_check(const XEVE_PARAM* param)
     if (param->ibc_flag     == 1) { xeve_trace("IBC cannot be on in base profile\n"); ret = -1; }
     if (param->tool_rpl     == 1) { xeve_trace("RPL cannot be on in base profile\n"); ret = -1; }
     if (param->tool_pocs    == 1) { xeve_trace("POCS cannot be on in base profile\n"); ret = -1; }
+    if (param->rdo_bit_est < 0 || param->rdo_bit_est > 1) { xeve_trace("RDO_BIT_EST should be 0 or 1\n"); ret = -1; }
+    if (param->intra_refresh < 0 || param->intra_refresh > 1) { xeve_trace("INTRA_REFRESH should be 0 or 1\n"); ret = -1; }
+    if (param->intra_refresh == 1 && param->bframes > 0) { xeve_trace("INTRA_REFRESH cannot be on with B pictures\n"); ret = -1; }
+    if (param->pass < 0 || param->pass > 2) { xeve_trace("PASS should be 0, 1 or 2\n"); ret = -1; }
+    if (param->pass > 0 && param->stats_file[0] == 0) { xeve_trace("STATS_FILE is needed for multi-pass encoding\n"); ret = -1; }
+    if (param->fcst_level < 0 || param->fcst_level >= XEVE_FCST_LVL_MAX) { xeve_trace("FCST_LEVEL should be in range of 0 to 2\n"); ret = -1; }
+    if (param->static_th < 0 || param->static_th > 255) { xeve_trace("STATIC_TH should be in range of 0 to 255\n"); ret = -1; }
+    if (param->calc_metrics < 0 || param->calc_metrics > 2) { xeve_trace("CALC_METRICS should be in range of 0 to 2\n"); ret = -1; }
+    if (param->mc_cache < 0 || param->mc_cache > 1) { xeve_trace("MC_CACHE should be 0 or 1\n"); ret = -1; }
 
     if (XEVE_CS_GET_FORMAT(param->cs) != XEVE_CF_YCBCR400)
     {
@@ -834,6 +834,9 @@ typedef struct _XEVE_RPL
     char            pic_type;
 } XEVE_RPL;
 
+/* pels below the motion search range read by interpolation and MV refinement */
+#define XEVE_PIC_PROGRESS_MARGIN          16
+
 /* picture store structure */
 typedef struct _XEVE_PIC
 {
@@ -849,6 +852,11 @@ typedef struct _XEVE_PIC
     pel             *u;
     /* Start address of V component (except padding)  */
     pel             *v;
+    /* Address of 8bit copy of Y buffer (include padding), for integer-pel
+       motion search in 8bit pictures; NULL when not allocated */
+    u8              *buf_y8;
+    /* Start address of 8bit copy of Y component (except padding) */
+    u8              *y8;
     /* Stride of luma picture */
     int              s_l;
     /* Stride of chroma picture */
@@ -885,6 +893,14 @@ typedef struct _XEVE_PIC
     int              pic_qp_u_offset;
     int              pic_qp_v_offset;
     u8               digest[N_C][16];
+    /* number of CTU rows completed from the top of the picture, so that
+       consumers can run ahead of the whole picture being finished */
+    volatile s32     rows_recon;    /* reconstructed */
+    volatile s32     rows_filtered; /* in-loop filtered */
+    volatile s32     rows_padded;   /* padded, usable as reference */
+    /* width from the left of the area refreshed by intra coding in the
+       intra refresh cycle of the picture, in luma samples */
+    s32              ir_clean_w;
 } XEVE_PIC;
 
 /*****************************************************************************
@@ -1353,6 +1369,12 @@ typedef struct _XEVE_TILE
     u16              ctba_rs_first;
     u8               qp;
     u8               qp_prev_eco[XEVE_MAX_THREADS];
+    /* number of CTU rows of the tile encoded in parallel */
+    u8               parallel_rows;
+    /* next CTU row of the tile to be claimed by a row thread */
+    volatile s32     next_row;
+    /* first of the parallel_rows cores carrying the state of the row lanes */
+    u8               core_base;
 } XEVE_TILE;
 
 /*****************************************************************************/
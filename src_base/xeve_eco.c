@@ -305,10 +305,9 @@ int xeve_eco_sh(XEVE_BSW * bs, XEVE_SPS * sps, XEVE_PPS * pps, XEVE_SH * sh, int
 
 int xeve_eco_pic_signature(XEVE_CTX * ctx, XEVE_BSW * bs, u8 pic_sign[N_C][16])
 {
-    int ret;
-    ret = xeve_picbuf_signature(PIC_CURR(ctx), pic_sign);
-    xeve_assert_rv(ret == XEVE_OK, ret);
-    return ret;
+    /* computed while the picture is padded */
+    xeve_mcpy(pic_sign, PIC_CURR(ctx)->digest, sizeof(PIC_CURR(ctx)->digest));
+    return XEVE_OK;
 }
 
 int xeve_eco_signature(XEVE_CTX * ctx, XEVE_BSW * bs)
@@ -488,6 +487,12 @@ void sbac_encode_bin_ep(u32 bin, XEVE_SBAC *sbac, XEVE_BSW *bs)
 {
     sbac->bin_counter++;
 
+    if(sbac->is_bitcount == SBAC_BITCOUNT_EST)
+    {
+        sbac->frac_bits += 1 << SBAC_EST_BITS_SHIFT;
+        return;
+    }
+
     (sbac->range) >>= 1;
 
     if(bin != 0)
@@ -553,6 +558,61 @@ void sbac_encode_bins_ep(u32 value, int num_bin, XEVE_SBAC *sbac, XEVE_BSW *bs)
     }
 }
 
+static __inline void sbac_update_model(u32 bin, SBAC_CTX_MODEL *model, u16 state, u16 mps)
+{
+    if(bin != mps)
+    {
+        state = state + ((512 - state + 16) >> 5);
+        if(state > 256)
+        {
+            mps = 1 - mps;
+            state = 512 - state;
+        }
+    }
+    else
+    {
+        state = state - ((state + 16) >> 5);
+    }
+    *model = (state << 1) + mps;
+}
+
+static __inline void sbac_ckpt_touch(XEVE_SBAC *sbac, SBAC_CTX_MODEL *model)
+{
+    u32 pos = (u32)((u8 *)model - (u8 *)&sbac->ctx);
+
+    /* models outside of the own context set invalidate the checkpoint */
+    sbac->ckpt_dirty |= pos < sizeof(XEVE_SBAC_CTX) ? 1u << (pos >> SBAC_CKPT_GRP_LOG2) : 0xFFFFFFFF;
+    sbac->ver++;
+}
+
+void xeve_sbac_copy(XEVE_SBAC *dst, XEVE_SBAC *src)
+{
+    u32 dirty;
+    int pos, size;
+
+    if(dst->ckpt_on && dst->ckpt_src == src && dst->ckpt_ver == src->ver && dst->ckpt_dirty != 0xFFFFFFFF)
+    {
+        /* roll back to the source, only the touched model groups are copied */
+        xeve_mcpy(dst, src, offsetof(XEVE_SBAC, ctx));
+        for(dirty = dst->ckpt_dirty, pos = 0; dirty; dirty >>= 1, pos += 1 << SBAC_CKPT_GRP_LOG2)
+        {
+            if(dirty & 1)
+            {
+                size = XEVE_MIN(1 << SBAC_CKPT_GRP_LOG2, (int)sizeof(XEVE_SBAC_CTX) - pos);
+                xeve_mcpy((u8 *)&dst->ctx + pos, (u8 *)&src->ctx + pos, size);
+            }
+        }
+    }
+    else
+    {
+        xeve_mcpy(dst, src, SBAC_STATE_SIZE);
+        dst->ckpt_src = src;
+        dst->ckpt_ver = src->ver;
+    }
+    dst->ckpt_dirty = 0;
+    dst->ver++;
+}
+
 void xeve_sbac_encode_bin(u32 bin, XEVE_SBAC *sbac, SBAC_CTX_MODEL *model, XEVE_BSW *bs)
 {
     u32 lps;
@@ -560,9 +620,21 @@ void xeve_sbac_encode_bin(u32 bin, XEVE_SBAC *sbac, SBAC_CTX_MODEL *model, XEVE_
 
     sbac->bin_counter++;
 
+    if(sbac->ckpt_on)
+    {
+        sbac_ckpt_touch(sbac, model);
+    }
+
     state = (*model) >> 1;
     mps = (*model) & 1;
 
+    if(sbac->is_bitcount == SBAC_BITCOUNT_EST)
+    {
+        sbac->frac_bits += xeve_entropy_bits[(bin != mps ? state : 512 - state) << 1];
+        sbac_update_model(bin, model, state, mps);
+        return;
+    }
+
     lps = (state * (sbac->range)) >> 9;
     lps = lps < 437 ? 437 : lps;
 
@@ -579,28 +651,14 @@ void xeve_sbac_encode_bin(u32 bin, XEVE_SBAC *sbac, SBAC_CTX_MODEL *model, XEVE_
     XEVE_TRACE_STR("\n");
 #endif
 
-    if(bin != mps)
-    {
-        if(sbac->range >= lps)
-        {
-            sbac->code += sbac->range;
-            sbac->range = lps;
-        }
-
-        state = state + ((512 - state + 16) >> 5);
-        if(state > 256)
-        {
-            mps = 1 - mps;
-            state = 512 - state;
-        }
-        *model = (state << 1) + mps;
-    }
-    else
+    if(bin != mps && sbac->range >= lps)
     {
-        state = state - ((state + 16) >> 5);
-        *model = (state << 1) + mps;
+        sbac->code += sbac->range;
+        sbac->range = lps;
     }
 
+    sbac_update_model(bin, model, state, mps);
+
     while(sbac->range < 8192)
     {
         sbac->range <<= 1;
@@ -618,6 +676,14 @@ void xeve_sbac_encode_bin(u32 bin, XEVE_SBAC *sbac, SBAC_CTX_MODEL *model, XEVE_
 void xeve_sbac_encode_bin_trm(u32 bin, XEVE_SBAC *sbac, XEVE_BSW *bs)
 {
     sbac->bin_counter++;
+
+    if(sbac->is_bitcount == SBAC_BITCOUNT_EST)
+    {
+        /* terminating bin 1 takes a range of 1 out of about 2^13.5 */
+        sbac->frac_bits += bin ? 27 << (SBAC_EST_BITS_SHIFT - 1) : 0;
+        return;
+    }
+
     sbac->range--;
 
     if(bin)
@@ -643,6 +709,9 @@ void xeve_sbac_reset(XEVE_SBAC *sbac, u8 slice_type, u8 slice_qp, int sps_cm_ini
     XEVE_SBAC_CTX *sbac_ctx;
     sbac_ctx = &sbac->ctx;
 
+    /* a checkpoint tracks touched model groups in 32-bit mask */
+    xeve_assert(sizeof(XEVE_SBAC_CTX) <= (32 << SBAC_CKPT_GRP_LOG2));
+
     /* Initialization of the internal variables */
     sbac->range = 16384;
     sbac->code = 0;
@@ -652,6 +721,8 @@ void xeve_sbac_reset(XEVE_SBAC *sbac, u8 slice_type, u8 slice_qp, int sps_cm_ini
     sbac->stacked_ff = 0;
     sbac->stacked_zero = 0;
     sbac->bin_counter = 0;
+    sbac->ckpt_src = NULL;
+    sbac->ver++;
 
     xeve_mset(sbac_ctx, 0x00, sizeof(*sbac_ctx));
 
@@ -40,6 +40,7 @@ void sbac_encode_bin_ep(u32 bin, XEVE_SBAC *sbac, XEVE_BSW *bs);
 void sbac_encode_bins_ep(u32 value, int num_bin, XEVE_SBAC *sbac, XEVE_BSW *bs);
 void sbac_write_truncate_unary_sym(u32 sym, u32 num_ctx, u32 max_num, XEVE_SBAC *sbac, SBAC_CTX_MODEL *model, XEVE_BSW *bs);
 void xeve_sbac_reset(XEVE_SBAC * sbac, u8 slice_type, u8 slice_qp, int sps_cm_init_flag);
+void xeve_sbac_copy(XEVE_SBAC *dst, XEVE_SBAC *src);
 void xeve_sbac_finish(XEVE_BSW *bs);
 void xeve_sbac_encode_bin(u32 bin, XEVE_SBAC *sbac, SBAC_CTX_MODEL *ctx_model, XEVE_BSW *bs);
 void xeve_sbac_encode_bin_trm(u32 bin, XEVE_SBAC *sbac, XEVE_BSW *bs);
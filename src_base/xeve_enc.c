@@ -87,6 +87,9 @@ ERR:
     return ret;
 }
 
+/* CTU rows of a tile are claimed one at a time by the threads of the tile,
+   so a thread done with a quick row moves on to the next one instead of
+   waiting for a row fixed to it */
 static int xeve_ctu_mt_core(void * arg)
 {
     assert(arg != NULL);
@@ -94,61 +97,113 @@ static int xeve_ctu_mt_core(void * arg)
     XEVE_BSW  * bs;
     XEVE_CORE * core = (XEVE_CORE *)arg;
     XEVE_CTX  * ctx = core->ctx;
-    bs = &ctx->bs[core->thread_cnt];
     int i = core->tile_num;
+    XEVE_TILE * tile = &ctx->tile[i];
+    int sp_y_lcu = tile->ctba_rs_first / ctx->w_lcu;
+    int bef_cu_qp, x, ret;
 
-    /* CABAC Initialize for each Tile */
-    ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
-    ctx->fn_eco_sbac_reset(&core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
-
-    /*Set entry point for each ctu row in the tile*/
-    int sp_x_lcu = ctx->tile[core->tile_num].ctba_rs_first % ctx->w_lcu;
-    int sp_y_lcu = ctx->tile[core->tile_num].ctba_rs_first / ctx->w_lcu;
-    xeve_update_core_loc_param_mt(ctx, core);
-
-    int bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
-
-    /* LCU encoding loop */
-    while (ctx->tile[i].f_ctb > 0)
+    while ((core = xeve_mt_claim_row(ctx, tile)) != NULL)
     {
-        if (core->y_lcu != sp_y_lcu && core->x_lcu < (sp_x_lcu + ctx->tile[core->tile_idx].w_ctb - 1))
+        bs = &ctx->bs[core->thread_cnt];
+
+        /* CABAC Initialize for each Tile, at the first row of each lane */
+        if (core->y_lcu - sp_y_lcu < tile->parallel_rows)
         {
-            /* up-right CTB */
-            spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED);
+            ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
+            ctx->fn_eco_sbac_reset(&core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
         }
+        bef_cu_qp = tile->qp_prev_eco[core->thread_cnt];
 
-        /* initialize structures *****************************************/
-        int ret = ctx->fn_mode_init_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret);
+        /* LCU encoding loop */
+        for (x = 0; x < tile->w_ctb; x++)
+        {
+            if (core->y_lcu != sp_y_lcu)
+            {
+                /* up-right CTB, or the above one at the right of the tile */
+                spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + (x < tile->w_ctb - 1)], THREAD_TERMINATED);
+            }
+            xeve_refp_wait_lcu(ctx, core);
 
-        /* mode decision *************************************************/
-        SBAC_LOAD(core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], *GET_SBAC_ENC(bs));
-        core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].is_bitcount = 1;
+            /* initialize structures *****************************************/
+            ret = ctx->fn_mode_init_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-        ret = ctx->fn_mode_analyze_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret);
+            /* mode decision *************************************************/
+            SBAC_LOAD(core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], *GET_SBAC_ENC(bs));
+            core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].is_bitcount = ctx->param.rdo_bit_est ? SBAC_BITCOUNT_EST : SBAC_BITCOUNT_EXACT;
 
-        ret = ctx->fn_mode_post_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret)
+            ret = ctx->fn_mode_analyze_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-        ctx->tile[i].qp_prev_eco[core->thread_cnt] = bef_cu_qp;
+            ret = ctx->fn_mode_post_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret)
 
-        /* entropy coding ************************************************/
-        ret = xeve_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 0, xeve_get_default_tree_cons(), bs);
-        bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
+            tile->qp_prev_eco[core->thread_cnt] = bef_cu_qp;
 
-        xeve_assert_rv(ret == XEVE_OK, ret);
+            /* entropy coding ************************************************/
+            ret = xeve_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 0, xeve_get_default_tree_cons(), bs);
+            bef_cu_qp = tile->qp_prev_eco[core->thread_cnt];
 
-        threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
-        threadsafe_decrement(ctx->sync_block, (volatile s32 *)&ctx->tile[i].f_ctb);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+
+            threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
+            xeve_pic_progress_ctu_done(ctx, core);
+            threadsafe_decrement(ctx->sync_block, (volatile s32 *)&tile->f_ctb);
 
-        core->lcu_num = xeve_mt_get_next_ctu_num(ctx, core, ctx->parallel_rows);
-        if (core->lcu_num == -1)
-            break;
+            core->x_lcu++;
+            core->lcu_num++;
+            xeve_update_core_loc_param_mt(ctx, core);
+        }
     }
     return XEVE_OK;
 }
 
+static int xeve_tile_mt_core(void * arg)
+{
+    XEVE_CORE * core = (XEVE_CORE *)arg;
+    XEVE_CTX  * ctx = core->ctx;
+    XEVE_TILE * tile = &ctx->tile[core->tile_idx];
+    int         temp_store_total_ctb = tile->f_ctb;
+    int         thread_cnt, res, ret = XEVE_OK;
+
+    /* CTU rows of the tile run on the threads following the one of the tile.
+       all lane cores are set up before any thread starts to claim rows */
+    for (thread_cnt = core->thread_cnt + 1; thread_cnt < core->thread_cnt + tile->parallel_rows; thread_cnt++)
+    {
+        tile->qp_prev_eco[thread_cnt] = ctx->sh->qp;
+        ctx->core[thread_cnt]->tile_idx = core->tile_idx;
+        xeve_init_core_mt(ctx, core->tile_idx, core, thread_cnt);
+        ctx->core[thread_cnt]->thread_cnt = thread_cnt;
+    }
+    tile->qp_prev_eco[core->thread_cnt] = ctx->sh->qp;
+    tile->core_base = core->thread_cnt;
+    tile->next_row = 0;
+
+    for (thread_cnt = core->thread_cnt + 1; thread_cnt < core->thread_cnt + tile->parallel_rows; thread_cnt++)
+    {
+        ctx->tc->run(ctx->thread_pool[thread_cnt], xeve_ctu_mt_core, (void*)ctx->core[thread_cnt]);
+    }
+
+    res = xeve_ctu_mt_core(arg);
+    if (XEVE_FAILED(res))
+    {
+        ret = res;
+    }
+
+    for (thread_cnt = core->thread_cnt + 1; thread_cnt < core->thread_cnt + tile->parallel_rows; thread_cnt++)
+    {
+        ctx->tc->join(ctx->thread_pool[thread_cnt], &res);
+        if (XEVE_FAILED(res))
+        {
+            ret = res;
+        }
+    }
+
+    tile->f_ctb = temp_store_total_ctb;
+
+    return ret;
+}
+
 XEVE_CTX * xeve_ctx_alloc(void)
 {
     XEVE_CTX * ctx;
@@ -175,6 +230,10 @@ XEVE_CORE * xeve_core_alloc(int chroma_format_idc)
     xeve_assert_rv(core, NULL);
     xeve_mset_x64a(core, 0, sizeof(XEVE_CORE));
 
+    /* RDO bit counting buffers restart from the same source many times */
+    core->s_temp_run.ckpt_on = 1;
+    core->s_temp_prev_comp_run.ckpt_on = 1;
+
     for (i = 0; i < MAX_CU_LOG2; i++)
     {
         for (j = 0; j < MAX_CU_LOG2; j++)
@@ -296,84 +355,53 @@ int xeve_pic(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
         int res;
         u32 i = 0;
         tc = ctx->tc;
-        int thread_cnt = 0, thread_cnt1 = 0;;
+        int thread_cnt = 0;
         int task_completed = 0;
         int tile_cnt = 0;
 
-        //Code for CTU parallel encoding
+        //Code for tile and CTU parallel encoding
         while (total_tiles_in_slice)
         {
-            //Limiting parallel task to the number of LCU rows
-            i = tiles_in_slice[tile_cnt++];
-            int temp_store_total_ctb = ctx->tile[i].f_ctb;
-            int parallel_task = (ctx->param.threads > ctx->tile[i].h_ctb) ? ctx->tile[i].h_ctb : ctx->param.threads;
-            ctx->parallel_rows = parallel_task;
-            ctx->tile[i].qp = ctx->sh->qp;
+            /* independent tiles are encoded concurrently and the threads left
+               over are shared out among them for the CTU rows of each tile */
+            int tile_task = (ctx->param.threads > total_tiles_in_slice) ? total_tiles_in_slice : ctx->param.threads;
+            int rows_per_tile = ctx->param.threads / tile_task;
 
-            for (thread_cnt = 1; (thread_cnt < parallel_task); thread_cnt++)
+            for (tile_cnt = tile_task - 1; tile_cnt >= 0; tile_cnt--)
             {
-                ctx->tile[i].qp_prev_eco[thread_cnt] = ctx->sh->qp;
+                i = tiles_in_slice[task_completed + tile_cnt];
+                thread_cnt = tile_cnt * rows_per_tile;
+
+                ctx->tile[i].qp = ctx->sh->qp;
+                ctx->tile[i].parallel_rows = (rows_per_tile > ctx->tile[i].h_ctb) ? ctx->tile[i].h_ctb : rows_per_tile;
                 ctx->core[thread_cnt]->tile_idx = i;
-                ctx->core[thread_cnt]->x_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);               //entry point lcu's x location
-                ctx->core[thread_cnt]->y_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu) + thread_cnt; // entry point lcu's y location
-                ctx->core[thread_cnt]->lcu_num = thread_cnt*ctx->tile[i].w_ctb;
                 xeve_init_core_mt(ctx, i, core, thread_cnt);
-
                 ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-                tc->run(ctx->thread_pool[thread_cnt], xeve_ctu_mt_core, (void*)ctx->core[thread_cnt]);
-            }
 
-            ctx->tile[i].qp = ctx->sh->qp;
-            ctx->tile[i].qp_prev_eco[0] = ctx->sh->qp;
-            ctx->core[0]->tile_idx = i;
-            ctx->core[0]->lcu_num = 0;
-
-            xeve_init_core_mt(ctx, i, core, 0);
-
-            ctx->core[0]->thread_cnt = 0;
-            xeve_ctu_mt_core((void*)ctx->core[0]);
-
-             for (thread_cnt1 = 1; thread_cnt1 < parallel_task; thread_cnt1++)
-            {
-                tc->join(ctx->thread_pool[thread_cnt1], &res);
-                if (XEVE_FAILED(res))
+                if (tile_cnt > 0)
                 {
-                    ret = res;
+                    tc->run(ctx->thread_pool[thread_cnt], xeve_tile_mt_core, (void*)ctx->core[thread_cnt]);
                 }
             }
 
-            ctx->tile[i].f_ctb = temp_store_total_ctb;
-
+            res = xeve_tile_mt_core((void*)ctx->core[0]);
+            if (XEVE_FAILED(res))
+            {
+                ret = res;
+            }
 
-            /*Set entry point for each Tile in the tile Slice*/
-            ctx->core[0]->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu; //entry point lcu's x location
-            ctx->core[0]->y_lcu = (ctx->tile[i].ctba_rs_first) / ctx->w_lcu; // entry point lcu's y location
-            ctb_cnt_in_tile = ctx->tile[i].f_ctb; //Total LCUs in the current tile
-            xeve_update_core_loc_param(ctx, ctx->core[0]);
-            ctx->lcu_cnt = ctx->f_lcu;
-            while (1)
+            for (tile_cnt = 1; tile_cnt < tile_task; tile_cnt++)
             {
-                /* entropy coding ************************************************/
-                ret = xeve_eco_tree(ctx, ctx->core[0], ctx->core[0]->x_pel, ctx->core[0]->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0
-                                  , 0, xeve_get_default_tree_cons(), &ctx->bs[0]);
-                /* prepare next step *********************************************/
-                ctx->core[0]->x_lcu++;
-                if (ctx->core[0]->x_lcu >= ctx->tile[i].w_ctb + col_bd)
-                {
-                    ctx->core[0]->x_lcu = (ctx->tile[i].ctba_rs_first) % ctx->w_lcu;
-                    ctx->core[0]->y_lcu++;
-                }
-                xeve_update_core_loc_param(ctx, ctx->core[0]);
-                ctb_cnt_in_tile--;
-                ctx->lcu_cnt--;
-                if (ctb_cnt_in_tile == 0)
+                tc->join(ctx->thread_pool[tile_cnt * rows_per_tile], &res);
+                if (XEVE_FAILED(res))
                 {
-                    xeve_eco_tile_end_flag(bs, 1);
-                    xeve_sbac_finish(bs);
-                    break;
+                    ret = res;
                 }
             }
-            total_tiles_in_slice -= 1;
+            xeve_assert_rv(ret == XEVE_OK, ret);
+
+            total_tiles_in_slice -= tile_task;
+            task_completed += tile_task;
         }
 
         ctx->sh->qp_prev_eco = ctx->sh->qp;
@@ -609,23 +637,75 @@ int xeve_enc(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
 }
 
 
+static int push_frm_ingest_band(void * arg)
+{
+    XEVE_INGEST_BAND * band = (XEVE_INGEST_BAND *)arg;
+    XEVE_CTX         * ctx = band->ctx;
+    XEVE_PICO        * pico = ctx->pico;
+    XEVE_PIC         * spic = pico->spic;
+
+    xeve_imgb_ingest_rows(pico->pic.imgb, band->src, band->row_start, band->row_end,
+                          (spic != NULL) ? spic->y : NULL, (spic != NULL) ? spic->s_l : 0,
+                          (pico->sinfo.map_aq_var[0] != NULL) ? pico->sinfo.map_aq_var : NULL);
+    return XEVE_OK;
+}
+
+/* copy the pushed image, generate the sub-picture and take the AQ block
+   variances in one pass, in bands of rows on the encoder threads. bands
+   start on AQ block rows of the chroma planes too */
+static void push_frm_ingest(XEVE_CTX * ctx, XEVE_IMGB * src)
+{
+    int unit = 1 << (LOG2_AQ_BLK_SIZE + 1);
+    int units = (ctx->h + unit - 1) / unit;
+    int band_cnt = XEVE_MAX(1, XEVE_MIN(ctx->param.threads, units));
+    int i, res;
+
+    for (i = 0; i < band_cnt; i++)
+    {
+        ctx->ingest_band[i].ctx = ctx;
+        ctx->ingest_band[i].src = src;
+        ctx->ingest_band[i].row_start = ((units * i) / band_cnt) * unit;
+        ctx->ingest_band[i].row_end = ((units * (i + 1)) / band_cnt) * unit;
+    }
+    for (i = 1; i < band_cnt; i++)
+    {
+        ctx->tc->run(ctx->thread_pool[i], push_frm_ingest_band, (void*)&ctx->ingest_band[i]);
+    }
+    push_frm_ingest_band((void*)&ctx->ingest_band[0]);
+    for (i = 1; i < band_cnt; i++)
+    {
+        ctx->tc->join(ctx->thread_pool[i], &res);
+    }
+}
+
 int xeve_push_frm(XEVE_CTX * ctx, XEVE_IMGB * img)
 {
     XEVE_PIC  * pic;
     XEVE_PICO * pico;
     XEVE_IMGB * imgb;
 
-    int ret;
+    int ret, fused;
 
     ret = ctx->fn_get_inbuf(ctx, &imgb);
     xeve_assert_rv(XEVE_OK == ret, ret);
 
     imgb->cs = ctx->param.cs;
-    xeve_imgb_cpy(imgb, img);
 
-    if (ctx->fn_pic_flt != NULL)
+    /* a filtered input or a conversion the ingest kernels do not cover is
+       copied first and then scanned in place */
+    fused = ctx->fn_pic_flt == NULL && xeve_imgb_ingest_check(imgb, img);
+    if (fused)
+    {
+        xeve_imgb_cpy_info(imgb, img);
+    }
+    else
     {
-        ctx->fn_pic_flt(ctx, imgb);
+        xeve_imgb_cpy(imgb, img);
+
+        if (ctx->fn_pic_flt != NULL)
+        {
+            ctx->fn_pic_flt(ctx, imgb);
+        }
     }
 
     ctx->pic_icnt++;
@@ -658,11 +738,14 @@ int xeve_push_frm(XEVE_CTX * ctx, XEVE_IMGB * img)
     pic->s_c = STRIDE_IMGB2PIC(imgb->s[1]);
 
     pic->imgb = imgb;
-    /* generate sub-picture for RC and Forecast */
+    /* the sub-picture for RC and Forecast is generated on ingest */
+    if (fused || ctx->param.use_fcst)
+    {
+        push_frm_ingest(ctx, fused ? img : NULL);
+    }
     if (ctx->param.use_fcst)
     {
         XEVE_PIC* spic = pico->spic;
-        xeve_gen_subpic(pic->y, spic->y, spic->w_l, spic->h_l, pic->s_l, spic->s_l, 10);
 
         xeve_mset(pico->sinfo.map_pdir, 0, sizeof(u8) * ctx->fcst.f_blk);
         xeve_mset(pico->sinfo.map_pdir_bi, 0, sizeof(u8) * ctx->fcst.f_blk);
@@ -675,6 +758,7 @@ int xeve_push_frm(XEVE_CTX * ctx, XEVE_IMGB * img)
         xeve_mset(pico->sinfo.map_qp_scu, 0, sizeof(s8) * ctx->f_scu);
         xeve_mset(pico->sinfo.transfer_cost, 0, sizeof(u16) * ctx->fcst.f_blk);
         xeve_picbuf_expand(spic, spic->pad_l, spic->pad_c, ctx->sps.chroma_format_idc);
+        xeve_fcst_gen_pyramid(ctx, pico);
     }
 
     if (ctx->ts.frame_delay > 0)
@@ -701,6 +785,7 @@ void xeve_platform_init_func(XEVE_CTX * ctx)
   if(1)
   {
         xeve_func_sad               = xeve_tbl_sad_16b_neon;
+        xeve_func_sad_8b            = xeve_tbl_sad_8b_neon;
         xeve_func_ssd               = xeve_tbl_ssd_16b_neon;
         xeve_func_diff              = xeve_tbl_diff_16b_neon;
         xeve_func_satd              = xeve_tbl_satd_16b_neon;
@@ -709,6 +794,9 @@ void xeve_platform_init_func(XEVE_CTX * ctx)
         xeve_func_average_no_clip   = &xeve_average_16b_no_clip_neon;
         ctx->fn_itxb                = &xeve_tbl_itxb_neon;
         xeve_func_txb               = &xeve_tbl_txb_neon;
+        xeve_func_ingest            = xeve_ingest_neon;
+        xeve_func_sse               = xeve_sse_neon;
+        xeve_func_ssim_4x4          = xeve_ssim_4x4_neon;
   }
   else
 #elif X86_SSE
@@ -721,18 +809,23 @@ void xeve_platform_init_func(XEVE_CTX * ctx)
     if (support_avx2)
     {
         xeve_func_sad               = xeve_tbl_sad_16b_avx;
-        xeve_func_ssd               = xeve_tbl_ssd_16b_sse;
-        xeve_func_diff              = xeve_tbl_diff_16b_sse;
-        xeve_func_satd              = xeve_tbl_satd_16b_sse;
+        xeve_func_sad_8b            = xeve_tbl_sad_8b_avx;
+        xeve_func_ssd               = xeve_tbl_ssd_16b_avx;
+        xeve_func_diff              = xeve_tbl_diff_16b_avx;
+        xeve_func_satd              = xeve_tbl_satd_16b_avx;
         xeve_func_mc_l              = xeve_tbl_mc_l_avx;
         xeve_func_mc_c              = xeve_tbl_mc_c_avx;
         xeve_func_average_no_clip   = &xeve_average_16b_no_clip_sse;
         ctx->fn_itxb                = &xeve_tbl_itxb_avx;
         xeve_func_txb               = &xeve_tbl_txb_avx;
+        xeve_func_ingest            = xeve_ingest_avx;
+        xeve_func_sse               = xeve_sse_avx;
+        xeve_func_ssim_4x4          = xeve_ssim_4x4_sse;
     }
     else if (support_sse)
     {
         xeve_func_sad               = xeve_tbl_sad_16b_sse;
+        xeve_func_sad_8b            = xeve_tbl_sad_8b_sse;
         xeve_func_ssd               = xeve_tbl_ssd_16b_sse;
         xeve_func_diff              = xeve_tbl_diff_16b_sse;
         xeve_func_satd              = xeve_tbl_satd_16b_sse;
@@ -741,11 +834,15 @@ void xeve_platform_init_func(XEVE_CTX * ctx)
         xeve_func_average_no_clip   = &xeve_average_16b_no_clip_sse;
         ctx->fn_itxb                = &xeve_tbl_itxb_sse;
         xeve_func_txb               = &xeve_tbl_txb; /*to be updated*/
+        xeve_func_ingest            = xeve_ingest_sse;
+        xeve_func_sse               = xeve_sse_sse;
+        xeve_func_ssim_4x4          = xeve_ssim_4x4_sse;
     }
     else
 #endif
     {
         xeve_func_sad               = xeve_tbl_sad_16b;
+        xeve_func_sad_8b            = xeve_tbl_sad_8b;
         xeve_func_ssd               = xeve_tbl_ssd_16b;
         xeve_func_diff              = xeve_tbl_diff_16b;
         xeve_func_satd              = xeve_tbl_satd_16b;
@@ -754,13 +851,105 @@ void xeve_platform_init_func(XEVE_CTX * ctx)
         xeve_func_average_no_clip   = &xeve_average_16b_no_clip;
         ctx->fn_itxb                = &xeve_tbl_itxb;
         xeve_func_txb               = &xeve_tbl_txb;
+        xeve_func_ingest            = xeve_ingest;
+        xeve_func_sse               = xeve_sse;
+        xeve_func_ssim_4x4          = xeve_ssim_4x4;
+    }
+}
+
+static int xeve_affinity_init(XEVE_CTX * ctx)
+{
+    THREAD_AFFINITY * aff = &ctx->affinity;
+    THREAD_AFFINITY   node;
+
+    xeve_mset(aff, 0, sizeof(THREAD_AFFINITY));
+    xeve_mset(&ctx->affinity_org, 0, sizeof(THREAD_AFFINITY));
+    if (ctx->param.cpu_set[0] == 0 && ctx->param.numa_node < 0)
+    {
+        return XEVE_OK;
     }
+
+    if (ctx->param.cpu_set[0])
+    {
+        xeve_assert_rv(parse_thread_affinity(ctx->param.cpu_set, aff) == THREAD_SUCCESS, XEVE_ERR_INVALID_ARGUMENT);
+    }
+    if (ctx->param.numa_node >= 0)
+    {
+        xeve_assert_rv(get_numa_node_affinity(ctx->param.numa_node, &node) == THREAD_SUCCESS, XEVE_ERR_INVALID_ARGUMENT);
+        if (ctx->param.cpu_set[0])
+        {
+            /* restrict the CPU set to the node */
+            aff->cpu_cnt = 0;
+            for (int i = 0; i < THREAD_MAX_CPU; i++)
+            {
+                if ((aff->cpu_mask[i >> 6] >> (i & 63)) & 1)
+                {
+                    if ((node.cpu_mask[i >> 6] >> (i & 63)) & 1)
+                    {
+                        aff->cpu_cnt++;
+                    }
+                    else
+                    {
+                        aff->cpu_mask[i >> 6] &= ~(1ULL << (i & 63));
+                    }
+                }
+            }
+        }
+        else
+        {
+            *aff = node;
+        }
+    }
+    xeve_assert_rv(aff->cpu_cnt > 0, XEVE_ERR_INVALID_ARGUMENT);
+
+    /* the creating thread encodes with core 0 and first-touches the picture
+       buffers, so it is pinned as well to keep memory local to the CPU set */
+    xeve_assert_rv(get_thread_affinity(&ctx->affinity_org) == THREAD_SUCCESS, XEVE_ERR_UNKNOWN);
+    if (set_thread_affinity(aff) != THREAD_SUCCESS)
+    {
+        xeve_mset(&ctx->affinity_org, 0, sizeof(THREAD_AFFINITY));
+        xeve_trace("cannot set CPU affinity\n");
+        return XEVE_ERR_UNSUPPORTED;
+    }
+    return XEVE_OK;
+}
+
+XEVE_POOL xeve_pool_alloc(int threads, const char * cpu_set, int * err)
+{
+    THREAD_AFFINITY aff;
+    THREAD_POOL   * pool = NULL;
+    int             ret = XEVE_OK;
+
+    xeve_mset(&aff, 0, sizeof(THREAD_AFFINITY));
+    xeve_assert_gv(threads >= 1 && threads <= THREAD_MAX_CPU, ret, XEVE_ERR_INVALID_ARGUMENT, ERR);
+    if (cpu_set != NULL && cpu_set[0])
+    {
+        xeve_assert_gv(parse_thread_affinity(cpu_set, &aff) == THREAD_SUCCESS, ret, XEVE_ERR_INVALID_ARGUMENT, ERR);
+    }
+    pool = create_thread_pool(threads, &aff);
+    xeve_assert_gv(pool != NULL, ret, XEVE_ERR_UNKNOWN, ERR);
+ERR:
+    if (err) *err = ret;
+    return (XEVE_POOL)pool;
+}
+
+int xeve_pool_free(XEVE_POOL pool)
+{
+    THREAD_POOL * p = (THREAD_POOL *)pool;
+
+    xeve_assert_rv(p != NULL, XEVE_ERR_INVALID_ARGUMENT);
+    /* encoders still attached would be left without threads */
+    xeve_assert_rv(release_thread_pool(&p) == THREAD_SUCCESS, XEVE_ERR_UNEXPECTED);
+    return XEVE_OK;
 }
 
 int xeve_platform_init(XEVE_CTX * ctx)
 {
     int ret = XEVE_ERR_UNKNOWN;
 
+    ret = xeve_affinity_init(ctx);
+    xeve_assert_rv(XEVE_OK == ret, ret);
+
     /* create mode decision */
     ret = xeve_mode_create(ctx, 0);
     xeve_assert_rv(XEVE_OK == ret, ret);
@@ -819,6 +1008,11 @@ void xeve_platform_deinit(XEVE_CTX * ctx)
 {
     xeve_assert(ctx->pf == NULL);
 
+    if (ctx->affinity.cpu_cnt > 0)
+    {
+        set_thread_affinity(&ctx->affinity_org);
+    }
+
     ctx->fn_ready = NULL;
     ctx->fn_flush = NULL;
     ctx->fn_enc = NULL;
@@ -1074,8 +1268,9 @@ static void decide_slice_type(XEVE_CTX * ctx)
     int force_cnt = 0;
     int ip_pic_cnt, is_aligned_gop;
 
-    ip_pic_cnt = ctx->param.closed_gop && ctx->param.keyint > 0 ? ctx->pic_cnt % ctx->param.keyint : ctx->pic_cnt;
-    i_period = ctx->param.keyint;
+    /* intra refresh replaces the periodic I pictures */
+    i_period = ctx->param.intra_refresh ? 0 : ctx->param.keyint;
+    ip_pic_cnt = ctx->param.closed_gop && i_period > 0 ? ctx->pic_cnt % i_period : ctx->pic_cnt;
     gop_size = ctx->param.gop_size;
     pic_icnt = (ip_pic_cnt + ctx->param.bframes);
     pic_imcnt = pic_icnt;
@@ -1193,6 +1388,48 @@ static void decide_slice_type(XEVE_CTX * ctx)
     }
 }
 
+static void decide_intra_refresh(XEVE_CTX * ctx)
+{
+    XEVE_PIC * pic = PIC_CURR(ctx);
+    int        period, pos;
+
+    ctx->ir_col_beg = ctx->ir_col_end = 0;
+
+    if (ctx->slice_type == SLICE_I)
+    {
+        ctx->ir_poc_beg = ctx->poc.poc_val;
+        pic->ir_clean_w = ctx->w;
+        return;
+    }
+    if (!ctx->param.intra_refresh)
+    {
+        pic->ir_clean_w = ctx->w;
+        return;
+    }
+
+    /* the refresh column moves from left to right by one step per picture;
+       a picture narrower than the period is refreshed one CTU column at a time */
+    period = ctx->param.keyint > 0 ? XEVE_MIN(ctx->param.keyint, ctx->w_lcu) : ctx->w_lcu;
+    pos = (ctx->poc.poc_val - 1) % period;
+    if (pos == 0)
+    {
+        ctx->ir_poc_beg = ctx->poc.poc_val;
+    }
+    ctx->ir_col_beg = pos * ctx->w_lcu / period;
+    ctx->ir_col_end = (pos + 1) * ctx->w_lcu / period;
+
+    /* deblocking of the right edge of the column reads the area not
+       refreshed yet, which leaves 3 samples on its left side unclean */
+    if (ctx->ir_col_end >= ctx->w_lcu)
+    {
+        pic->ir_clean_w = ctx->w;
+    }
+    else
+    {
+        pic->ir_clean_w = XEVE_MAX(0, (ctx->ir_col_end << ctx->log2_max_cuwh) - 4);
+    }
+}
+
 int xeve_pic_prepare(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
 {
     int             ret;
@@ -1204,6 +1441,7 @@ int xeve_pic_prepare(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
 
     PIC_CURR(ctx) = xeve_picman_get_empty_pic(&ctx->rpm, &ret);
     xeve_assert_rv(PIC_CURR(ctx) != NULL, ret);
+    xeve_pic_progress_reset(PIC_CURR(ctx));
     ctx->map_refi = PIC_CURR(ctx)->map_refi;
     ctx->map_mv = PIC_CURR(ctx)->map_mv;
     ctx->map_unrefined_mv = PIC_CURR(ctx)->map_unrefined_mv;
@@ -1217,11 +1455,12 @@ int xeve_pic_prepare(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
     }
 
     decide_slice_type(ctx);
+    decide_intra_refresh(ctx);
 
     ctx->lcu_cnt = ctx->f_lcu;
     ctx->slice_num = 0;
 
-    if (ctx->tile_cnt == 1 && ctx->param.threads > 1)
+    if (ctx->param.threads > 1)
     {
         for (u32 i = 0; i < ctx->f_lcu; i++)
         {
@@ -1251,6 +1490,7 @@ int xeve_pic_prepare(XEVE_CTX * ctx, XEVE_BITB * bitb, XEVE_STAT * stat)
     xeve_mset_x64a(ctx->map_cu_mode, 0, sizeof(u32) * ctx->f_scu);
 
     xeve_set_active_pps_info(ctx);
+    xeve_pass_pic_prepare(ctx);
     if (ctx->param.rc_type != 0)
     {
         ctx->qp = xeve_rc_get_qp(ctx);
@@ -1267,6 +1507,13 @@ int xeve_pic_finish(XEVE_CTX *ctx, XEVE_BITB *bitb, XEVE_STAT *stat)
 
     xeve_mset(stat, 0, sizeof(XEVE_STAT));
 
+    /* all rows are reconstructed and filtered, expand current encoding picture, if needs.
+       rows_padded advances as the rows are padded, and the picture signature
+       is computed alongside */
+    threadsafe_assign(&PIC_CURR(ctx)->rows_recon, ctx->h_lcu);
+    threadsafe_assign(&PIC_CURR(ctx)->rows_filtered, ctx->h_lcu);
+    ctx->fn_picbuf_expand(ctx, PIC_CURR(ctx));
+
     /* adding picture sign */
     if (ctx->param.use_pic_sign)
     {
@@ -1287,9 +1534,6 @@ int xeve_pic_finish(XEVE_CTX *ctx, XEVE_BITB *bitb, XEVE_STAT *stat)
         xeve_eco_nal_unit_len(size_field, stat->sei_size - 4);
     }
 
-    /* expand current encoding picture, if needs */
-    ctx->fn_picbuf_expand(ctx, PIC_CURR(ctx));
-
     /* picture buffer management */
     ret = xeve_picman_put_pic(&ctx->rpm, PIC_CURR(ctx), ctx->nalu.nal_unit_type_plus1 - 1 == XEVE_IDR_NUT,
                               ctx->poc.poc_val, ctx->nalu.nuh_temporal_id, 0, ctx->refp,
@@ -1321,6 +1565,33 @@ int xeve_pic_finish(XEVE_CTX *ctx, XEVE_BITB *bitb, XEVE_STAT *stat)
         }
     }
 
+    /* quality metrics were measured while the picture was padded */
+    if (ctx->param.calc_metrics && !ctx->param.tool_dra)
+    {
+        int    w_shift = XEVE_GET_CHROMA_W_SHIFT(ctx->sps.chroma_format_idc);
+        int    h_shift = XEVE_GET_CHROMA_H_SHIFT(ctx->sps.chroma_format_idc);
+        double peak, area;
+
+        for (i = 0; i < (ctx->sps.chroma_format_idc ? N_C : 1); i++)
+        {
+            peak = (double)(255 << (i ? ctx->sps.bit_depth_chroma_minus8 : ctx->sps.bit_depth_luma_minus8));
+            area = i ? (double)((ctx->param.w + w_shift) >> w_shift) * ((ctx->param.h + h_shift) >> h_shift) : (double)ctx->param.w * ctx->param.h;
+            stat->sse[i] = (double)ctx->metric_sse[i];
+            stat->psnr[i] = ctx->metric_sse[i] == 0 ? 100 : 10 * log10(peak * peak * area / stat->sse[i]);
+        }
+        stat->ssim = ctx->param.calc_metrics == 2 ? ctx->metric_ssim : 0;
+    }
+
+    for(i = 0; i < ctx->param.threads; i++)
+    {
+        stat->split_cand += ctx->core[i]->fsplit_cand;
+        stat->split_pruned += ctx->core[i]->fsplit_pruned;
+        stat->static_cu += ctx->core[i]->static_cu;
+        ctx->core[i]->fsplit_cand = 0;
+        ctx->core[i]->fsplit_pruned = 0;
+        ctx->core[i]->static_cu = 0;
+    }
+
     imgb_c->ts[XEVE_TS_PTS] = bitb->ts[XEVE_TS_PTS] = imgb_o->ts[XEVE_TS_PTS];
     if (ctx->ts.frame_delay > 0)
     {
@@ -1347,6 +1618,9 @@ int xeve_pic_finish(XEVE_CTX *ctx, XEVE_BITB *bitb, XEVE_STAT *stat)
         ctx->rcore->real_bits = (stat->write - stat->sei_size) << 3;
     }
 
+    ret = xeve_pass_pic_finish(ctx, stat);
+    xeve_assert_rv(ret == XEVE_OK, ret);
+
     imgb_o->release(imgb_o);
     return XEVE_OK;
 }
@@ -1468,7 +1742,7 @@ void xeve_set_pps(XEVE_CTX * ctx, XEVE_PPS * pps)
 {
     pps->loop_filter_across_tiles_enabled_flag = 0;
     pps->single_tile_in_pic_flag = 1;
-    pps->constrained_intra_pred_flag = ctx->param.constrained_intra_pred;
+    pps->constrained_intra_pred_flag = ctx->param.constrained_intra_pred || ctx->param.intra_refresh;
     pps->cu_qp_delta_enabled_flag = (ctx->param.aq_mode || ctx->param.cutree);
 
     pps->num_ref_idx_default_active_minus1[REFP_0] = 0;
@@ -1562,7 +1836,7 @@ int xeve_set_tile_info(XEVE_CTX * ctx)
 int xeve_ready(XEVE_CTX* ctx)
 {
     XEVE_CORE* core = NULL;
-    int          w, h, ret, i, f_blk;
+    int          w, h, ret, i, j, f_blk;
     s32          size;
     XEVE_FCST* fcst = &ctx->fcst;
 
@@ -1635,7 +1909,17 @@ int xeve_ready(XEVE_CTX* ctx)
     if (ctx->param.threads >= 1)
     {
         ctx->tc = xeve_malloc(sizeof(THREAD_CONTROLLER));
-        init_thread_controller(ctx->tc, ctx->param.threads);
+        if (ctx->pool)
+        {
+            /* the threads and their affinity are those of the shared pool */
+            ret = init_shared_thread_controller(ctx->tc, ctx->pool, ctx->param.threads);
+            xeve_assert_gv(ret == THREAD_SUCCESS, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+        }
+        else
+        {
+            init_thread_controller(ctx->tc, ctx->param.threads);
+            ctx->tc->affinity = ctx->affinity;
+        }
         for (int i = 0; i < ctx->param.threads; i++)
         {
             ctx->thread_pool[i] = ctx->tc->create(ctx->tc, i);
@@ -1737,6 +2021,15 @@ int xeve_ready(XEVE_CTX* ctx)
         fcst->w_blk = (ctx->w/2 + (((1 << (fcst->log2_fcst_blk_spic + 1)) - 1))) >> (fcst->log2_fcst_blk_spic + 1);
         fcst->h_blk = (ctx->h/2 + (((1 << (fcst->log2_fcst_blk_spic + 1)) - 1))) >> (fcst->log2_fcst_blk_spic + 1);
         fcst->f_blk = fcst->w_blk * fcst->h_blk;
+
+        /* levels above the cost level only seed the motion search, so they
+           are built while they keep enough samples to track motion */
+        fcst->lvl = ctx->param.fcst_level + 1;
+        fcst->lvl_top = fcst->lvl;
+        while (fcst->lvl_top < XEVE_FCST_LVL_MAX && (ctx->w >> (fcst->lvl_top + 1)) >= FCST_PYR_MIN_W)
+        {
+            fcst->lvl_top++;
+        }
     }
 
     for (i = 0; i < ctx->pico_max_cnt; i++)
@@ -1749,6 +2042,12 @@ int xeve_ready(XEVE_CTX* ctx)
         {
             ctx->pico_buf[i]->spic = xeve_alloc_spic_l(ctx->w, ctx->h);
             xeve_assert_g(ctx->pico_buf[i]->spic != NULL, ERR);
+            ctx->pico_buf[i]->spic_pyr[0] = ctx->pico_buf[i]->spic;
+            for (j = 1; j < ctx->fcst.lvl_top; j++)
+            {
+                ctx->pico_buf[i]->spic_pyr[j] = xeve_alloc_spic_l(ctx->w >> j, ctx->h >> j);
+                xeve_assert_g(ctx->pico_buf[i]->spic_pyr[j] != NULL, ERR);
+            }
 
             f_blk = ctx->fcst.f_blk;
             size = sizeof(u8) * f_blk;
@@ -1790,6 +2089,20 @@ int xeve_ready(XEVE_CTX* ctx)
             size = sizeof(u16) * f_blk;
             ctx->pico_buf[i]->sinfo.transfer_cost = xeve_malloc(size);
             xeve_assert_gv(ctx->pico_buf[i]->sinfo.transfer_cost, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
+            if (ctx->param.aq_mode)
+            {
+                int w_blk_l = ctx->w >> LOG2_AQ_BLK_SIZE;
+                int h_blk_l = ctx->h >> LOG2_AQ_BLK_SIZE;
+                int w_blk_c = (ctx->w >> ctx->param.cs_w_shift) >> LOG2_AQ_BLK_SIZE;
+                int h_blk_c = (ctx->h >> ctx->param.cs_h_shift) >> LOG2_AQ_BLK_SIZE;
+
+                size = sizeof(u64) * (w_blk_l * h_blk_l + 2 * w_blk_c * h_blk_c);
+                ctx->pico_buf[i]->sinfo.map_aq_var[0] = xeve_malloc(size);
+                xeve_assert_gv(ctx->pico_buf[i]->sinfo.map_aq_var[0], ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+                ctx->pico_buf[i]->sinfo.map_aq_var[1] = ctx->pico_buf[i]->sinfo.map_aq_var[0] + w_blk_l * h_blk_l;
+                ctx->pico_buf[i]->sinfo.map_aq_var[2] = ctx->pico_buf[i]->sinfo.map_aq_var[1] + w_blk_c * h_blk_c;
+            }
         }
     }
 
@@ -1811,6 +2124,9 @@ int xeve_ready(XEVE_CTX* ctx)
         }
     }
 
+    ret = xeve_pass_create(ctx);
+    xeve_assert_g(ret == XEVE_OK, ERR);
+
     ctx->sh_array = (XEVE_SH*)xeve_malloc(sizeof(XEVE_SH) * ctx->ts_info.num_slice_in_pic);
     xeve_assert_gv(ctx->sh_array, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
     xeve_mset(ctx->sh_array, 0, sizeof(XEVE_SH) * ctx->ts_info.num_slice_in_pic);
@@ -1831,6 +2147,7 @@ ERR:
     xeve_mfree_fast(ctx->map_cu_mode);
     xeve_mfree_fast(ctx->sh_array);
     xeve_mfree(ctx->tile);
+    ctx->tile = NULL;
 
     //free the threadpool and created thread if any
     if (ctx->sync_block)
@@ -1859,7 +2176,9 @@ ERR:
         }
     }
     xeve_mfree_fast(ctx->map_tidx);
+    ctx->map_tidx = NULL;
     xeve_mfree_fast((void*)ctx->sync_flag);
+    ctx->sync_flag = NULL;
 
     for (i = 0; i < ctx->pico_max_cnt; i++)
     {
@@ -1875,8 +2194,15 @@ ERR:
             xeve_mfree_fast(ctx->pico_buf[i]->sinfo.map_qp_blk);
             xeve_mfree_fast(ctx->pico_buf[i]->sinfo.map_qp_scu);
             xeve_mfree_fast(ctx->pico_buf[i]->sinfo.transfer_cost);
+            xeve_mfree(ctx->pico_buf[i]->sinfo.map_aq_var[0]);
             if (ctx->pico_buf[i] != NULL)
+            {
                 xeve_picbuf_rc_free(ctx->pico_buf[i]->spic);
+                for (j = 1; j < XEVE_FCST_LVL_MAX; j++)
+                {
+                    xeve_picbuf_rc_free(ctx->pico_buf[i]->spic_pyr[j]);
+                }
+            }
         }
 
         xeve_mfree_fast(ctx->pico_buf[i]);
@@ -1891,13 +2217,14 @@ ERR:
     {
         xeve_rc_delete(ctx);
     }
+    xeve_pass_delete(ctx);
 
     return ret;
 }
 
 void xeve_flush(XEVE_CTX * ctx)
 {
-    int i;
+    int i, j;
     xeve_assert(ctx);
 
     xeve_mfree_fast(ctx->map_scu);
@@ -1963,7 +2290,12 @@ void xeve_flush(XEVE_CTX * ctx)
             xeve_mfree_fast(ctx->pico_buf[i]->sinfo.map_qp_blk);
             xeve_mfree_fast(ctx->pico_buf[i]->sinfo.map_qp_scu);
             xeve_mfree_fast(ctx->pico_buf[i]->sinfo.transfer_cost);
+            xeve_mfree(ctx->pico_buf[i]->sinfo.map_aq_var[0]);
             xeve_picbuf_rc_free(ctx->pico_buf[i]->spic);
+            for (j = 1; j < XEVE_FCST_LVL_MAX; j++)
+            {
+                xeve_picbuf_rc_free(ctx->pico_buf[i]->spic_pyr[j]);
+            }
         }
         xeve_mfree_fast(ctx->pico_buf[i]);
     }
@@ -1978,6 +2310,7 @@ void xeve_flush(XEVE_CTX * ctx)
     {
         xeve_rc_delete(ctx);
     }
+    xeve_pass_delete(ctx);
 }
 
 int xeve_picbuf_get_inbuf(XEVE_CTX * ctx, XEVE_IMGB ** imgb)
@@ -2281,6 +2614,9 @@ int xeve_set_init_param(XEVE_CTX * ctx, XEVE_PARAM * param)
     xeve_assert_rv(param->qp >= MIN_QUANT && param->qp <= MAX_QUANT, XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(param->keyint >= 0 ,XEVE_ERR_INVALID_ARGUMENT);
     xeve_assert_rv(param->threads <= XEVE_MAX_THREADS ,XEVE_ERR_INVALID_ARGUMENT);
+    /* pushed pictures are labelled with the colour space of the parameters,
+       so that it has to carry the codec bit depth */
+    xeve_assert_rv(param->codec_bit_depth >= 8 && XEVE_CS_GET_BIT_DEPTH(param->cs) == param->codec_bit_depth, XEVE_ERR_INVALID_ARGUMENT);
 
     if(param->disable_hgop == 0)
     {
@@ -2374,7 +2710,10 @@ int xeve_param_init(XEVE_PARAM* param)
     param->lookahead                  = 17;
     param->use_deblock                = 1;
     param->threads                    = 1;
+    param->numa_node                  = -1;
     param->rdo_dbk_switch             = 1;
+    param->mc_cache                   = 1;
+    param->ipd_presel                 = -1;
     param->tile_rows                  = 1;
     param->tile_columns               = 1;
     param->num_slice_in_pic           = 1;
@@ -2395,6 +2734,7 @@ int xeve_param_init(XEVE_PARAM* param)
     param->max_dec_pic_buffering      = 21;
     param->num_reorder_pics           = 21;
     param->level_idc                  = 40;
+    xeve_mcpy(param->stats_file, "xeve_2pass.stats", sizeof("xeve_2pass.stats"));
     return XEVE_OK;
 }
 
@@ -64,6 +64,8 @@ int  xeve_picbuf_get_inbuf(XEVE_CTX * ctx, XEVE_IMGB ** img);
 
 
 void xeve_platform_init_func(XEVE_CTX * ctx);
+XEVE_POOL xeve_pool_alloc(int threads, const char * cpu_set, int * err);
+int  xeve_pool_free(XEVE_POOL pool);
 int  xeve_platform_init(XEVE_CTX * ctx);
 int  xeve_create_bs_buf(XEVE_CTX  * ctx, int max_bs_buf_size);
 int  xeve_delete_bs_buf(XEVE_CTX  * ctx);
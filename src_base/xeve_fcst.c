@@ -33,6 +33,11 @@
 #include "xeve_fcst.h"
 #include <math.h>
 
+/* log2 size of the forecast block at the cost level of the pyramid */
+#define FCST_LOG2_BLK(ctx)       ((ctx)->fcst.log2_fcst_blk_spic + 2 - (ctx)->fcst.lvl)
+/* costs and motion vectors are kept in the scale of the half size picture */
+#define FCST_LVL_SHIFT(ctx)      ((ctx)->fcst.lvl - 1)
+
 // clang-format off
 
 static const s8 tbl_small_dia_search[4][3] =
@@ -196,35 +201,6 @@ s32 xeve_fcst_get_scene_type(XEVE_CTX * ctx, XEVE_PICO * pico)
     return scene_type;
 }
 
-void xeve_gen_subpic(pel * src_y, pel * dst_y, int w, int h, int s_s,
-    int d_s, int bit_depth)
-{
-    /* source bottom and top top */
-    pel * src_b, * src_t;
-    pel * dst;
-
-    int      x, k, y, shift;
-
-    /* top source */
-    src_t = src_y;
-    /* bottom source */
-    src_b = src_t + s_s;
-    dst   = dst_y;
-    shift = 2; // changed to 2 from 1 to correct the averaging.
-
-    for(y = 0; y < h; y++)
-    {
-        for(x = 0; x < w; x++)
-        {
-            k =  x << 1;
-            dst[x] = (pel)((src_t[k] + src_b[k] + src_t[k+1] + src_b[k+1] + (1<<(shift-1))) >> shift);
-        }
-        src_t += (s_s << 1);
-        src_b += (s_s << 1);
-        dst += d_s;
-    }
-}
-
 static u32 get_aq_blk_sum(void * pic_t, int width, int height,
         int stride)
 {
@@ -296,13 +272,32 @@ u64 get_lcu_var(XEVE_CTX * ctx, void * pic, int log2_w_max, int log2_h_max,
 
 
 
+/* sum of the AQ block variances taken on ingest over a block of the plane */
+static u64 get_lcu_var_map(const u64 * map_var, int w_map, int log2_w_max, int log2_h_max, int x, int y)
+{
+    int i, j, blk_loop_w, blk_loop_h;
+    u64 var = 0;
+
+    blk_loop_w = 1 << (log2_w_max - LOG2_AQ_BLK_SIZE);
+    blk_loop_h = 1 << (log2_h_max - LOG2_AQ_BLK_SIZE);
+    map_var += (y >> LOG2_AQ_BLK_SIZE) * w_map + (x >> LOG2_AQ_BLK_SIZE);
+    for (i = 0; i < blk_loop_h; i++)
+    {
+        for (j = 0; j < blk_loop_w; j++)
+        {
+            var += map_var[j];
+        }
+        map_var += w_map;
+    }
+    return (var >> (log2_w_max - LOG2_AQ_BLK_SIZE));
+}
+
 static void adaptive_quantization(XEVE_CTX * ctx)
 {
     int         blk_size, blk_num, x, y, x_blk, y_blk, log2_cuwh;
     XEVE_FCST * fcst = &ctx->fcst;
     s32       * qp_offset;
     double      vald;
-    int         s_l, s_c;
     u64         var;
     double      aq_bd_const;
     int         w_blk, h_blk, f_blk;
@@ -310,6 +305,9 @@ static void adaptive_quantization(XEVE_CTX * ctx)
     s8          offset_dqp;
     int         w_shift = ctx->param.cs_w_shift;
     int         h_shift = ctx->param.cs_h_shift;
+    u64      ** map_var = ctx->pico->sinfo.map_aq_var;
+    int         w_map_l = ctx->pico->pic.w_l >> LOG2_AQ_BLK_SIZE;
+    int         w_map_c = ctx->pico->pic.w_c >> LOG2_AQ_BLK_SIZE;
 
     blk_num      = 0;
     x_blk        = 0;
@@ -323,8 +321,6 @@ static void adaptive_quantization(XEVE_CTX * ctx)
     f_blk = fcst->f_blk;
 
     aq_bd_const  = (ctx->sps.bit_depth_luma_minus8 + 7.2135) * 2;
-    s_l = ctx->pico->pic.s_l;
-    s_c = ctx->pico->pic.s_c;
 
     while(1)
     {
@@ -337,12 +333,11 @@ static void adaptive_quantization(XEVE_CTX * ctx)
         }
         else
         {
-            var  = get_lcu_var(ctx, ctx->pico->pic.buf_y, log2_cuwh,
-                log2_cuwh, x, y, s_l);
+            var  = get_lcu_var_map(map_var[0], w_map_l, log2_cuwh, log2_cuwh, x, y);
             if(ctx->sps.chroma_format_idc)
             {
-                var += get_lcu_var(ctx, ctx->pico->pic.buf_u, log2_cuwh - w_shift, log2_cuwh - h_shift, (x >> w_shift), (y >> h_shift), s_c);
-                var += get_lcu_var(ctx, ctx->pico->pic.buf_v, log2_cuwh - w_shift, log2_cuwh - h_shift, (x >> w_shift), (y >> h_shift), s_c);
+                var += get_lcu_var_map(map_var[1], w_map_c, log2_cuwh - w_shift, log2_cuwh - h_shift, (x >> w_shift), (y >> h_shift));
+                var += get_lcu_var_map(map_var[2], w_map_c, log2_cuwh - w_shift, log2_cuwh - h_shift, (x >> w_shift), (y >> h_shift));
             }
         }
 
@@ -920,12 +915,12 @@ static s32 xeve_est_intra_cost(XEVE_CTX * ctx, s32 x0, s32 y0)
     s32        cost, cost_best, tot_cost, intra_penalty;
     u8         temp_avil[5] = { 0 };
     pel      * org;
-    XEVE_PIC * spic = ctx->pico->spic;
+    XEVE_PIC * spic = ctx->pico->spic_pyr[ctx->fcst.lvl - 1];
     pel      * pred = ctx->rcore->pred;
     pel        buf_le0[65];
     pel        buf_up0[65 + 1];
 
-    log2_cuwh = ctx->fcst.log2_fcst_blk_spic;  // +  ctx->rc->param->intra_depth;
+    log2_cuwh = FCST_LOG2_BLK(ctx) - 1;  // +  ctx->rc->param->intra_depth;
     cuwh           = 1 << log2_cuwh;
     s_o            = spic->s_l;
     tot_cost       = 0;
@@ -957,7 +952,7 @@ static s32 xeve_est_intra_cost(XEVE_CTX * ctx, s32 x0, s32 y0)
             }
         }
 
-        tot_cost += cost_best + intra_penalty;
+        tot_cost += (cost_best << (FCST_LVL_SHIFT(ctx) << 1)) + intra_penalty;
     }
     return tot_cost;
 }
@@ -1171,6 +1166,48 @@ static s32 fcst_me_ipel(XEVE_PIC * org_pic, XEVE_PIC * ref_pic, s16 * min_mv, s1
     return min_cost;
 }
 
+/* coarse-to-fine search from the top of the pyramid down to the level above
+   the cost level, starting at mvp. each level starts from the doubled result
+   of the level above; returns the starting point for the cost level */
+static void fcst_me_pyr_seed(XEVE_CTX * ctx, XEVE_PICO * pico_cur, XEVE_PICO * pico_ref, s32 x, s32 y
+                             , s32 log2_cuwh, s16 mvp[MV_D], u16 lambda, int bit_depth, s16 seed[MV_D])
+{
+    XEVE_PIC * org, * ref;
+    s16        min_mv[MV_D], max_mv[MV_D], mv[MV_D], mvp_lvl[MV_D], rel[MV_D];
+    s32        lvl, d, x_lvl, y_lvl, log2_lvl;
+
+    d = ctx->fcst.lvl_top - ctx->fcst.lvl;
+    rel[MV_X] = (mvp[MV_X] - (x << 2)) >> d;
+    rel[MV_Y] = (mvp[MV_Y] - (y << 2)) >> d;
+
+    for (lvl = ctx->fcst.lvl_top; lvl > ctx->fcst.lvl; lvl--)
+    {
+        d = lvl - ctx->fcst.lvl;
+        org = pico_cur->spic_pyr[lvl - 1];
+        ref = pico_ref->spic_pyr[lvl - 1];
+        x_lvl = x >> d;
+        y_lvl = y >> d;
+        log2_lvl = log2_cuwh - d;
+
+        if (log2_lvl >= 2 && x_lvl + (1 << log2_lvl) <= org->w_l && y_lvl + (1 << log2_lvl) <= org->h_l)
+        {
+            mv[MV_X] = mvp_lvl[MV_X] = (x_lvl << 2) + rel[MV_X];
+            mv[MV_Y] = mvp_lvl[MV_Y] = (y_lvl << 2) + rel[MV_Y];
+
+            set_mv_bound(mv[MV_X] >> 2, mv[MV_Y] >> 2, org->w_l, org->h_l, min_mv, max_mv);
+            fcst_me_ipel(org, ref, min_mv, max_mv, x_lvl, y_lvl, log2_lvl, mvp_lvl, lambda, mv, bit_depth);
+
+            rel[MV_X] = mv[MV_X] - (x_lvl << 2);
+            rel[MV_Y] = mv[MV_Y] - (y_lvl << 2);
+        }
+        rel[MV_X] <<= 1;
+        rel[MV_Y] <<= 1;
+    }
+
+    seed[MV_X] = (x << 2) + rel[MV_X];
+    seed[MV_Y] = (y << 2) + rel[MV_Y];
+}
+
 static s32 est_inter_cost(XEVE_CTX * ctx, s32 x, s32 y, XEVE_PICO * pico_cur
                               , XEVE_PICO * pico_ref, s32 list, s32 uni_inter_mode)
 {
@@ -1178,14 +1215,17 @@ static s32 est_inter_cost(XEVE_CTX * ctx, s32 x, s32 y, XEVE_PICO * pico_cur
     s16      min_mv[MV_D], max_mv[MV_D];
     s16      (*map_mv)[REFP_NUM][MV_D], mvc[4][MV_D];
     s16      mvp[MV_D], mv[MV_D], best_mv[MV_D];
-    s32      cost, min_cost;
+    s32      cost, min_cost, shift;
     u16      lambda;
+    XEVE_PIC * pic_cur = pico_cur->spic_pyr[ctx->fcst.lvl - 1];
+    XEVE_PIC * pic_ref = pico_ref->spic_pyr[ctx->fcst.lvl - 1];
 
-    sub_w  = pico_cur->spic->w_l;
-    sub_h  = pico_cur->spic->h_l;
+    sub_w  = pic_cur->w_l;
+    sub_h  = pic_cur->h_l;
     mvp_num = 1;
+    shift  = FCST_LVL_SHIFT(ctx);
 
-    log2_cuwh = ctx->fcst.log2_fcst_blk_spic + 1;
+    log2_cuwh = FCST_LOG2_BLK(ctx);
     cuwh      = 1 << log2_cuwh;
     pos       = (x >> log2_cuwh) + (y >> log2_cuwh) * ctx->w_lcu;
     map_mv    = uni_inter_mode > 1 ? pico_cur->sinfo.map_mv_pga : pico_cur->sinfo.map_mv;
@@ -1198,6 +1238,11 @@ static s32 est_inter_cost(XEVE_CTX * ctx, s32 x, s32 y, XEVE_PICO * pico_cur
         get_mvc_nev(mvc + 1, &map_mv[pos], pos, list, ctx->w_lcu);
         mvp_num = 4;
     }
+    for (s32 i = 0; i < mvp_num; i++)
+    {
+        mvc[i][MV_X] >>= shift;
+        mvc[i][MV_Y] >>= shift;
+    }
 
     if (x + cuwh <= sub_w && y + cuwh <= sub_h)
     {
@@ -1210,7 +1255,7 @@ static s32 est_inter_cost(XEVE_CTX * ctx, s32 x, s32 y, XEVE_PICO * pico_cur
             mvp[MV_Y] = mv[MV_Y];
 
             set_mv_bound(mvp[MV_X] >> 2, mvp[MV_Y] >> 2, sub_w, sub_h, min_mv, max_mv);
-            cost = fcst_me_ipel(pico_cur->spic, pico_ref->spic, min_mv, max_mv, x, y
+            cost = fcst_me_ipel(pic_cur, pic_ref, min_mv, max_mv, x, y
                                  , log2_cuwh, mvp, lambda, mv, ctx->param.codec_bit_depth);
 
             if (cost < min_cost)
@@ -1220,8 +1265,27 @@ static s32 est_inter_cost(XEVE_CTX * ctx, s32 x, s32 y, XEVE_PICO * pico_cur
                 min_cost = cost;
             }
         }
-        map_mv[pos][list][MV_X] = mv[MV_X] - (x << 2);
-        map_mv[pos][list][MV_Y] = mv[MV_Y] - (y << 2);
+        if (ctx->fcst.lvl_top > ctx->fcst.lvl)
+        {
+            s16 mv_s[MV_D];
+
+            mvp[MV_X] = (x << 2) + mvc[0][MV_X];
+            mvp[MV_Y] = (y << 2) + mvc[0][MV_Y];
+            fcst_me_pyr_seed(ctx, pico_cur, pico_ref, x, y, log2_cuwh, mvp, lambda, ctx->param.codec_bit_depth, mv_s);
+
+            set_mv_bound(mv_s[MV_X] >> 2, mv_s[MV_Y] >> 2, sub_w, sub_h, min_mv, max_mv);
+            cost = fcst_me_ipel(pic_cur, pic_ref, min_mv, max_mv, x, y
+                                 , log2_cuwh, mvp, lambda, mv_s, ctx->param.codec_bit_depth);
+            if (cost < min_cost)
+            {
+                best_mv[MV_X] = mv[MV_X] = mv_s[MV_X];
+                best_mv[MV_Y] = mv[MV_Y] = mv_s[MV_Y];
+                min_cost = cost;
+            }
+        }
+        map_mv[pos][list][MV_X] = (mv[MV_X] - (x << 2)) << shift;
+        map_mv[pos][list][MV_Y] = (mv[MV_Y] - (y << 2)) << shift;
+        min_cost <<= (shift << 1);
     }
     else
     {
@@ -1243,7 +1307,7 @@ void uni_direction_cost_estimation(XEVE_CTX * ctx, XEVE_PICO * pico_cur, XEVE_PI
 
     map_lcu_cost = pico_cur->sinfo.map_uni_lcost;
     map_pdir = pico_cur->sinfo.map_pdir;
-    log2_cuwh =  ctx->fcst.log2_fcst_blk_spic + 1;
+    log2_cuwh =  FCST_LOG2_BLK(ctx);
 
     if (intra_cost_compute) pico_cur->sinfo.uni_est_cost[INTRA] = 0;
 
@@ -1333,6 +1397,33 @@ static s32 fcst_me_ipel_b(XEVE_PIC * org_pic, XEVE_PIC * ref_pic_0, XEVE_PIC * r
     return cost;
 }
 
+/* search once more from the pyramid seed and keep it if it beats the search
+   from the predictor */
+static s32 get_bi_lcost_seed(XEVE_CTX * ctx, XEVE_PICO * pico_cur, XEVE_PICO * pico_ref, s32 x, s32 y, s32 log2_cuwh
+                             , s16 mvp[MV_D], u16 lambda, s32 cost, s16 mv[MV_D], s16 min_mv[MV_D], s16 max_mv[MV_D])
+{
+    XEVE_PIC * pic_cur = pico_cur->spic_pyr[ctx->fcst.lvl - 1];
+    s16        mv_s[MV_D], min_s[MV_D], max_s[MV_D];
+    s32        cost_s;
+
+    fcst_me_pyr_seed(ctx, pico_cur, pico_ref, x, y, log2_cuwh, mvp, lambda, 10, mv_s);
+    set_mv_bound(mv_s[MV_X] >> 2, mv_s[MV_Y] >> 2, pic_cur->w_l, pic_cur->h_l, min_s, max_s);
+    cost_s = fcst_me_ipel(pic_cur, pico_ref->spic_pyr[ctx->fcst.lvl - 1], min_s, max_s, x, y,
+        log2_cuwh, mvp, lambda, mv_s, 10);
+
+    if (cost_s < cost)
+    {
+        mv[MV_X] = mv_s[MV_X];
+        mv[MV_Y] = mv_s[MV_Y];
+        min_mv[MV_X] = min_s[MV_X];
+        min_mv[MV_Y] = min_s[MV_Y];
+        max_mv[MV_X] = max_s[MV_X];
+        max_mv[MV_Y] = max_s[MV_Y];
+        cost = cost_s;
+    }
+    return cost;
+}
+
 static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
                 XEVE_PICO * pico_0, XEVE_PICO * pico_2, u8 * map_bdir)
 {
@@ -1341,17 +1432,22 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
     s16    min_l1[MV_D], max_l1[MV_D];
     s16    mvc_l0[MV_D], mvc_l1[MV_D], mvd_l0[MV_D], mvd_l1[MV_D], mv_l0[MV_D];
     s16 (* map_mv)[REFP_NUM][MV_D];
-    s32    cost_l1,cost_l0, cost, best_cost;
+    s32    cost_l1,cost_l0, cost, best_cost, shift;
     u16   lambda_p, lambda_b;
+    int    lvl = ctx->fcst.lvl;
+    XEVE_PIC * pic_1 = pico_1->spic_pyr[lvl - 1];
+    XEVE_PIC * pic_0 = pico_0->spic_pyr[lvl - 1];
+    XEVE_PIC * pic_2 = pico_2->spic_pyr[lvl - 1];
 
     best_cost = XEVE_INT32_MAX;
-    log2_cuwh = ctx->fcst.log2_fcst_blk_spic + 1;
+    log2_cuwh = FCST_LOG2_BLK(ctx);
     cuwh      = 1 << log2_cuwh;
     pos = ((x >> log2_cuwh) + (y >> log2_cuwh)* ctx->fcst.w_blk);
     map_mv    = pico_1->sinfo.map_mv_bi;
+    shift     = FCST_LVL_SHIFT(ctx);
 
-    sub_w = pico_1->spic->w_l;
-    sub_h = pico_1->spic->h_l;
+    sub_w = pic_1->w_l;
+    sub_h = pic_1->h_l;
 
     lambda_b = lambda_p = (u16)(0.57 * pow(2.0, (RC_INIT_QP - 12.0) / 3.0));
 
@@ -1360,6 +1456,8 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
 
         /* set maximum/minimum value of search range */
         get_mvc_median(mvc_l0, &map_mv[pos], pos, REFP_0, ctx->fcst.w_blk);
+        mvc_l0[MV_X] >>= shift;
+        mvc_l0[MV_Y] >>= shift;
         set_mv_bound(x + (mvc_l0[MV_X] >> 2), y + (mvc_l0[MV_Y] >> 2), sub_w, sub_h, min_l0, max_l0);
 
         /* Find mvc at pos in fcst_ref */
@@ -1367,8 +1465,12 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
         mv_l0[MV_Y] = mvp_l0[MV_Y] = (y << 2) + mvc_l0[MV_Y];
 
         /* L0-direction motion vector difference */
-        cost_l0 = fcst_me_ipel(pico_1->spic, pico_0->spic, min_l0, max_l0, x, y,
+        cost_l0 = fcst_me_ipel(pic_1, pic_0, min_l0, max_l0, x, y,
             log2_cuwh, mvp_l0, lambda_b, mv_l0, 10);
+        if (ctx->fcst.lvl_top > lvl)
+        {
+            cost_l0 = get_bi_lcost_seed(ctx, pico_1, pico_0, x, y, log2_cuwh, mvp_l0, lambda_b, cost_l0, mv_l0, min_l0, max_l0);
+        }
 
         mvd_l0[MV_X] = mv_l0[MV_X] - mvp_l0[MV_X];
         mvd_l0[MV_Y] = mv_l0[MV_Y] - mvp_l0[MV_Y];
@@ -1382,6 +1484,8 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
 
         /* set maximum/minimum value of search range */
         get_mvc_median(mvc_l1, &map_mv[pos], pos, PRED_L1, ctx->w_lcu);
+        mvc_l1[MV_X] >>= shift;
+        mvc_l1[MV_Y] >>= shift;
         set_mv_bound(x + (mvc_l1[MV_X] >> 2), y + (mvc_l1[MV_Y] >> 2),  sub_w, sub_h, min_l1, max_l1);
 
         /* Find mvc at pos in fcst_ref */
@@ -1389,8 +1493,12 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
         mv_l1[MV_Y] = mvp_l1[MV_Y] = (y << 2) + mvc_l1[MV_Y];
 
 
-        cost_l1 = fcst_me_ipel(pico_1->spic, pico_2->spic, min_l1, max_l1, x, y,
+        cost_l1 = fcst_me_ipel(pic_1, pic_2, min_l1, max_l1, x, y,
             log2_cuwh, mvp_l1, lambda_b, mv_l1, 10);
+        if (ctx->fcst.lvl_top > lvl)
+        {
+            cost_l1 = get_bi_lcost_seed(ctx, pico_1, pico_2, x, y, log2_cuwh, mvp_l1, lambda_b, cost_l1, mv_l1, min_l1, max_l1);
+        }
 
         mvd_l1[MV_X] = mv_l1[MV_X] - mvp_l1[MV_X];
         mvd_l1[MV_Y] = mv_l1[MV_Y] - mvp_l1[MV_Y];
@@ -1402,8 +1510,8 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
 
         }
 
-        cost = fcst_me_ipel_b(pico_1->spic, pico_0->spic,
-            pico_2->spic, x, y, log2_cuwh, lambda_b, mv_l0, mvd_l0, mv_l1,
+        cost = fcst_me_ipel_b(pic_1, pic_0,
+            pic_2, x, y, log2_cuwh, lambda_b, mv_l0, mvd_l0, mv_l1,
             mvd_l1, 10, min_l0, max_l0, min_l1, max_l1);
 
         if (cost< best_cost)
@@ -1412,10 +1520,11 @@ static s32 get_bi_lcost(XEVE_CTX * ctx, int x, int y, XEVE_PICO * pico_1,
             *map_bdir = INTER_BI;
         }
 
-        map_mv[pos][PRED_L0][MV_X] = mv_l0[MV_X] - (x << 2);
-        map_mv[pos][PRED_L0][MV_Y] = mv_l0[MV_Y] - (y << 2);
-        map_mv[pos][PRED_L1][MV_X] = mv_l1[MV_X] - (x << 2);
-        map_mv[pos][PRED_L1][MV_Y] = mv_l1[MV_Y] - (y << 2);
+        map_mv[pos][PRED_L0][MV_X] = (mv_l0[MV_X] - (x << 2)) << shift;
+        map_mv[pos][PRED_L0][MV_Y] = (mv_l0[MV_Y] - (y << 2)) << shift;
+        map_mv[pos][PRED_L1][MV_X] = (mv_l1[MV_X] - (x << 2)) << shift;
+        map_mv[pos][PRED_L1][MV_Y] = (mv_l1[MV_Y] - (y << 2)) << shift;
+        best_cost <<= (shift << 1);
     }
     else
     {
@@ -1444,7 +1553,7 @@ void bi_direction_cost_estimation(XEVE_CTX * ctx, XEVE_PICO * pico_cur, XEVE_PIC
     /* get map_lcost for pictures */
     uni_lcost = pico_cur->sinfo.map_uni_lcost; /* current pic */
     bi_lcost = pico_cur->sinfo.map_bi_lcost; /* current pic */
-    log2_cuwh = ctx->fcst.log2_fcst_blk_spic + 1;
+    log2_cuwh = FCST_LOG2_BLK(ctx);
     map_pdir = pico_cur->sinfo.map_pdir_bi;
 
     /* first init delayed_fcost */
@@ -1587,6 +1696,33 @@ void get_fcost_fixed_gop(XEVE_CTX * ctx, int is_intra_pic)
     }
 }
 
+/* build the levels below the half size picture by 2x2 averaging */
+void xeve_fcst_gen_pyramid(XEVE_CTX * ctx, XEVE_PICO * pico)
+{
+    XEVE_PIC * src, * dst;
+    pel      * s, * d;
+    int        lvl, i, j;
+
+    for (lvl = 1; lvl < ctx->fcst.lvl_top; lvl++)
+    {
+        src = pico->spic_pyr[lvl - 1];
+        dst = pico->spic_pyr[lvl];
+        s = src->y;
+        d = dst->y;
+
+        for (j = 0; j < dst->h_l; j++)
+        {
+            for (i = 0; i < dst->w_l; i++)
+            {
+                d[i] = (s[2 * i] + s[2 * i + 1] + s[src->s_l + 2 * i] + s[src->s_l + 2 * i + 1] + 2) >> 2;
+            }
+            s += src->s_l << 1;
+            d += dst->s_l;
+        }
+        xeve_picbuf_expand(dst, dst->pad_l, dst->pad_c, 0);
+    }
+}
+
 int xeve_forecast_fixed_gop(XEVE_CTX* ctx)
 {
     XEVE_PICO * pico;
@@ -1595,7 +1731,7 @@ int xeve_forecast_fixed_gop(XEVE_CTX* ctx)
 
     pico      = ctx->pico;
     pic_icnt  = ctx->pico->pic_icnt;
-    i_period  = ctx->param.keyint;
+    i_period  = ctx->param.intra_refresh ? 0 : ctx->param.keyint;
     int gop_size = ctx->param.bframes + 1;
 
     if ((i_period == 0 && pic_icnt == 0) || (i_period > 0 && pic_icnt % i_period == 0))
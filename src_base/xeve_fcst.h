@@ -43,6 +43,8 @@
 #define LCU_STRENGTH                   0.75
 
 #define SEARCH_RANGE_IPEL            64
+/* minimum luma width of a pyramid level built only to seed a finer level */
+#define FCST_PYR_MIN_W               480
 #define INIT_SDS_PTS                 4
 /* initial direction of diamond searhc pattern */
 #define RC_INIT_QP                   28
@@ -91,7 +93,8 @@ enum QPA_TYPE
 /* complexity threthold */
 
 int  xeve_forecast_fixed_gop(XEVE_CTX* ctx);
-void xeve_gen_subpic(pel* src_y, pel* dst_y, int w, int h, int s_s, int d_s, int bit_depth);
+void xeve_fcst_gen_pyramid(XEVE_CTX * ctx, XEVE_PICO * pico);
 s32  xeve_fcst_get_scene_type(XEVE_CTX * ctx, XEVE_PICO * pico);
+u64  get_lcu_var(XEVE_CTX * ctx, void * pic, int log2_w_max, int log2_h_max, int x, int y, int stride);
 
 #endif /* _XEVE_FCST_H_ */
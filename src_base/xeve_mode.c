@@ -34,7 +34,7 @@
 #include <math.h>
 
 typedef int(*LOSSY_ES_FUNC)(XEVE_CU_DATA *, int, double, int, int, int, int, int, int);
-static s32 entropy_bits[1024];
+s32 xeve_entropy_bits[1024];
 
 void xeve_sbac_bit_reset(XEVE_SBAC * sbac)
 {
@@ -46,10 +46,15 @@ void xeve_sbac_bit_reset(XEVE_SBAC * sbac)
     sbac->stacked_zero    = 0;
     sbac->bitcounter      = 0;
     sbac->bin_counter     = 0;
+    sbac->frac_bits       = 0;
 }
 
 u32 xeve_get_bit_number(XEVE_SBAC *sbac)
 {
+    if(sbac->is_bitcount == SBAC_BITCOUNT_EST)
+    {
+        return (sbac->frac_bits + (1 << (SBAC_EST_BITS_SHIFT - 1))) >> SBAC_EST_BITS_SHIFT;
+    }
     return sbac->bitcounter + 8 * (sbac->stacked_zero + sbac->stacked_ff) + 8 * (sbac->is_pending_byte ? 1 : 0) + 8 - sbac->code_bits + 3;
 }
 
@@ -276,7 +281,9 @@ void xeve_rdo_bit_cnt_cu_skip(XEVE_CTX * ctx, XEVE_CORE * core, s32 slice_type,
     }
 }
 
-void xeve_init_bits_est()
+static THREAD_ONCE bits_est_once = THREAD_ONCE_INIT;
+
+static void init_entropy_bits(void)
 {
     int i = 0;
     double p;
@@ -284,10 +291,16 @@ void xeve_init_bits_est()
     for(i = 0; i < 1024; i++)
     {
         p = (512 * (i + 0.5)) / 1024;
-        entropy_bits[i] = (s32)(-32768 * (log(p) / log(2.0) - 9));
+        xeve_entropy_bits[i] = (s32)(-32768 * (log(p) / log(2.0) - 9));
     }
 }
 
+void xeve_init_bits_est()
+{
+    /* shared by all encoder instances, so it is built by the first one only */
+    threadsafe_once(&bits_est_once, init_entropy_bits);
+}
+
 static s32 biari_no_bits(int symbol, SBAC_CTX_MODEL* cm)
 {
     u16 mps, state;
@@ -296,7 +309,7 @@ static s32 biari_no_bits(int symbol, SBAC_CTX_MODEL* cm)
     state = (*cm) >> 1;
     state = ((u16)(symbol != 0) != mps) ? state : (512 - state);
 
-    return entropy_bits[state << 1];
+    return xeve_entropy_bits[state << 1];
 }
 
 static void xeve_rdoq_bit_est(XEVE_SBAC * sbac, XEVE_CORE * core)
@@ -1186,11 +1199,18 @@ double mode_check_inter(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log2_c
     int end_comp = xeve_check_chroma(core->tree_cons) ? N_C : U_C;
     int     i, s_rec[N_C];
 
-    if (ctx->slice_type != SLICE_I && (ctx->sps.tool_admvp == 0 || !(log2_cuw <= MIN_CU_LOG2 && log2_cuh <= MIN_CU_LOG2)) && (!xeve_check_only_intra(core->tree_cons)))
+    /* CTUs of the intra refresh column are coded in intra */
+    if (ctx->slice_type != SLICE_I && (ctx->sps.tool_admvp == 0 || !(log2_cuw <= MIN_CU_LOG2 && log2_cuh <= MIN_CU_LOG2)) && (!xeve_check_only_intra(core->tree_cons))
+        && (core->x_lcu < ctx->ir_col_beg || core->x_lcu >= ctx->ir_col_end))
     {
         core->avail_cu = xeve_get_avail_inter(core->x_scu, core->y_scu, ctx->w_scu, ctx->h_scu, core->scup, core->cuw, core->cuh, ctx->map_scu, ctx->map_tidx);
         cost = ctx->fn_pinter_analyze_cu(ctx, core, x, y, log2_cuw, log2_cuh, mi, coef, rec, s_rec);
 
+        if (cost < cost_best && !xeve_ir_check_motion(ctx, core, x, 1 << log2_cuw, mi->refi, mi->mv))
+        {
+            cost = MAX_COST;
+        }
+
         if (cost < cost_best)
         {
             cost_best = cost;
@@ -1302,9 +1322,13 @@ static double mode_coding_unit(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int
 
     cost_best = MAX_COST;
     core->cost_best = MAX_COST;
+    core->static_hit = 0;
 
     cost_best = mode_check_inter(ctx, core, x, y, log2_cuw, log2_cuh, cud, mi, cost_best);
-    cost_best = mode_check_intra(ctx, core, x, y, log2_cuw, log2_cuh, cud, mi, cost_best);
+    if(!core->static_hit)
+    {
+        cost_best = mode_check_intra(ctx, core, x, y, log2_cuw, log2_cuh, cud, mi, cost_best);
+    }
 
     return cost_best;
 }
@@ -1905,6 +1929,11 @@ static double mode_coding_tree(XEVE_CTX *ctx, XEVE_CORE *core, int x0, int y0, i
         split_allow[NO_SPLIT] = 1;
     }
 
+    if(ctx->pass && !boundary)
+    {
+        xeve_pass_split_prune(ctx, x0, y0, log2_cuw, log2_cuh, split_allow);
+    }
+
     if(!boundary)
     {
         cost_temp = 0.0;
@@ -2009,6 +2038,12 @@ static double mode_coding_tree(XEVE_CTX *ctx, XEVE_CORE *core, int x0, int y0, i
         next_split = 0;
     }
 
+    if(cost_best != MAX_COST && core->static_hit && core->cu_mode == MODE_SKIP)
+    {
+        core->static_cu++;
+        next_split = 0;
+    }
+
     if(cost_best != MAX_COST && ctx->sh->slice_type == SLICE_I)
     {
         int dist_cu = core->dist_cu_best;
@@ -2210,10 +2245,61 @@ int xeve_mode_init_mt(XEVE_CTX *ctx, int thread_idx)
     return XEVE_OK;
 }
 
+/* a CTU is static when its mean absolute difference to the collocated block of
+   the first reference picture is below static_th and the lookahead found no
+   motion over it */
+static void mode_check_static_lcu(XEVE_CTX *ctx, XEVE_CORE *core)
+{
+    XEVE_PIC *org = PIC_ORIG(ctx);
+    XEVE_PIC *ref = ctx->refp[0][REFP_0].pic;
+    s16     (*map_mv)[REFP_NUM][MV_D];
+    int       log2_blk, x0, y0, x1, y1, i, j;
+    s64       sad;
+
+    core->ctu_static = 0;
+    core->static_hit = 0;
+
+    if(ctx->param.static_th == 0 || ctx->slice_type == SLICE_I || ref == NULL ||
+       core->x_pel + ctx->max_cuwh > ctx->w || core->y_pel + ctx->max_cuwh > ctx->h)
+    {
+        return;
+    }
+
+    if(ctx->param.use_fcst)
+    {
+        /* forecast blocks are 4 times larger in the original picture than in
+           the half sized one */
+        map_mv = ctx->pico->sinfo.map_mv;
+        log2_blk = ctx->fcst.log2_fcst_blk_spic + 2;
+        x0 = core->x_pel >> log2_blk;
+        y0 = core->y_pel >> log2_blk;
+        x1 = XEVE_MIN((core->x_pel + ctx->max_cuwh - 1) >> log2_blk, ctx->fcst.w_blk - 1);
+        y1 = XEVE_MIN((core->y_pel + ctx->max_cuwh - 1) >> log2_blk, ctx->fcst.h_blk - 1);
+
+        for(j = y0; j <= y1; j++)
+        {
+            for(i = x0; i <= x1; i++)
+            {
+                if(map_mv[j * ctx->fcst.w_blk + i][REFP_0][MV_X] || map_mv[j * ctx->fcst.w_blk + i][REFP_0][MV_Y])
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    sad = xeve_sad_16b(ctx->log2_max_cuwh, ctx->log2_max_cuwh, org->y + core->y_pel * org->s_l + core->x_pel
+                     , ref->y + core->y_pel * ref->s_l + core->x_pel, org->s_l, ref->s_l, ctx->sps.bit_depth_luma_minus8 + 8);
+
+    core->ctu_static = (sad << 4) <= ((s64)ctx->param.static_th << (ctx->log2_max_cuwh << 1));
+}
+
 int mode_init_lcu(XEVE_CTX *ctx, XEVE_CORE *core)
 {
     int ret;
 
+    mode_check_static_lcu(ctx, core);
+
     /*initialize lambda for lcu */
     set_lambda(ctx, core, ctx->sh, ctx->sh->qp);
     /* initialize pintra */
@@ -2445,71 +2531,194 @@ int xeve_mode_create(XEVE_CTX *ctx, int complexity)
  * picture buffer alloc/free/expand
  ******************************************************************************/
 
-static void picbuf_expand(pel *a, int s, int w, int h, int exp)
+/* 4x4 blocks of a window row processed at a time, with one block of overlap
+   between the column chunks */
+#define SSIM_CHUNK_BLK 256
+
+/* SSIM of an 8x8 window from the sums of its four 4x4 blocks. the constants
+   are scaled by the square of the window size as the sums are */
+static double ssim_window(s32 * a, s32 * b, s32 * c, s32 * d, double c1, double c2)
 {
-    int i, j;
-    pel pixel;
-    pel *src, *dst;
+    double s1  = (double)a[0] + b[0] + c[0] + d[0];
+    double s2  = (double)a[1] + b[1] + c[1] + d[1];
+    double ss  = (double)a[2] + b[2] + c[2] + d[2];
+    double s12 = (double)a[3] + b[3] + c[3] + d[3];
+    double vars = ss * 64 - s1 * s1 - s2 * s2;
+    double covar = s12 * 64 - s1 * s2;
+
+    return (2 * s1 * s2 + c1) * (2 * covar + c2) / ((s1 * s1 + s2 * s2 + c1) * (vars + c2));
+}
 
-    /* left */
-    src = a;
-    dst = a - exp;
+/* sums of squared errors of the band rows over the input picture area, and
+   the sum of SSIM of the luma windows whose top 4x4 block row is in the band.
+   windows at the band bottom read rows of the next band, which are already
+   filtered */
+static void pic_metrics_band(XEVE_PAD_BAND * band)
+{
+    XEVE_CTX * ctx = band->ctx;
+    XEVE_PIC * org = PIC_ORIG(ctx);
+    XEVE_PIC * rec = band->pic;
+    s32        sums[2][SSIM_CHUNK_BLK + 1][4];
+    double     peak, c1, c2;
+    int        w_shift = XEVE_GET_CHROMA_W_SHIFT(ctx->sps.chroma_format_idc);
+    int        h_shift = XEVE_GET_CHROMA_H_SHIFT(ctx->sps.chroma_format_idc);
+    int        y0 = band->row_start << ctx->log2_max_cuwh;
+    int        y1 = XEVE_MIN(band->row_end << ctx->log2_max_cuwh, ctx->param.h);
+    int        w_c, y0_c, y1_c, w_blk, h_blk, b0, b1, n, x, j, j1, cur;
+
+    xeve_mset(band->sse, 0, sizeof(band->sse));
+    band->sse[Y_C] = xeve_func_sse(org->y + y0 * org->s_l, org->s_l, rec->y + y0 * rec->s_l, rec->s_l, ctx->param.w, y1 - y0);
+    if(ctx->sps.chroma_format_idc)
+    {
+        w_c = (ctx->param.w + w_shift) >> w_shift;
+        y0_c = y0 >> h_shift;
+        y1_c = (y1 + h_shift) >> h_shift;
+        band->sse[U_C] = xeve_func_sse(org->u + y0_c * org->s_c, org->s_c, rec->u + y0_c * rec->s_c, rec->s_c, w_c, y1_c - y0_c);
+        band->sse[V_C] = xeve_func_sse(org->v + y0_c * org->s_c, org->s_c, rec->v + y0_c * rec->s_c, rec->s_c, w_c, y1_c - y0_c);
+    }
 
-    for(i = 0; i < h; i++)
+    band->ssim = 0;
+    if(band->metrics < 2)
+    {
+        return;
+    }
+    peak = (double)((1 << (ctx->sps.bit_depth_luma_minus8 + 8)) - 1);
+    c1 = .01 * .01 * peak * peak * 64 * 64;
+    c2 = .03 * .03 * peak * peak * 64 * 64;
+    w_blk = ctx->param.w >> 2;
+    h_blk = ctx->param.h >> 2;
+    j1 = XEVE_MIN(y1 >> 2, h_blk - 1);
+
+    for(b0 = 0; b0 + 1 < w_blk; b0 += SSIM_CHUNK_BLK)
     {
-        pixel = *src; /* get boundary pixel */
-        for(j = 0; j < exp; j++)
+        b1 = XEVE_MIN(b0 + SSIM_CHUNK_BLK, w_blk - 1);
+        n = b1 - b0 + 1;
+        cur = 0;
+        for(j = y0 >> 2; j < j1; j++)
         {
-            dst[j] = pixel;
+            if(j == (y0 >> 2))
+            {
+                xeve_func_ssim_4x4(org->y + (j << 2) * org->s_l + (b0 << 2), org->s_l, rec->y + (j << 2) * rec->s_l + (b0 << 2), rec->s_l, n << 2, sums[cur]);
+            }
+            xeve_func_ssim_4x4(org->y + ((j + 1) << 2) * org->s_l + (b0 << 2), org->s_l, rec->y + ((j + 1) << 2) * rec->s_l + (b0 << 2), rec->s_l, n << 2, sums[!cur]);
+            for(x = 0; x + 1 < n; x++)
+            {
+                band->ssim += ssim_window(sums[cur][x], sums[cur][x + 1], sums[!cur][x], sums[!cur][x + 1], c1, c2);
+            }
+            cur = !cur;
         }
-        dst += s;
-        src += s;
     }
+}
 
-    /* right */
-    src = a + (w - 1);
-    dst = a + w;
+static int pic_expand_band(void * arg)
+{
+    XEVE_PAD_BAND * band = (XEVE_PAD_BAND *)arg;
+    XEVE_CTX      * ctx = band->ctx;
+    XEVE_PIC      * pic = band->pic;
+    int             row, i;
 
-    for(i = 0; i < h; i++)
+    for(row = band->row_start; row < band->row_end; row++)
     {
-        pixel = *src; /* get boundary pixel */
-        for(j = 0; j < exp; j++)
+        xeve_picbuf_expand_rows(pic, row << ctx->log2_max_cuwh, (row + 1) << ctx->log2_max_cuwh, pic->pad_l, pic->pad_c, ctx->sps.chroma_format_idc);
+
+        /* only the top band can report rows as they complete */
+        if(band->row_start == 0)
         {
-            dst[j] = pixel;
+            threadsafe_assign(&pic->rows_padded, row + 1);
         }
-        dst += s;
-        src += s;
     }
 
-    /* upper */
-    src = a - exp;
-    dst = a - exp - (exp * s);
-
-    for(i = 0; i < exp; i++)
+    /* padding leaves the picture area as it is, so hashing and measuring it
+       can overlap with the other bands */
+    if(band->metrics)
     {
-        xeve_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        pic_metrics_band(band);
     }
-
-    /* below */
-    src = a + ((h - 1)*s) - exp;
-    dst = a + ((h - 1)*s) - exp + s;
-
-    for(i = 0; i < exp; i++)
+    for(i = 0; i < pic->imgb->np; i++)
     {
-        xeve_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        if(band->sign_planes & (1 << i))
+        {
+            xeve_md5_imgb_plane(pic->imgb, i, pic->digest[i]);
+        }
     }
+    return XEVE_OK;
 }
 
+/* pad the picture in bands of CTU rows, one band per encoder thread. the
+   picture signature, if enabled, is computed plane by plane on the same
+   threads, and the quality metrics band by band */
 void xeve_pic_expand(XEVE_CTX *ctx, XEVE_PIC *pic)
 {
-    xeve_picbuf_expand(pic, pic->pad_l, pic->pad_c, ctx->sps.chroma_format_idc);
+    int band_cnt = XEVE_MAX(1, XEVE_MIN(ctx->param.threads, (int)ctx->h_lcu));
+    int i, j, res, w_win, h_win;
+
+    for(i = 0; i < band_cnt; i++)
+    {
+        ctx->pad_band[i].ctx = ctx;
+        ctx->pad_band[i].pic = pic;
+        ctx->pad_band[i].row_start = (ctx->h_lcu * i) / band_cnt;
+        ctx->pad_band[i].row_end = (ctx->h_lcu * (i + 1)) / band_cnt;
+        ctx->pad_band[i].sign_planes = 0;
+        /* with DRA the original is only held converted */
+        ctx->pad_band[i].metrics = ctx->param.tool_dra ? 0 : ctx->param.calc_metrics;
+    }
+    /* with DRA the signature is taken from the converted picture instead */
+    if(ctx->param.use_pic_sign && ctx->pps.pic_dra_enabled_flag == 0)
+    {
+        /* the largest plane goes to the last band, away from the top band
+           that reports progress */
+        for(i = 0; i < pic->imgb->np; i++)
+        {
+            ctx->pad_band[band_cnt - 1 - (i % band_cnt)].sign_planes |= 1 << i;
+        }
+    }
+    for(i = 1; i < band_cnt; i++)
+    {
+        ctx->tc->run(ctx->thread_pool[i], pic_expand_band, (void*)&ctx->pad_band[i]);
+    }
+    pic_expand_band((void*)&ctx->pad_band[0]);
+    for(i = 1; i < band_cnt; i++)
+    {
+        ctx->tc->join(ctx->thread_pool[i], &res);
+    }
+    threadsafe_assign(&pic->rows_padded, ctx->h_lcu);
+
+    if(ctx->pad_band[0].metrics)
+    {
+        xeve_mset(ctx->metric_sse, 0, sizeof(ctx->metric_sse));
+        ctx->metric_ssim = 0;
+        for(i = 0; i < band_cnt; i++)
+        {
+            for(j = 0; j < N_C; j++)
+            {
+                ctx->metric_sse[j] += ctx->pad_band[i].sse[j];
+            }
+            ctx->metric_ssim += ctx->pad_band[i].ssim;
+        }
+        w_win = (ctx->param.w >> 2) - 1;
+        h_win = (ctx->param.h >> 2) - 1;
+        ctx->metric_ssim = (w_win > 0 && h_win > 0) ? ctx->metric_ssim / (w_win * h_win) : 1;
+    }
 }
 
 XEVE_PIC * xeve_pic_alloc(PICBUF_ALLOCATOR * pa, int * ret)
 {
-    return xeve_picbuf_alloc(pa->w, pa->h, pa->pad_l, pa->pad_c, pa->bit_depth, ret, pa->chroma_format_idc);
+    XEVE_PIC * pic;
+
+    pic = xeve_picbuf_alloc(pa->w, pa->h, pa->pad_l, pa->pad_c, pa->bit_depth, ret, pa->chroma_format_idc);
+
+    /* 8bit pictures keep an 8bit copy of luma for integer-pel motion search */
+    if(pic != NULL && pa->bit_depth == 8)
+    {
+        int err = xeve_picbuf_alloc_y8(pic);
+        if(err != XEVE_OK)
+        {
+            xeve_picbuf_free(pic);
+            if(ret) *ret = err;
+            return NULL;
+        }
+    }
+    return pic;
 }
 
 void xeve_pic_free(PICBUF_ALLOCATOR *pa, XEVE_PIC *pic)
@@ -40,8 +40,8 @@ int  xeve_bsw_write_nalu_size(XEVE_BSW *bs);
 
 void xeve_diff_pred(int x, int y, int log2_cuw, int log2_cuh, XEVE_PIC *org, pel pred[N_C][MAX_CU_DIM], s16 diff[N_C][MAX_CU_DIM], int bit_depth_luma, int bit_depth_chroma, int chroma_format_idc);
 
-#define SBAC_STORE(dst, src) xeve_mcpy(&dst, &src, sizeof(XEVE_SBAC))
-#define SBAC_LOAD(dst, src)  xeve_mcpy(&dst, &src, sizeof(XEVE_SBAC))
+#define SBAC_STORE(dst, src) xeve_sbac_copy(&dst, &src)
+#define SBAC_LOAD(dst, src)  xeve_sbac_copy(&dst, &src)
 #define DQP_STORE(dst, src) xeve_mcpy(&dst, &src, sizeof(XEVE_DQP))
 #define DQP_LOAD(dst, src)  xeve_mcpy(&dst, &src, sizeof(XEVE_DQP))
 void xeve_set_qp(XEVE_CTX *ctx, XEVE_CORE *core, u8 qp);
@@ -60,6 +60,8 @@ void xeve_rdo_bit_cnt_intra_dir(XEVE_CTX * ctx, XEVE_CORE * core, int ipm);
 
 void xeve_sbac_bit_reset(XEVE_SBAC * sbac);
 u32  xeve_get_bit_number(XEVE_SBAC * sbac);
+/* bits of a bin with probability of ((index + 0.5) / 1024), in 1/32768 unit */
+extern s32 xeve_entropy_bits[1024];
 void xeve_init_bits_est();
 u16  xeve_get_lr(u16 avail_lr);
 void calc_delta_dist_filter_boundary(XEVE_CTX* ctx, XEVE_PIC *pic_rec, XEVE_PIC *pic_org, int cuw, int cuh, pel(*src)[MAX_CU_DIM], int s_src, int x, int y, u16 avail_lr
@@ -65,6 +65,8 @@ typedef struct XEVE_PARAM_METADATA {
 static const XEVE_PARAM_METADATA xeve_params_metadata[] = {
     SET_XEVE_PARAM_METADATA( profile,                                   DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( threads,                                   DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( cpu_set,                                   DT_STRING ),
+    SET_XEVE_PARAM_METADATA( numa_node,                                 DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( w,                                         DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( h,                                         DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( fps.num,                                   DT_INTEGER ),
@@ -209,6 +211,16 @@ static const XEVE_PARAM_METADATA xeve_params_metadata[] = {
     /* preset parameter */
     SET_XEVE_PARAM_METADATA( ats_intra_fast,                            DT_INTEGER ),
     SET_XEVE_PARAM_METADATA( me_fast,                                   DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( fast_split,                                DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( ipd_presel,                                DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( rdo_bit_est,                               DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( intra_refresh,                             DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( pass,                                      DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( stats_file,                                DT_STRING ),
+    SET_XEVE_PARAM_METADATA( fcst_level,                                DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( static_th,                                 DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( calc_metrics,                              DT_INTEGER ),
+    SET_XEVE_PARAM_METADATA( mc_cache,                                  DT_INTEGER ),
 
     /* VUI options*/
     SET_XEVE_PARAM_METADATA( sar,                                       DT_INTEGER ),
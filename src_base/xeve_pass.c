@@ -0,0 +1,287 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_type.h"
+#include "xeve_pass.h"
+
+static long pass_frm_size(XEVE_PASS * pass)
+{
+    return (long)(sizeof(XEVE_PASS_FRM) + sizeof(XEVE_PASS_BLK) * pass->w_blk * pass->h_blk);
+}
+
+static int pass_open_stats(XEVE_CTX * ctx, XEVE_PASS * pass)
+{
+    XEVE_PASS_HDR hdr;
+    long          size;
+
+    pass->fp = fopen(ctx->param.stats_file, "rb");
+    if (pass->fp == NULL)
+    {
+        xeve_trace("cannot open stats file %s\n", ctx->param.stats_file);
+        return XEVE_ERR_INVALID_ARGUMENT;
+    }
+    if (fread(&hdr, sizeof(XEVE_PASS_HDR), 1, pass->fp) != 1 || hdr.magic != XEVE_PASS_MAGIC || hdr.version != XEVE_PASS_VERSION
+        || hdr.log2_blk != XEVE_PASS_LOG2_BLK || hdr.w != ctx->w || hdr.h != ctx->h)
+    {
+        xeve_trace("stats file %s does not match the current encoding\n", ctx->param.stats_file);
+        return XEVE_ERR_INVALID_ARGUMENT;
+    }
+
+    /* pictures are stored in fixed size records */
+    fseek(pass->fp, 0, SEEK_END);
+    size = ftell(pass->fp) - (long)sizeof(XEVE_PASS_HDR);
+    pass->frm_num = (int)(size / pass_frm_size(pass));
+    if (pass->frm_num <= 0)
+    {
+        return XEVE_OK;
+    }
+
+    pass->frm = (XEVE_PASS_FRM *)xeve_malloc(sizeof(XEVE_PASS_FRM) * pass->frm_num);
+    xeve_assert_rv(pass->frm != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    for (int i = 0; i < pass->frm_num; i++)
+    {
+        fseek(pass->fp, (long)sizeof(XEVE_PASS_HDR) + i * pass_frm_size(pass), SEEK_SET);
+        xeve_assert_rv(fread(&pass->frm[i], sizeof(XEVE_PASS_FRM), 1, pass->fp) == 1, XEVE_ERR_UNKNOWN);
+    }
+    return XEVE_OK;
+}
+
+int xeve_pass_create(XEVE_CTX * ctx)
+{
+    XEVE_PASS   * pass;
+    XEVE_PASS_HDR hdr;
+    int           ret;
+
+    ctx->pass = NULL;
+    if (ctx->param.pass == 0)
+    {
+        return XEVE_OK;
+    }
+
+    pass = (XEVE_PASS *)xeve_malloc(sizeof(XEVE_PASS));
+    xeve_assert_rv(pass != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    xeve_mset(pass, 0, sizeof(XEVE_PASS));
+    ctx->pass = pass;
+
+    pass->w_blk = (ctx->w + (1 << XEVE_PASS_LOG2_BLK) - 1) >> XEVE_PASS_LOG2_BLK;
+    pass->h_blk = (ctx->h + (1 << XEVE_PASS_LOG2_BLK) - 1) >> XEVE_PASS_LOG2_BLK;
+    pass->blk = (XEVE_PASS_BLK *)xeve_malloc(sizeof(XEVE_PASS_BLK) * pass->w_blk * pass->h_blk);
+    xeve_assert_gv(pass->blk != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+
+    if (ctx->param.pass == 1)
+    {
+        pass->fp = fopen(ctx->param.stats_file, "wb");
+        if (pass->fp == NULL)
+        {
+            xeve_trace("cannot create stats file %s\n", ctx->param.stats_file);
+            ret = XEVE_ERR_INVALID_ARGUMENT;
+            goto ERR;
+        }
+        xeve_mset(&hdr, 0, sizeof(XEVE_PASS_HDR));
+        hdr.magic = XEVE_PASS_MAGIC;
+        hdr.version = XEVE_PASS_VERSION;
+        hdr.log2_blk = XEVE_PASS_LOG2_BLK;
+        hdr.w = ctx->w;
+        hdr.h = ctx->h;
+        hdr.w_blk = pass->w_blk;
+        hdr.h_blk = pass->h_blk;
+        xeve_assert_gv(fwrite(&hdr, sizeof(XEVE_PASS_HDR), 1, pass->fp) == 1, ret, XEVE_ERR_UNKNOWN, ERR);
+    }
+    else
+    {
+        ret = pass_open_stats(ctx, pass);
+        xeve_assert_g(ret == XEVE_OK, ERR);
+
+        if (ctx->param.rc_type == XEVE_RC_ABR)
+        {
+            ret = xeve_rc_pass_plan(ctx, pass->frm, pass->frm_num);
+            xeve_assert_g(ret == XEVE_OK, ERR);
+        }
+    }
+    return XEVE_OK;
+ERR:
+    xeve_pass_delete(ctx);
+    return ret;
+}
+
+void xeve_pass_delete(XEVE_CTX * ctx)
+{
+    XEVE_PASS * pass = ctx->pass;
+
+    if (pass == NULL)
+    {
+        return;
+    }
+    if (pass->fp)
+    {
+        fclose(pass->fp);
+    }
+    xeve_mfree(pass->blk);
+    xeve_mfree(pass->frm);
+    xeve_mfree(pass);
+    ctx->pass = NULL;
+}
+
+void xeve_pass_pic_prepare(XEVE_CTX * ctx)
+{
+    XEVE_PASS           * pass = ctx->pass;
+    const XEVE_PASS_FRM * frm;
+    int                   idx = ctx->pic_cnt;
+
+    if (pass == NULL || ctx->param.pass != 2)
+    {
+        return;
+    }
+
+    /* the analysis is reused only while the GOP structure matches the first pass */
+    pass->blk_valid = 0;
+    if (idx >= pass->frm_num)
+    {
+        return;
+    }
+    frm = &pass->frm[idx];
+    if (frm->poc != ctx->poc.poc_val || frm->slice_type != ctx->slice_type)
+    {
+        return;
+    }
+    fseek(pass->fp, (long)sizeof(XEVE_PASS_HDR) + idx * pass_frm_size(pass) + (long)sizeof(XEVE_PASS_FRM), SEEK_SET);
+    pass->blk_valid = fread(pass->blk, sizeof(XEVE_PASS_BLK), pass->w_blk * pass->h_blk, pass->fp) == (size_t)(pass->w_blk * pass->h_blk);
+}
+
+int xeve_pass_pic_finish(XEVE_CTX * ctx, XEVE_STAT * stat)
+{
+    XEVE_PASS     * pass = ctx->pass;
+    XEVE_PASS_BLK * blk;
+    XEVE_PASS_FRM   frm;
+    int             i, j, lidx, scup, intra_cnt = 0;
+    s8              refi;
+
+    if (pass == NULL || ctx->param.pass != 1)
+    {
+        return XEVE_OK;
+    }
+
+    for (j = 0; j < pass->h_blk; j++)
+    {
+        for (i = 0; i < pass->w_blk; i++)
+        {
+            blk = pass->blk + j * pass->w_blk + i;
+            scup = ((j << XEVE_PASS_LOG2_BLK) >> MIN_CU_LOG2) * ctx->w_scu + ((i << XEVE_PASS_LOG2_BLK) >> MIN_CU_LOG2);
+
+            blk->log2_cuw = MCU_GET_LOGW(ctx->map_cu_mode[scup]);
+            blk->log2_cuh = MCU_GET_LOGH(ctx->map_cu_mode[scup]);
+            blk->intra = MCU_GET_IF(ctx->map_scu[scup]);
+            blk->dpoc = 0;
+            blk->mv[MV_X] = blk->mv[MV_Y] = 0;
+            intra_cnt += blk->intra;
+
+            for (lidx = 0; lidx < REFP_NUM && !blk->intra; lidx++)
+            {
+                refi = ctx->map_refi[scup][lidx];
+                if (REFI_IS_VALID(refi))
+                {
+                    blk->mv[MV_X] = ctx->map_mv[scup][lidx][MV_X];
+                    blk->mv[MV_Y] = ctx->map_mv[scup][lidx][MV_Y];
+                    blk->dpoc = (s8)XEVE_CLIP3(-128, 127, ctx->poc.poc_val - ctx->refp[refi][lidx].poc);
+                    break;
+                }
+            }
+        }
+    }
+
+    xeve_mset(&frm, 0, sizeof(XEVE_PASS_FRM));
+    frm.poc = ctx->poc.poc_val;
+    frm.bits = (stat->write - stat->sei_size) << 3;
+    frm.slice_type = ctx->slice_type;
+    frm.slice_depth = ctx->slice_depth;
+    frm.qp = ctx->sh->qp;
+    frm.intra_ratio = (u8)(intra_cnt * 100 / (pass->w_blk * pass->h_blk));
+
+    xeve_assert_rv(fwrite(&frm, sizeof(XEVE_PASS_FRM), 1, pass->fp) == 1, XEVE_ERR_UNKNOWN);
+    xeve_assert_rv(fwrite(pass->blk, sizeof(XEVE_PASS_BLK), pass->w_blk * pass->h_blk, pass->fp) == (size_t)(pass->w_blk * pass->h_blk), XEVE_ERR_UNKNOWN);
+
+    return XEVE_OK;
+}
+
+void xeve_pass_split_prune(XEVE_CTX * ctx, int x0, int y0, int log2_cuw, int log2_cuh, int * split_allow)
+{
+    XEVE_PASS           * pass = ctx->pass;
+    const XEVE_PASS_BLK * blk;
+    int                   x_end, y_end, i, j;
+
+    if (pass == NULL || !pass->blk_valid || !split_allow[NO_SPLIT]
+        || log2_cuw < XEVE_PASS_LOG2_BLK || log2_cuh < XEVE_PASS_LOG2_BLK)
+    {
+        return;
+    }
+
+    x_end = XEVE_MIN(pass->w_blk, (x0 + (1 << log2_cuw)) >> XEVE_PASS_LOG2_BLK);
+    y_end = XEVE_MIN(pass->h_blk, (y0 + (1 << log2_cuh)) >> XEVE_PASS_LOG2_BLK);
+    for (j = y0 >> XEVE_PASS_LOG2_BLK; j < y_end; j++)
+    {
+        blk = pass->blk + j * pass->w_blk;
+        for (i = x0 >> XEVE_PASS_LOG2_BLK; i < x_end; i++)
+        {
+            if (blk[i].intra || blk[i].log2_cuw < log2_cuw || blk[i].log2_cuh < log2_cuh)
+            {
+                return;
+            }
+        }
+    }
+
+    /* the first pass coded the whole area with inter CUs of this size or larger */
+    for (i = 1; i < MAX_SPLIT_NUM; i++)
+    {
+        split_allow[i] = 0;
+    }
+}
+
+int xeve_pass_mv_hint(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx, s16 mv[MV_D])
+{
+    const XEVE_PASS_BLK * blk;
+    int                   dpoc;
+
+    if (pi->pass_blk == NULL)
+    {
+        return 0;
+    }
+
+    /* first pass motion at the center of the CU, scaled to the reference distance */
+    blk = pi->pass_blk + ((y + (1 << (log2_cuh - 1))) >> XEVE_PASS_LOG2_BLK) * pi->pass_w_blk + ((x + (1 << (log2_cuw - 1))) >> XEVE_PASS_LOG2_BLK);
+    if (blk->dpoc == 0)
+    {
+        return 0;
+    }
+    dpoc = pi->poc - pi->refp[refi][lidx].poc;
+    mv[MV_X] = (s16)XEVE_CLIP3(SHRT_MIN, SHRT_MAX, blk->mv[MV_X] * dpoc / blk->dpoc);
+    mv[MV_Y] = (s16)XEVE_CLIP3(SHRT_MIN, SHRT_MAX, blk->mv[MV_Y] * dpoc / blk->dpoc);
+
+    return 1;
+}
@@ -0,0 +1,104 @@
+/* Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _XEVE_PASS_H_
+#define _XEVE_PASS_H_
+
+#include "xeve_def.h"
+#include "xeve_type.h"
+#include <stdio.h>
+
+/* first pass analysis is stored in blocks of 16x16 */
+#define XEVE_PASS_LOG2_BLK             4
+#define XEVE_PASS_MAGIC                0x53455658 /* XVES */
+#define XEVE_PASS_VERSION              1
+
+/*****************************************************************************
+ * statistics file layout (native byte order):
+ * XEVE_PASS_HDR, then for each picture in coding order one XEVE_PASS_FRM
+ * followed by w_blk * h_blk XEVE_PASS_BLK in raster scan order
+ *****************************************************************************/
+typedef struct _XEVE_PASS_HDR
+{
+    u32          magic;
+    u16          version;
+    u16          log2_blk;
+    u16          w;
+    u16          h;
+    u16          w_blk;
+    u16          h_blk;
+} XEVE_PASS_HDR;
+
+typedef struct _XEVE_PASS_FRM
+{
+    s32          poc;
+    /* coded bits without SEI */
+    s32          bits;
+    s8           slice_type;
+    s8           slice_depth;
+    u8           qp;
+    /* percentage of the intra coded area */
+    u8           intra_ratio;
+} XEVE_PASS_FRM;
+
+struct _XEVE_PASS_BLK
+{
+    /* motion of the CU covering the top-left sample of the block (quarter pel) */
+    s16          mv[MV_D];
+    /* POC distance to the reference picture of mv, 0 when there is no motion */
+    s8           dpoc;
+    /* intra coded CU */
+    u8           intra;
+    u8           log2_cuw;
+    u8           log2_cuh;
+};
+
+struct _XEVE_PASS
+{
+    FILE          * fp;
+    int             w_blk;
+    int             h_blk;
+    /* analysis of the current picture */
+    XEVE_PASS_BLK * blk;
+    /* second pass: blk holds the first pass analysis of the current picture */
+    int             blk_valid;
+    /* second pass: picture records of the first pass in coding order */
+    XEVE_PASS_FRM * frm;
+    int             frm_num;
+};
+
+int  xeve_pass_create(XEVE_CTX * ctx);
+void xeve_pass_delete(XEVE_CTX * ctx);
+void xeve_pass_pic_prepare(XEVE_CTX * ctx);
+int  xeve_pass_pic_finish(XEVE_CTX * ctx, XEVE_STAT * stat);
+void xeve_pass_split_prune(XEVE_CTX * ctx, int x0, int y0, int log2_cuw, int log2_cuh, int * split_allow);
+int  xeve_pass_mv_hint(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx, s16 mv[MV_D]);
+
+#endif /* _XEVE_PASS_H_ */
@@ -161,10 +161,23 @@ static void get_org_bi(pel * org, pel * pred, int s_o, int cuw, int cuh, s16 * o
     }
 }
 
+/* integer-pel SAD at (mv_x, mv_y) of the reference picture, read from its
+   8bit copy of luma when there is one */
+static u32 me_sad(XEVE_PIC *ref_pic, int mv_x, int mv_y, int log2_cuw, int log2_cuh, pel *org, int s_org, int bit_depth_luma)
+{
+    int offset = mv_x + mv_y * ref_pic->s_l;
+
+    if(ref_pic->y8)
+    {
+        return xeve_sad_8b(log2_cuw, log2_cuh, org, ref_pic->y8 + offset, s_org, ref_pic->s_l, bit_depth_luma);
+    }
+    return xeve_sad_16b(log2_cuw, log2_cuh, org, ref_pic->y + offset, s_org, ref_pic->s_l, bit_depth_luma);
+}
+
 static u32 me_raster(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx, s16 range[MV_RANGE_DIM][MV_D], s16 gmvp[MV_D], s16 mv[MV_D], int bit_depth_luma)
 {
     XEVE_PIC *ref_pic;
-    pel      *org, *ref;
+    pel      *org;
     u8        mv_bits, best_mv_bits;
     u32       cost_best, cost;
     int       i, j;
@@ -198,10 +211,9 @@ static u32 me_raster(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh,
 
             /* get MVD cost_best */
             cost = MV_COST(pi, mv_bits);
-            ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
 
             /* get sad */
-            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+            cost += me_sad(ref_pic, mv_x, mv_y, log2_cuw, log2_cuh, org, pi->s_o[Y_C], bit_depth_luma);
 
             /* check if motion cost_best is less than minimum cost_best */
             if(cost < cost_best)
@@ -243,10 +255,8 @@ static u32 me_raster(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh,
                 /* get MVD cost_best */
                 cost = MV_COST(pi, mv_bits);
 
-                ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
-
                 /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+                cost += me_sad(ref_pic, mv_x, mv_y, log2_cuw, log2_cuh, org, pi->s_o[Y_C], bit_depth_luma);
 
                 /* check if motion cost_best is less than minimum cost_best */
                 if(cost < cost_best)
@@ -274,7 +284,7 @@ static u32 me_raster(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2_cuh,
 static u32 me_ipel_refinement(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx, s16 range[MV_RANGE_DIM][MV_D], s16 gmvp[MV_D], s16 mvi[MV_D], s16 mv[MV_D], int bi, int *beststep, int faststep, int bit_depth_luma)
 {
     XEVE_PIC      *ref_pic;
-    pel           *org, *ref;
+    pel           *org;
     u32            cost, cost_best = XEVE_UINT32_MAX;
     int            mv_bits, best_mv_bits;
     s16            mv_x, mv_y, mv_best_x, mv_best_y;
@@ -323,16 +333,15 @@ static u32 me_ipel_refinement(XEVE_PINTER *pi, int x, int y, int log2_cuw, int l
             /* get MVD cost_best */
             cost = MV_COST(pi, mv_bits);
 
-            ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
             if(bi)
             {
                 /* get sad */
-                cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
+                cost += (me_sad(ref_pic, mv_x, mv_y, log2_cuw, log2_cuh, org_bi, 1 << log2_cuw, bit_depth_luma) >> 1);
             }
             else
             {
                 /* get sad */
-                cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+                cost += me_sad(ref_pic, mv_x, mv_y, log2_cuw, log2_cuh, org, pi->s_o[Y_C], bit_depth_luma);
             }
 
             /* check if motion cost_best is less than minimum cost_best */
@@ -361,7 +370,7 @@ static u32 me_ipel_refinement(XEVE_PINTER *pi, int x, int y, int log2_cuw, int l
 static u32 me_ipel_diamond(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2_cuh, s8 refi, int lidx, s16 range[MV_RANGE_DIM][MV_D], s16 gmvp[MV_D], s16 mvi[MV_D], s16 mv[MV_D], int bi, int *beststep, int faststep, int bit_depth_luma)
 {
     XEVE_PIC      *ref_pic;
-    pel           *org, *ref;
+    pel           *org;
     u32            cost, cost_best = XEVE_UINT32_MAX;
     int            mv_bits, best_mv_bits;
     s16            mv_x, mv_y, mv_best_x, mv_best_y;
@@ -425,17 +434,15 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2
                         /* get MVD cost_best */
                         cost = MV_COST(pi, mv_bits);
 
-                        ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
-
                         if(bi)
                         {
                             /* get sad */
-                            cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
+                            cost += (me_sad(ref_pic, mv_x, mv_y, log2_cuw, log2_cuh, org_bi, 1 << log2_cuw, bit_depth_luma) >> 1);
                         }
                         else
                         {
                             /* get sad */
-                            cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+                            cost += me_sad(ref_pic, mv_x, mv_y, log2_cuw, log2_cuh, org, pi->s_o[Y_C], bit_depth_luma);
                         }
 
                         /* check if motion cost_best is less than minimum cost_best */
@@ -499,16 +506,15 @@ static u32 me_ipel_diamond(XEVE_PINTER *pi, int x, int y, int log2_cuw, int log2
                     /* get MVD cost_best */
                     cost = MV_COST(pi, mv_bits);
 
-                    ref = ref_pic->y + mv_x + mv_y * ref_pic->s_l;
                     if(bi)
                     {
                         /* get sad */
-                        cost += xeve_sad_bi_16b(log2_cuw, log2_cuh, org_bi, ref, 1 << log2_cuw, ref_pic->s_l, bit_depth_luma);
+                        cost += (me_sad(ref_pic, mv_x, mv_y, log2_cuw, log2_cuh, org_bi, 1 << log2_cuw, bit_depth_luma) >> 1);
                     }
                     else
                     {
                         /* get sad */
-                        cost += xeve_sad_16b(log2_cuw, log2_cuh, org, ref, pi->s_o[Y_C], ref_pic->s_l, bit_depth_luma);
+                        cost += me_sad(ref_pic, mv_x, mv_y, log2_cuw, log2_cuh, org, pi->s_o[Y_C], bit_depth_luma);
                     }
 
                     /* check if motion cost_best is less than minimum cost_best */
@@ -685,8 +691,10 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
     s16 mvc[MV_D];  /* MV center for search */
     s16 gmvp[MV_D]; /* MVP in frame cordinate */
     s16 range[MV_RANGE_DIM][MV_D]; /* search range after clipping */
+    s16 range_h[MV_RANGE_DIM][MV_D];
     s16 mvi[MV_D];
     s16 mvt[MV_D];
+    s16 mvh[MV_D]; /* first pass motion hint */
     u32 cost, cost_best = XEVE_UINT32_MAX;
     s8 ri = 0;  /* reference buffer index */
     int tmpstep = 0;
@@ -733,6 +741,35 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
         }
     }
 
+    if(bi == BI_NON && xeve_pass_mv_hint(pi, x, y, log2_cuw, log2_cuh, ri, lidx, mvh)
+       && (abs(mvh[MV_X] - mv[MV_X]) > 4 || abs(mvh[MV_Y] - mv[MV_Y]) > 4))
+    {
+        /* refine around the first pass motion as well */
+        mvc[MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], x + (mvh[MV_X] >> 2));
+        mvc[MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], y + (mvh[MV_Y] >> 2));
+
+        get_range_ipel(pi, mvc, range_h, 0, ri, lidx);
+
+        mvi[MV_X] = mvh[MV_X] + (x << 2);
+        mvi[MV_Y] = mvh[MV_Y] + (y << 2);
+
+        cost = me_ipel_diamond(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range_h, gmvp, mvi, mvt, bi, &tmpstep, MAX_REFINE_SEARCH_STEP, bit_depth_luma);
+        if(cost < cost_best)
+        {
+            cost_best = cost;
+            mv[MV_X] = mvt[MV_X];
+            mv[MV_Y] = mvt[MV_Y];
+            if(abs(mvp[MV_X] - mv[MV_X]) < 2 && abs(mvp[MV_Y] - mv[MV_Y]) < 2)
+            {
+                beststep = 0;
+            }
+            else
+            {
+                beststep = tmpstep;
+            }
+        }
+    }
+
     if(bi == BI_NON && beststep > RASTER_SEARCH_THD  && pi->me_complexity > 1)
     {
         cost = me_raster(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range, gmvp, mvt, bit_depth_luma);
@@ -1595,6 +1632,8 @@ int xeve_pinter_init_lcu(XEVE_CTX *ctx, XEVE_CORE *core)
     pi->qp_v      = core->qp_v;
     pi->poc       = ctx->poc.poc_val;
     pi->gop_size  = ctx->param.gop_size;
+    pi->pass_blk  = (ctx->pass && ctx->pass->blk_valid) ? ctx->pass->blk : NULL;
+    pi->pass_w_blk = ctx->pass ? ctx->pass->w_blk : 0;
 
     return XEVE_OK;
 }
@@ -1664,6 +1703,26 @@ static void check_best_mvp(XEVE_CTX *ctx, XEVE_CORE *core, s32 slice_type, s8 re
     mvd[MV_Y] = mv[MV_Y] - mvp[*mvp_idx][MV_Y];
 }
 
+/* the skip mode of the largest inter CU of a static CTU is kept without further
+   RDO when the root-mean-square luma error of its prediction is below static_th */
+int xeve_pinter_static_skip(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log2_cuw, int log2_cuh)
+{
+    XEVE_PINTER *pi = &ctx->pinter[core->thread_cnt];
+    int log2_max = XEVE_MIN(ctx->log2_max_cuwh, XEVE_LOG2(ctx->param.max_cu_inter));
+    s64 ssd, th;
+
+    if(!core->ctu_static || log2_cuw != log2_max || log2_cuh != log2_max)
+    {
+        return 0;
+    }
+
+    ssd = xeve_ssd_16b(log2_cuw, log2_cuh, pi->pred[PRED_SKIP][0][Y_C], pi->o[Y_C] + x + y * pi->s_o[Y_C], 1 << log2_cuw, pi->s_o[Y_C]
+                     , ctx->sps.bit_depth_luma_minus8 + 8);
+    th = (s64)ctx->param.static_th * ctx->param.static_th;
+
+    return (ssd << 8) <= (th << (log2_cuw + log2_cuh));
+}
+
 double xeve_pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log2_cuw, int log2_cuh, XEVE_MODE *mi, s16 coef[N_C][MAX_CU_DIM], pel *rec[N_C], int s_rec[N_C])
 {
     s8 *refi;
@@ -1679,6 +1738,8 @@ double xeve_pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int
     double cost_inter[PRED_NUM];
     int lidx, pidx;
     XEVE_PINTER *pi = &ctx->pinter[core->thread_cnt];
+    int max_clip_x = pi->max_clip[MV_X];
+    int clean_w;
 
     cuw = (1 << log2_cuw);
     cuh = (1 << log2_cuh);
@@ -1703,7 +1764,10 @@ double xeve_pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int
         xeve_mcpy(pi->nnz_sub_best[PRED_SKIP], core->nnz_sub, sizeof(int) * N_C * MAX_SUB_TB_NUM);
     }
 
-    if (core->cu_mode == MODE_SKIP && pi->best_ssd >
+    /* a static CTU keeps the skip mode of its largest inter CU when it is good enough */
+    core->static_hit = cost_best < MAX_COST && xeve_pinter_static_skip(ctx, core, x, y, log2_cuw, log2_cuh);
+
+    if (!core->static_hit && core->cu_mode == MODE_SKIP && pi->best_ssd >
         ((s64)1 << (log2_cuw + log2_cuh + ctx->sps.bit_depth_luma_minus8 + ctx->sps.bit_depth_luma_minus8)) * ctx->param.skip_th)
     {
         if(pi->slice_type == SLICE_B)
@@ -1742,6 +1806,10 @@ double xeve_pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int
                 xeve_get_motion(core->scup, lidx, ctx->map_refi, ctx->map_mv, pi->refp, core->cuw, core->cuh, ctx->w_scu, core->avail_cu, pi->refi_pred[lidx], mvp);
                 mvp_idx[lidx] = pi->mvp_idx[PRED_SKIP][lidx];
 
+                /* keep the search inside the intra refreshed area of the reference */
+                clean_w = xeve_ir_ref_clean_w(ctx, core, lidx, refi_cur);
+                pi->max_clip[MV_X] = (clean_w < ctx->w) ? XEVE_MIN(max_clip_x, clean_w - cuw - 4) : max_clip_x;
+
                 /* motion search ********************/
                 mecost = pi->fn_me(pi, x, y, log2_cuw, log2_cuh, &refi_cur, lidx, mvp[mvp_idx[lidx]], mv, 0, ctx->sps.bit_depth_luma_minus8 + 8);
 
@@ -1754,6 +1822,8 @@ double xeve_pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int
                 }
             }
 
+            pi->max_clip[MV_X] = max_clip_x;
+
             refi_cur = refi_temp;
             mv[MV_X] = pi->mv_scale[lidx][refi_cur][MV_X];
             mv[MV_Y] = pi->mv_scale[lidx][refi_cur][MV_Y];
@@ -41,6 +41,7 @@ int xeve_pintra_analyze_lcu(XEVE_CTX * ctx, XEVE_CORE * core);
 double xeve_pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log2_cuw, int log2_cuh, XEVE_MODE *mi, s16 coef[N_C][MAX_CU_DIM], pel *rec[N_C], int s_rec[N_C]);
 double xeve_pintra_analyze_cu_simple(XEVE_CTX* ctx, XEVE_CORE* core, int x, int y, int log2_cuw, int log2_cuh, s16 coef[N_C][MAX_CU_DIM]);
 int    xeve_pinter_init_lcu(XEVE_CTX *ctx, XEVE_CORE *core);
+int    xeve_pinter_static_skip(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log2_cuw, int log2_cuh);
 
 /* Inter prediction */
 extern const XEVE_PRED_INTER_COMP tbl_inter_pred_comp[2];
@@ -111,6 +111,7 @@ int xeve_rc_create(XEVE_CTX * ctx)
     xeve_assert_rv(ctx->rc != NULL, XEVE_ERR_OUT_OF_MEMORY);
     xeve_mset(ctx->rc, 0, sizeof(XEVE_RC));
     xeve_rc_set(ctx);
+    ctx->rc->pass_idx = -1;
 
     /* create RCORE */
     ctx->rcore = xeve_malloc(sizeof(XEVE_RCORE));
@@ -129,6 +130,8 @@ int xeve_rc_delete(XEVE_CTX * ctx)
 {
     xeve_mfree(ctx->rcore->pred);
     xeve_mfree(ctx->rcore);
+    xeve_mfree(ctx->rc->pass_qs);
+    xeve_mfree(ctx->rc->pass_bits);
     xeve_mfree(ctx->rc);
 
     return XEVE_OK;
@@ -722,7 +725,6 @@ static double get_vbv_qfactor(XEVE_CTX *ctx, XEVE_RCORE * rcore, s32 slice_type,
     /* clip6: buffer underflow case */
     if (stype != SLICE_I)
     {
-        static s32 under_flow_cnt = 0;
         double buf_underflow;
         buf_underflow = buf_size * rc->param->vbv_buf_uf_rate - (bits + buf_full - rc->bpf);
 
@@ -730,14 +732,14 @@ static double get_vbv_qfactor(XEVE_CTX *ctx, XEVE_RCORE * rcore, s32 slice_type,
         {
             double min_under_flow;
             q_rate = bits / (buf_underflow + bits);
-            under_flow_cnt++;
-            min_under_flow = 3.0/4 - (under_flow_cnt)*0.01;
+            rc->under_flow_cnt++;
+            min_under_flow = 3.0/4 - (rc->under_flow_cnt)*0.01;
             min_under_flow = XEVE_CLIP3(0.45, 3.0/4, min_under_flow);
             q *= XEVE_CLIP3(min_under_flow, 1.0, q_rate);
         }
         else
         {
-            under_flow_cnt = 0;
+            rc->under_flow_cnt = 0;
         }
         bits = estimate_frame_bits(bit_estimator, q, rcore->cpx_frm);
     }
@@ -1113,15 +1115,143 @@ void xeve_rc_update_frame(XEVE_CTX *ctx, XEVE_RC * rc, XEVE_RCORE * rcore)
     }
 }
 
+__inline static double qp_to_qs(double qp)
+{
+    return 0.85 * pow(2.0, (qp - 12.0) / 6.0);
+}
+
+__inline static double qs_to_qp(double qs)
+{
+    return 12.0 + 6.0 * log2(qs / 0.85);
+}
+
+static int rc_pass_grp(const XEVE_PASS_FRM * frm)
+{
+    return frm->slice_type == SLICE_I ? 0 : 1 + XEVE_CLIP3(0, RC_PASS_GRP_NUM - 2, frm->slice_depth);
+}
+
+/* bits * qscale of the first pass is taken as the complexity of each picture.
+   qscale of the second pass follows complexity^(1 - qcomp) around the average
+   qscale of the picture group, scaled to spend the target bits */
+int xeve_rc_pass_plan(XEVE_CTX *ctx, const XEVE_PASS_FRM * frm, int frm_num)
+{
+    XEVE_RC * rc = ctx->rc;
+    double    log_cpx[RC_PASS_GRP_NUM] = { 0 };
+    double    log_qs[RC_PASS_GRP_NUM] = { 0 };
+    int       cnt[RC_PASS_GRP_NUM] = { 0 };
+    double    cpx, k = 0;
+    int       i, g;
+
+    if (frm_num <= 0)
+    {
+        return XEVE_OK;
+    }
+    rc->pass_qs = (double *)xeve_malloc(sizeof(double) * frm_num);
+    xeve_assert_rv(rc->pass_qs != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    rc->pass_bits = (double *)xeve_malloc(sizeof(double) * frm_num);
+    xeve_assert_rv(rc->pass_bits != NULL, XEVE_ERR_OUT_OF_MEMORY);
+
+    for (i = 0; i < frm_num; i++)
+    {
+        g = rc_pass_grp(&frm[i]);
+        cpx = XEVE_MAX(frm[i].bits, 1) * qp_to_qs(frm[i].qp);
+        log_cpx[g] += log(cpx);
+        log_qs[g] += log(qp_to_qs(frm[i].qp));
+        cnt[g]++;
+    }
+    for (g = 0; g < RC_PASS_GRP_NUM; g++)
+    {
+        if (cnt[g])
+        {
+            log_cpx[g] /= cnt[g];
+            log_qs[g] /= cnt[g];
+        }
+    }
+    for (i = 0; i < frm_num; i++)
+    {
+        g = rc_pass_grp(&frm[i]);
+        cpx = XEVE_MAX(frm[i].bits, 1) * qp_to_qs(frm[i].qp);
+        rc->pass_qs[i] = exp(log_qs[g] + (1.0 - RC_PASS_QCOMP) * (log(cpx) - log_cpx[g]));
+        k += cpx / rc->pass_qs[i];
+    }
+    k /= rc->bitrate / rc->fps * frm_num;
+    for (i = 0; i < frm_num; i++)
+    {
+        cpx = XEVE_MAX(frm[i].bits, 1) * qp_to_qs(frm[i].qp);
+        rc->pass_qs[i] *= k;
+        rc->pass_bits[i] = cpx / rc->pass_qs[i];
+    }
+    return XEVE_OK;
+}
+
+/* index of the current picture in the plan, -1 when the GOP structure
+   differs from the first pass */
+static int rc_pass_get_idx(XEVE_CTX *ctx)
+{
+    const XEVE_PASS_FRM * frm;
+
+    if (ctx->rc->pass_qs == NULL || ctx->pic_cnt >= ctx->pass->frm_num)
+    {
+        return -1;
+    }
+    frm = &ctx->pass->frm[ctx->pic_cnt];
+    if (frm->poc != ctx->poc.poc_val || frm->slice_type != ctx->slice_type)
+    {
+        return -1;
+    }
+    return ctx->pic_cnt;
+}
+
+static int rc_pass_get_frame_qp(XEVE_CTX *ctx, int idx)
+{
+    XEVE_RC * rc = ctx->rc;
+    double    buf_size, overflow, qp;
+
+    /* compensate the deviation from the plan within the buffer size */
+    buf_size = rc->vbv_buf_size > 0 ? rc->vbv_buf_size : rc->bitrate;
+    overflow = XEVE_CLIP3(0.5, 2.0, 1.0 + (rc->pass_bits_real - rc->pass_bits_exp) / buf_size);
+    qp = qs_to_qp(rc->pass_qs[idx] * overflow);
+
+    qp = XEVE_CLIP3(ctx->param.qp_min, ctx->param.qp_max, qp);
+    ctx->rcore->qp = qp;
+
+    return XEVE_CLIP3(RC_QP_MIN, RC_QP_MAX, (int)(qp + 0.5));
+}
+
+static void rc_pass_update_frame(XEVE_CTX *ctx, XEVE_RC * rc, XEVE_RCORE * rcore)
+{
+    double bits = rcore->real_bits;
+
+    if (ctx->param.use_filler) bits -= (rcore->filler_byte << 3);
+
+    rc->frame_bits += (int)bits;
+    rc->total_frames += 1;
+    rc->pass_bits_real += bits;
+    rc->pass_bits_exp += rc->pass_bits[rc->pass_idx];
+}
+
 int xeve_rc_get_qp(XEVE_CTX *ctx)
 {
     int qp;
     if (ctx->pic_cnt > 0)
     {
-        xeve_rc_update_frame(ctx, ctx->rc, ctx->rcore);
+        if (ctx->rc->pass_idx >= 0)
+        {
+            rc_pass_update_frame(ctx, ctx->rc, ctx->rcore);
+        }
+        else
+        {
+            xeve_rc_update_frame(ctx, ctx->rc, ctx->rcore);
+        }
     }
     ctx->rcore->stype = ctx->slice_type;
     ctx->rcore->sdepth = ctx->slice_depth;
+
+    ctx->rc->pass_idx = rc_pass_get_idx(ctx);
+    if (ctx->rc->pass_idx >= 0)
+    {
+        return rc_pass_get_frame_qp(ctx, ctx->rc->pass_idx);
+    }
     qp = xeve_rc_get_frame_qp(ctx);
 
     return qp;
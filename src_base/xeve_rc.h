@@ -184,6 +184,17 @@ struct _XEVE_RC
     int          encoding_mode;
     int          scene_cut;
     double       basecplx;
+    /* number of consecutive pictures estimated to underflow the vbv buffer */
+    int          under_flow_cnt;
+    /* second pass: qscale and expected bits of each picture planned from
+       the first pass statistics, NULL for one-pass rate control */
+    double     * pass_qs;
+    double     * pass_bits;
+    /* index of the planned picture being coded, -1 for one-pass rate control */
+    int          pass_idx;
+    /* expected and real bits of the planned pictures coded so far */
+    double       pass_bits_exp;
+    double       pass_bits_real;
 
     const XEVE_RC_PARAM * param;
 };
@@ -222,6 +233,11 @@ enum RC_TYPE
 #define RC_QP_MAX                   (MAX_QUANT - 1)
 #define RC_QP_MIN                   (MIN_QUANT + 1)
 
+/* curve compression of the second pass, 0: constant bits, 1: constant QP */
+#define RC_PASS_QCOMP               0.6
+/* picture groups of the second pass: I slice and slice depth 0 to 6 */
+#define RC_PASS_GRP_NUM             8
+
 // clang-format on
 
 int  xeve_rc_create(XEVE_CTX * ctx);
@@ -231,4 +247,5 @@ s32  xeve_rc_rcore_set(XEVE_CTX * ctx);
 void xeve_rc_update_frame(XEVE_CTX *ctx, XEVE_RC * rc, XEVE_RCORE * rcore);
 s32  xeve_rc_get_frame_qp(XEVE_CTX *ctx);
 int  xeve_rc_get_qp(XEVE_CTX *ctx);
+int  xeve_rc_pass_plan(XEVE_CTX *ctx, const XEVE_PASS_FRM * frm, int frm_num);
 #endif
\ No newline at end of file
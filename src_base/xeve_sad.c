@@ -33,9 +33,10 @@
 
 
 const XEVE_FN_SAD  (* xeve_func_sad)[8];
+const XEVE_FN_SAD  (* xeve_func_sad_8b)[8];
 const XEVE_FN_SSD  (* xeve_func_ssd)[8];
 const XEVE_FN_DIFF (* xeve_func_diff)[8];
-const XEVE_FN_SATD  * xeve_func_satd;
+const XEVE_FN_SATD (* xeve_func_satd)[8];
 
 /* SAD for 16bit **************************************************************/
 int sad_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
@@ -159,6 +160,128 @@ const XEVE_FN_SAD xeve_tbl_sad_16b[8][8] =
 };
 // clang-format on
 
+/* SAD of 16bit original against 8bit reference *******************************/
+int sad_8b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth)
+{
+    s16 *s1;
+    u8  *s2;
+
+    int i, j, sad;
+
+    s1 = (s16 *)src1;
+    s2 = (u8 *)src2;
+
+    sad = 0;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j++)
+        {
+            sad += XEVE_ABS16(s1[j] - (s16)s2[j]);
+        }
+        s1 += s_src1;
+        s2 += s_src2;
+    }
+
+    return (sad >> (bit_depth - 8));
+}
+
+// clang-format off
+
+/* index: [log2 of width][log2 of height] */
+const XEVE_FN_SAD xeve_tbl_sad_8b[8][8] =
+{
+    /* width == 1 */
+    {
+        sad_8b, /* height == 1 */
+        sad_8b, /* height == 2 */
+        sad_8b, /* height == 4 */
+        sad_8b, /* height == 8 */
+        sad_8b, /* height == 16 */
+        sad_8b, /* height == 32 */
+        sad_8b, /* height == 64 */
+        sad_8b, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        sad_8b, /* height == 1 */
+        sad_8b, /* height == 2 */
+        sad_8b, /* height == 4 */
+        sad_8b, /* height == 8 */
+        sad_8b, /* height == 16 */
+        sad_8b, /* height == 32 */
+        sad_8b, /* height == 64 */
+        sad_8b, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        sad_8b, /* height == 1 */
+        sad_8b, /* height == 2 */
+        sad_8b, /* height == 4 */
+        sad_8b, /* height == 8 */
+        sad_8b, /* height == 16 */
+        sad_8b, /* height == 32 */
+        sad_8b, /* height == 64 */
+        sad_8b, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        sad_8b, /* height == 1 */
+        sad_8b, /* height == 2 */
+        sad_8b, /* height == 4 */
+        sad_8b, /* height == 8 */
+        sad_8b, /* height == 16 */
+        sad_8b, /* height == 32 */
+        sad_8b, /* height == 64 */
+        sad_8b, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        sad_8b, /* height == 1 */
+        sad_8b, /* height == 2 */
+        sad_8b, /* height == 4 */
+        sad_8b, /* height == 8 */
+        sad_8b, /* height == 16 */
+        sad_8b, /* height == 32 */
+        sad_8b, /* height == 64 */
+        sad_8b, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        sad_8b, /* height == 1 */
+        sad_8b, /* height == 2 */
+        sad_8b, /* height == 4 */
+        sad_8b, /* height == 8 */
+        sad_8b, /* height == 16 */
+        sad_8b, /* height == 32 */
+        sad_8b, /* height == 64 */
+        sad_8b, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        sad_8b, /* height == 1 */
+        sad_8b, /* height == 2 */
+        sad_8b, /* height == 4 */
+        sad_8b, /* height == 8 */
+        sad_8b, /* height == 16 */
+        sad_8b, /* height == 32 */
+        sad_8b, /* height == 64 */
+        sad_8b, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        sad_8b, /* height == 1 */
+        sad_8b, /* height == 2 */
+        sad_8b, /* height == 4 */
+        sad_8b, /* height == 8 */
+        sad_8b, /* height == 16 */
+        sad_8b, /* height == 32 */
+        sad_8b, /* height == 64 */
+        sad_8b, /* height == 128 */
+    }
+};
+// clang-format on
+
 /* DIFF **********************************************************************/
 void diff_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth)
 {
@@ -1200,8 +1323,98 @@ int xeve_had(int w, int h, void *o, void *c, int s_org, int s_cur, int bit_depth
     return (sum >> (bit_depth - 8));
 }
 
+// clang-format off
+
 /* index: [log2 of width][log2 of height] */
-const XEVE_FN_SATD xeve_tbl_satd_16b[1] =
+const XEVE_FN_SATD xeve_tbl_satd_16b[8][8] =
 {
-    xeve_had,
+    /* width == 1 */
+    {
+        xeve_had, /* height == 1 */
+        xeve_had, /* height == 2 */
+        xeve_had, /* height == 4 */
+        xeve_had, /* height == 8 */
+        xeve_had, /* height == 16 */
+        xeve_had, /* height == 32 */
+        xeve_had, /* height == 64 */
+        xeve_had, /* height == 128 */
+    },
+    /* width == 2 */
+    {
+        xeve_had, /* height == 1 */
+        xeve_had, /* height == 2 */
+        xeve_had, /* height == 4 */
+        xeve_had, /* height == 8 */
+        xeve_had, /* height == 16 */
+        xeve_had, /* height == 32 */
+        xeve_had, /* height == 64 */
+        xeve_had, /* height == 128 */
+    },
+    /* width == 4 */
+    {
+        xeve_had, /* height == 1 */
+        xeve_had, /* height == 2 */
+        xeve_had, /* height == 4 */
+        xeve_had, /* height == 8 */
+        xeve_had, /* height == 16 */
+        xeve_had, /* height == 32 */
+        xeve_had, /* height == 64 */
+        xeve_had, /* height == 128 */
+    },
+    /* width == 8 */
+    {
+        xeve_had, /* height == 1 */
+        xeve_had, /* height == 2 */
+        xeve_had, /* height == 4 */
+        xeve_had, /* height == 8 */
+        xeve_had, /* height == 16 */
+        xeve_had, /* height == 32 */
+        xeve_had, /* height == 64 */
+        xeve_had, /* height == 128 */
+    },
+    /* width == 16 */
+    {
+        xeve_had, /* height == 1 */
+        xeve_had, /* height == 2 */
+        xeve_had, /* height == 4 */
+        xeve_had, /* height == 8 */
+        xeve_had, /* height == 16 */
+        xeve_had, /* height == 32 */
+        xeve_had, /* height == 64 */
+        xeve_had, /* height == 128 */
+    },
+    /* width == 32 */
+    {
+        xeve_had, /* height == 1 */
+        xeve_had, /* height == 2 */
+        xeve_had, /* height == 4 */
+        xeve_had, /* height == 8 */
+        xeve_had, /* height == 16 */
+        xeve_had, /* height == 32 */
+        xeve_had, /* height == 64 */
+        xeve_had, /* height == 128 */
+    },
+    /* width == 64 */
+    {
+        xeve_had, /* height == 1 */
+        xeve_had, /* height == 2 */
+        xeve_had, /* height == 4 */
+        xeve_had, /* height == 8 */
+        xeve_had, /* height == 16 */
+        xeve_had, /* height == 32 */
+        xeve_had, /* height == 64 */
+        xeve_had, /* height == 128 */
+    },
+    /* width == 128 */
+    {
+        xeve_had, /* height == 1 */
+        xeve_had, /* height == 2 */
+        xeve_had, /* height == 4 */
+        xeve_had, /* height == 8 */
+        xeve_had, /* height == 16 */
+        xeve_had, /* height == 32 */
+        xeve_had, /* height == 64 */
+        xeve_had, /* height == 128 */
+    }
 };
+// clang-format on
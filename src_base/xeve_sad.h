@@ -34,6 +34,7 @@
 #include "xeve_port.h"
 
 int sad_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
+int sad_8b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
 void diff_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 * diff, int bit_depth);
 s64 ssd_16b(int w, int h, void *src1, void *src2, int s_src1, int s_src2, int bit_depth);
 int xeve_had_2x2(pel *org, pel *cur, int s_org, int s_cur, int step);
@@ -44,23 +45,28 @@ typedef s64  (*XEVE_FN_SSD)  (int w, int h, void *src1, void *src2, int s_src1,
 typedef void (*XEVE_FN_DIFF) (int w, int h, void *src1, void *src2, int s_src1, int s_src2, int s_diff, s16 *diff, int bit_depth);
 
 extern const XEVE_FN_SAD  xeve_tbl_sad_16b[8][8];
+extern const XEVE_FN_SAD  xeve_tbl_sad_8b[8][8];
 extern const XEVE_FN_SSD  xeve_tbl_ssd_16b[8][8];
 extern const XEVE_FN_DIFF xeve_tbl_diff_16b[8][8];
-extern const XEVE_FN_SATD xeve_tbl_satd_16b[1];
+extern const XEVE_FN_SATD xeve_tbl_satd_16b[8][8];
 
 extern const XEVE_FN_SAD  (* xeve_func_sad)[8];
+/* SAD of 16bit samples against 8bit reference samples */
+extern const XEVE_FN_SAD  (* xeve_func_sad_8b)[8];
 extern const XEVE_FN_SSD  (* xeve_func_ssd)[8];
 extern const XEVE_FN_DIFF (* xeve_func_diff)[8];
-extern const XEVE_FN_SATD (* xeve_func_satd);
+extern const XEVE_FN_SATD (* xeve_func_satd)[8];
 
 #define xeve_sad_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
         xeve_func_sad[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define xeve_sad_bi_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
        (xeve_func_sad[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
+#define xeve_sad_8b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
+        xeve_func_sad_8b[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define xeve_satd_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
-        xeve_func_satd[0](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
+        xeve_func_satd[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define xeve_satd_bi_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
-       (xeve_func_satd[0](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
+       (xeve_func_satd[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth) >> 1)
 #define xeve_ssd_16b(log2w, log2h, src1, src2, s_src1, s_src2, bit_depth)\
         xeve_func_ssd[log2w][log2h](1<<(log2w), 1<<(log2h), src1, src2, s_src1, s_src2, bit_depth)
 #define xeve_diff_16b(log2w, log2h, src1, src2, s_src1, s_src2, s_diff, diff, bit_depth) \
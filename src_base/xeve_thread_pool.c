@@ -28,14 +28,21 @@
    POSSIBILITY OF SUCH DAMAGE.
 */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE //for pthread affinity extensions
+#endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "xeve_thread_pool.h"
 #if defined(WIN32) || defined(WIN64)
 #include <windows.h>
 #include <process.h>
 #else
 #include <pthread.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 #endif
 
 #define WINDOWS_MUTEX_SYNC 0
@@ -64,6 +71,20 @@ typedef struct _syncobject
     pthread_mutex_t lmutex;
 }THREAD_MUTEX;
 
+#if defined(__linux__)
+static void xeve_affinity_to_cpu_set(const THREAD_AFFINITY * aff, cpu_set_t * cpu_set)
+{
+    CPU_ZERO(cpu_set);
+    for (int i = 0; i < THREAD_MAX_CPU && i < CPU_SETSIZE; i++)
+    {
+        if (aff->cpu_mask[i >> 6] & (1ULL << (i & 63)))
+        {
+            CPU_SET(i, cpu_set);
+        }
+    }
+}
+#endif
+
 void * xeve_run_worker_thread(void * arg)
 {
     /********************* main routine for thread pool worker thread *************************
@@ -164,6 +185,20 @@ POOL_THREAD  xeve_create_worker_thread(THREAD_CONTROLLER * tc, int thread_id)
         goto TERROR;
     }
 
+#if defined(__linux__)
+    //pin the worker thread from its start, so that its stack and the buffers it touches first stay local
+    if (tc->affinity.cpu_cnt > 0)
+    {
+        cpu_set_t cpu_set;
+        xeve_affinity_to_cpu_set(&tc->affinity, &cpu_set);
+        result = pthread_attr_setaffinity_np(&thread_context->tAttribute, sizeof(cpu_set_t), &cpu_set);
+        if (result)
+        {
+            goto TERROR;
+        }
+    }
+#endif
+
     thread_context->task = NULL;
     thread_context->t_arg = NULL;
     thread_context->t_status = THREAD_SUSPENDED;
@@ -341,6 +376,95 @@ int threadsafe_decrement(SYNC_OBJ sobj, volatile int * pcnt)
     return temp;
 }
 
+int threadsafe_increment(SYNC_OBJ sobj, volatile int * pcnt)
+{
+    THREAD_MUTEX * imutex = (THREAD_MUTEX*)(sobj);
+    int temp = 0;
+
+    //lock the mutex, increment the count and release the mutex
+    pthread_mutex_lock(&imutex->lmutex);
+    temp = *pcnt;
+    *pcnt = ++temp;
+    pthread_mutex_unlock(&imutex->lmutex);
+
+    return temp;
+}
+
+THREAD_RESULT threadsafe_once(THREAD_ONCE * once, void (*init)(void))
+{
+    return pthread_once(once, init) ? THREAD_UNKNOWN_ERROR : THREAD_SUCCESS;
+}
+
+THREAD_RESULT get_numa_node_affinity(int node, THREAD_AFFINITY * aff)
+{
+    char path[64];
+    char cpu_list[4096];
+    FILE * fp;
+    size_t len;
+
+    if (node < 0)
+    {
+        return THREAD_INVALID_ARG;
+    }
+
+    //CPUs of a node are listed by sysfs in the same format as taskset
+    sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+    fp = fopen(path, "r");
+    if (!fp)
+    {
+        return THREAD_INVALID_ARG;
+    }
+    len = fread(cpu_list, 1, sizeof(cpu_list) - 1, fp);
+    fclose(fp);
+    cpu_list[len] = 0;
+
+    if (parse_thread_affinity(cpu_list, aff) != THREAD_SUCCESS || aff->cpu_cnt == 0)
+    {
+        return THREAD_INVALID_ARG; //node without CPU
+    }
+    return THREAD_SUCCESS;
+}
+
+THREAD_RESULT get_thread_affinity(THREAD_AFFINITY * aff)
+{
+    memset(aff, 0, sizeof(THREAD_AFFINITY));
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set))
+    {
+        return THREAD_UNKNOWN_ERROR;
+    }
+    for (int i = 0; i < THREAD_MAX_CPU && i < CPU_SETSIZE; i++)
+    {
+        if (CPU_ISSET(i, &cpu_set))
+        {
+            aff->cpu_mask[i >> 6] |= 1ULL << (i & 63);
+            aff->cpu_cnt++;
+        }
+    }
+#endif
+    return THREAD_SUCCESS;
+}
+
+THREAD_RESULT set_thread_affinity(const THREAD_AFFINITY * aff)
+{
+    if (aff->cpu_cnt == 0)
+    {
+        return THREAD_SUCCESS; //nothing to restrict
+    }
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    xeve_affinity_to_cpu_set(aff, &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set))
+    {
+        return THREAD_INVALID_ARG;
+    }
+    return THREAD_SUCCESS;
+#else
+    return THREAD_INVALID_STATE; //thread affinity is not supported on this platform
+#endif
+}
+
 #else
 typedef struct _THREAD_CTX
 {
@@ -460,6 +584,12 @@ POOL_THREAD  xeve_create_worker_thread(THREAD_CONTROLLER * tc, int thread_id)
         goto TERROR;
     }
 
+    //worker thread is waiting for its first task, pin it before it runs anything
+    if (tc->affinity.cpu_cnt > 0)
+    {
+        SetThreadAffinityMask(thread_context->t_handle, (DWORD_PTR)tc->affinity.cpu_mask[0]);
+    }
+
     //Everything created and intialized properly
     //return the created thread_context;
     return (POOL_THREAD)thread_context;
@@ -655,7 +785,566 @@ int threadsafe_decrement(SYNC_OBJ sobj, volatile int * pcnt)
 #endif
     return temp;
 }
+
+int threadsafe_increment(SYNC_OBJ sobj, volatile int * pcnt)
+{
+    THREAD_MUTEX * imutex = (THREAD_MUTEX*)(sobj);
+    int temp = 0;
+
+#if WINDOWS_MUTEX_SYNC
+    //let's lock the mutex
+    DWORD dw_wait_result = WaitForSingleObject(imutex->lmutex,INFINITE); //wait for infinite time
+
+    switch (dw_wait_result)
+    {
+        // The thread got ownership of the mutex
+    case WAIT_OBJECT_0:
+        temp = *pcnt;
+        *pcnt = ++temp;
+        // Release ownership of the mutex object
+        ReleaseMutex(imutex->lmutex);
+        break;
+        // The thread got ownership of an abandoned mutex
+        // The database is in an indeterminate state
+    case WAIT_ABANDONED:
+        temp = *pcnt;
+        temp++;
+        *pcnt = temp;
+        break;
+    }
+#else
+    EnterCriticalSection(&imutex->c_section);
+    temp = *pcnt;
+    *pcnt = ++temp;
+    LeaveCriticalSection(&imutex->c_section);
+#endif
+    return temp;
+}
+
+static BOOL CALLBACK xeve_run_once(PINIT_ONCE once, PVOID param, PVOID * context)
+{
+    ((void (*)(void))param)();
+    return TRUE;
+}
+
+THREAD_RESULT threadsafe_once(THREAD_ONCE * once, void (*init)(void))
+{
+    return InitOnceExecuteOnce((PINIT_ONCE)once, xeve_run_once, (PVOID)init, NULL) ? THREAD_SUCCESS : THREAD_UNKNOWN_ERROR;
+}
+
+//only the first processor group (64 CPUs) is handled on windows
+THREAD_RESULT get_numa_node_affinity(int node, THREAD_AFFINITY * aff)
+{
+    ULONGLONG mask = 0;
+
+    memset(aff, 0, sizeof(THREAD_AFFINITY));
+    if (node < 0 || node > 255 || !GetNumaNodeProcessorMask((UCHAR)node, &mask) || !mask)
+    {
+        return THREAD_INVALID_ARG;
+    }
+    aff->cpu_mask[0] = mask;
+    for (; mask; mask &= mask - 1)
+    {
+        aff->cpu_cnt++;
+    }
+    return THREAD_SUCCESS;
+}
+
+THREAD_RESULT get_thread_affinity(THREAD_AFFINITY * aff)
+{
+    DWORD_PTR mask_process, mask_system;
+
+    //there is no getter for a thread, the process affinity is what threads start with
+    memset(aff, 0, sizeof(THREAD_AFFINITY));
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &mask_process, &mask_system))
+    {
+        return THREAD_UNKNOWN_ERROR;
+    }
+    aff->cpu_mask[0] = mask_process;
+    for (; mask_process; mask_process &= mask_process - 1)
+    {
+        aff->cpu_cnt++;
+    }
+    return THREAD_SUCCESS;
+}
+
+THREAD_RESULT set_thread_affinity(const THREAD_AFFINITY * aff)
+{
+    if (aff->cpu_cnt == 0)
+    {
+        return THREAD_SUCCESS; //nothing to restrict
+    }
+    if (!aff->cpu_mask[0] || !SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)aff->cpu_mask[0]))
+    {
+        return THREAD_INVALID_ARG;
+    }
+    return THREAD_SUCCESS;
+}
+#endif
+
+/********************* shared pool ****************************************************************
+********************** tasks are queued per controller and the workers walk the ring of ***********
+********************** controllers, taking one task from each in turn ******************************/
+
+#if defined(WIN32) || defined(WIN64)
+typedef CRITICAL_SECTION   POOL_LOCK;
+typedef CONDITION_VARIABLE POOL_EVENT;
+typedef HANDLE             POOL_HANDLE;
+#define pool_lock(l)       EnterCriticalSection(l)
+#define pool_unlock(l)     LeaveCriticalSection(l)
+#define pool_wait(e, l)    SleepConditionVariableCS(e, l, INFINITE)
+#define pool_signal(e)     WakeConditionVariable(e)
+#define pool_broadcast(e)  WakeAllConditionVariable(e)
+#else
+typedef pthread_mutex_t    POOL_LOCK;
+typedef pthread_cond_t     POOL_EVENT;
+typedef pthread_t          POOL_HANDLE;
+#define pool_lock(l)       pthread_mutex_lock(l)
+#define pool_unlock(l)     pthread_mutex_unlock(l)
+#define pool_wait(e, l)    pthread_cond_wait(e, l)
+#define pool_signal(e)     pthread_cond_signal(e)
+#define pool_broadcast(e)  pthread_cond_broadcast(e)
+#endif
+
+typedef struct _POOL_CLIENT POOL_CLIENT;
+
+typedef struct _POOL_TASK
+{
+    POOL_CLIENT       * client;
+    THREAD_ENTRY        task;
+    void              * t_arg;
+    THREAD_STATUS       t_status; //running from the submission until the task returns
+    int                 queued; //submitted, but not picked up by any thread yet
+    int                 task_result; //value returned by the task
+    struct _POOL_TASK * next; //next queued task of the same client
+}POOL_TASK;
+
+struct _POOL_CLIENT
+{
+    THREAD_POOL * pool;
+    POOL_TASK   * head; //queued tasks in submission order
+    POOL_TASK   * tail;
+    POOL_CLIENT * next; //ring of the attached clients
+    POOL_CLIENT * prev;
+};
+
+struct _THREAD_POOL
+{
+    POOL_LOCK     lock; //guards everything below and the clients and tasks
+    POOL_EVENT    w_event; //wait event for worker threads
+    POOL_EVENT    r_event; //wait event for threads joining a task
+    POOL_CLIENT * turn; //client served next
+    int           client_cnt;
+    int           queued_cnt;
+    int           terminate;
+    int           thread_cnt;
+    POOL_HANDLE * t_handle;
+};
+
+static POOL_TASK * pool_pick_task(THREAD_POOL * pool)
+{
+    POOL_CLIENT * client = pool->turn;
+    POOL_TASK   * t;
+    int           i;
+
+    for (i = 0; i < pool->client_cnt; i++, client = client->next)
+    {
+        if (client->head)
+        {
+            t = client->head;
+            client->head = t->next;
+            if (!client->head)
+            {
+                client->tail = NULL;
+            }
+            t->queued = 0;
+            pool->queued_cnt--;
+            //the next task is taken from the next client, whoever queued more
+            pool->turn = client->next;
+            return t;
+        }
+    }
+    return NULL;
+}
+
+static void pool_run_task(THREAD_POOL * pool, POOL_TASK * t)
+{
+    //called with the lock held, the task itself runs without it
+    int res;
+
+    pool_unlock(&pool->lock);
+    res = t->task(t->t_arg);
+    pool_lock(&pool->lock);
+
+    t->task_result = res;
+    t->t_status = THREAD_SUSPENDED;
+    pool_broadcast(&pool->r_event);
+}
+
+static void pool_run_worker(THREAD_POOL * pool)
+{
+    POOL_TASK * t;
+
+    pool_lock(&pool->lock);
+    while (1)
+    {
+        while (pool->queued_cnt == 0 && !pool->terminate)
+        {
+            pool_wait(&pool->w_event, &pool->lock);
+        }
+        t = pool_pick_task(pool);
+        if (!t)
+        {
+            break; //terminated with nothing left to run
+        }
+        pool_run_task(pool, t);
+    }
+    pool_unlock(&pool->lock);
+}
+
+#if defined(WIN32) || defined(WIN64)
+static unsigned int __stdcall xeve_run_pool_thread(void * arg)
+{
+    pool_run_worker((THREAD_POOL *)arg);
+    return 0;
+}
+#else
+static void * xeve_run_pool_thread(void * arg)
+{
+    pool_run_worker((THREAD_POOL *)arg);
+    return 0;
+}
+#endif
+
+static void pool_join_threads(THREAD_POOL * pool, int thread_cnt)
+{
+    int i;
+
+    pool_lock(&pool->lock);
+    pool->terminate = 1;
+    pool_broadcast(&pool->w_event);
+    pool_unlock(&pool->lock);
+
+    for (i = 0; i < thread_cnt; i++)
+    {
+#if defined(WIN32) || defined(WIN64)
+        WaitForSingleObject(pool->t_handle[i], INFINITE);
+        CloseHandle(pool->t_handle[i]);
+#else
+        pthread_join(pool->t_handle[i], NULL);
+#endif
+    }
+}
+
+static void pool_free(THREAD_POOL * pool)
+{
+#if defined(WIN32) || defined(WIN64)
+    DeleteCriticalSection(&pool->lock);
+#else
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->w_event);
+    pthread_cond_destroy(&pool->r_event);
+#endif
+    free(pool->t_handle);
+    free(pool);
+}
+
+THREAD_POOL * create_thread_pool(int thread_cnt, const THREAD_AFFINITY * aff)
+{
+    THREAD_POOL * pool;
+    int           i;
+
+    if (thread_cnt < 1)
+    {
+        return NULL;
+    }
+
+    pool = (THREAD_POOL *)calloc(1, sizeof(THREAD_POOL));
+    if (!pool)
+    {
+        return NULL; //error management, bad alloc
+    }
+    pool->t_handle = (POOL_HANDLE *)calloc(thread_cnt, sizeof(POOL_HANDLE));
+    if (!pool->t_handle)
+    {
+        free(pool);
+        return NULL;
+    }
+
+#if defined(WIN32) || defined(WIN64)
+    InitializeCriticalSection(&pool->lock);
+    InitializeConditionVariable(&pool->w_event);
+    InitializeConditionVariable(&pool->r_event);
+#else
+    if (pthread_mutex_init(&pool->lock, NULL))
+    {
+        free(pool->t_handle);
+        free(pool);
+        return NULL;
+    }
+    pthread_cond_init(&pool->w_event, NULL);
+    pthread_cond_init(&pool->r_event, NULL);
+#endif
+
+    for (i = 0; i < thread_cnt; i++)
+    {
+#if defined(WIN32) || defined(WIN64)
+        pool->t_handle[i] = (HANDLE)_beginthreadex(NULL, 0, xeve_run_pool_thread, (void *)pool, 0, NULL);
+        if (!pool->t_handle[i])
+        {
+            break;
+        }
+        if (aff && aff->cpu_cnt > 0)
+        {
+            SetThreadAffinityMask(pool->t_handle[i], (DWORD_PTR)aff->cpu_mask[0]);
+        }
+#else
+        pthread_attr_t t_attr;
+        int            result;
+
+        pthread_attr_init(&t_attr);
+#if defined(__linux__)
+        if (aff && aff->cpu_cnt > 0)
+        {
+            cpu_set_t cpu_set;
+            xeve_affinity_to_cpu_set(aff, &cpu_set);
+            pthread_attr_setaffinity_np(&t_attr, sizeof(cpu_set_t), &cpu_set);
+        }
 #endif
+        result = pthread_create(&pool->t_handle[i], &t_attr, xeve_run_pool_thread, (void *)pool);
+        pthread_attr_destroy(&t_attr);
+        if (result)
+        {
+            break;
+        }
+#endif
+    }
+    pool->thread_cnt = i;
+
+    if (pool->thread_cnt < thread_cnt)
+    {
+        //error handling, take down the threads which are already running
+        pool_join_threads(pool, pool->thread_cnt);
+        pool_free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+THREAD_RESULT release_thread_pool(THREAD_POOL ** pool)
+{
+    THREAD_POOL * p = *pool;
+    int           client_cnt;
+
+    if (!p)
+    {
+        return THREAD_INVALID_ARG;
+    }
+
+    pool_lock(&p->lock);
+    client_cnt = p->client_cnt;
+    pool_unlock(&p->lock);
+    if (client_cnt > 0)
+    {
+        return THREAD_INVALID_STATE; //controllers would be left with tasks nobody runs
+    }
+
+    pool_join_threads(p, p->thread_cnt);
+    pool_free(p);
+    *pool = NULL;
+    return THREAD_SUCCESS;
+}
+
+static POOL_THREAD xeve_create_pool_task(THREAD_CONTROLLER * tc, int thread_id)
+{
+    POOL_TASK * t;
+
+    if (!tc || !tc->client)
+    {
+        return NULL;
+    }
+    t = (POOL_TASK *)calloc(1, sizeof(POOL_TASK));
+    if (!t)
+    {
+        return NULL;
+    }
+    t->client = (POOL_CLIENT *)tc->client;
+    t->t_status = THREAD_SUSPENDED;
+    t->task_result = THREAD_INVALID_STATE;
+    return (POOL_THREAD)t;
+}
+
+static THREAD_RESULT xeve_assign_pool_task(POOL_THREAD thread_id, THREAD_ENTRY entry, void * arg)
+{
+    POOL_TASK   * t = (POOL_TASK *)thread_id;
+    THREAD_POOL * pool;
+
+    if (!t)
+    {
+        return THREAD_INVALID_ARG;
+    }
+    pool = t->client->pool;
+
+    pool_lock(&pool->lock);
+    //a slot runs one task at a time, like a thread of its own
+    while (t->t_status == THREAD_RUNNING)
+    {
+        pool_wait(&pool->r_event, &pool->lock);
+    }
+
+    t->task = entry;
+    t->t_arg = arg;
+    t->t_status = THREAD_RUNNING;
+    t->queued = 1;
+    t->next = NULL;
+    if (t->client->tail)
+    {
+        t->client->tail->next = t;
+    }
+    else
+    {
+        t->client->head = t;
+    }
+    t->client->tail = t;
+    pool->queued_cnt++;
+    pool_signal(&pool->w_event);
+    pool_unlock(&pool->lock);
+
+    return THREAD_SUCCESS;
+}
+
+static void pool_unqueue_task(THREAD_POOL * pool, POOL_TASK * t)
+{
+    POOL_CLIENT * client = t->client;
+    POOL_TASK   * prev = NULL;
+    POOL_TASK   * cur;
+
+    for (cur = client->head; cur != t; cur = cur->next)
+    {
+        prev = cur;
+    }
+    if (prev)
+    {
+        prev->next = t->next;
+    }
+    else
+    {
+        client->head = t->next;
+    }
+    if (client->tail == t)
+    {
+        client->tail = prev;
+    }
+    t->queued = 0;
+    pool->queued_cnt--;
+}
+
+static THREAD_RESULT xeve_retrieve_pool_task(POOL_THREAD thread_id, int * res)
+{
+    POOL_TASK   * t = (POOL_TASK *)thread_id;
+    THREAD_POOL * pool;
+
+    if (!t)
+    {
+        return THREAD_INVALID_ARG;
+    }
+    pool = t->client->pool;
+
+    pool_lock(&pool->lock);
+    if (t->queued)
+    {
+        //all workers are busy, the caller would only wait, so it runs the task itself.
+        //this also keeps tasks joined from inside other tasks from waiting on each other
+        pool_unqueue_task(pool, t);
+        pool_run_task(pool, t);
+    }
+    while (t->t_status == THREAD_RUNNING)
+    {
+        pool_wait(&pool->r_event, &pool->lock);
+    }
+    *res = t->task_result;
+    pool_unlock(&pool->lock);
+
+    return THREAD_SUCCESS;
+}
+
+static THREAD_RESULT xeve_terminate_pool_task(POOL_THREAD * thread_id)
+{
+    POOL_TASK * t = (POOL_TASK *)(*thread_id);
+    int         res;
+
+    if (!t)
+    {
+        return THREAD_INVALID_ARG;
+    }
+
+    //the task may be queued or running
+    xeve_retrieve_pool_task(*thread_id, &res);
+    free(t);
+    (*thread_id) = NULL;
+    return THREAD_SUCCESS;
+}
+
+THREAD_RESULT init_shared_thread_controller(THREAD_CONTROLLER * tc, THREAD_POOL * pool, int maxtask)
+{
+    POOL_CLIENT * client;
+
+    if (!tc || !pool)
+    {
+        return THREAD_INVALID_ARG;
+    }
+    init_thread_controller(tc, maxtask);
+
+    client = (POOL_CLIENT *)calloc(1, sizeof(POOL_CLIENT));
+    if (!client)
+    {
+        return THREAD_OUT_OF_MEMORY;
+    }
+    client->pool = pool;
+
+    //join the ring just before the client served next, so that it is served last
+    pool_lock(&pool->lock);
+    if (pool->turn)
+    {
+        client->next = pool->turn;
+        client->prev = pool->turn->prev;
+        client->prev->next = client;
+        client->next->prev = client;
+    }
+    else
+    {
+        client->next = client->prev = client;
+        pool->turn = client;
+    }
+    pool->client_cnt++;
+    pool_unlock(&pool->lock);
+
+    tc->create = xeve_create_pool_task;
+    tc->run = xeve_assign_pool_task;
+    tc->join = xeve_retrieve_pool_task;
+    tc->release = xeve_terminate_pool_task;
+    tc->client = client;
+
+    return THREAD_SUCCESS;
+}
+
+static void pool_detach_client(POOL_CLIENT * client)
+{
+    THREAD_POOL * pool = client->pool;
+
+    //the tasks of the client have been released, so none of them is queued any more
+    pool_lock(&pool->lock);
+    if (pool->turn == client)
+    {
+        pool->turn = (client->next != client) ? client->next : NULL;
+    }
+    client->prev->next = client->next;
+    client->next->prev = client->prev;
+    pool->client_cnt--;
+    pool_unlock(&pool->lock);
+
+    free(client);
+}
 
 THREAD_RESULT init_thread_controller(THREAD_CONTROLLER * tc, int maxtask)
 {
@@ -667,6 +1356,8 @@ THREAD_RESULT init_thread_controller(THREAD_CONTROLLER * tc, int maxtask)
     tc->join = xeve_retrieve_thread_result;
     tc->release = xeve_terminate_worker_thread;
     tc->max_task_cnt = maxtask;
+    memset(&tc->affinity, 0, sizeof(THREAD_AFFINITY));
+    tc->client = NULL;
 
     return THREAD_SUCCESS;
 }
@@ -679,7 +1370,65 @@ THREAD_RESULT dinit_thread_controller(THREAD_CONTROLLER * tc)
     tc->join = NULL;
     tc->release = NULL;
     tc->max_task_cnt = 0;
+    if (tc->client)
+    {
+        pool_detach_client((POOL_CLIENT *)tc->client);
+        tc->client = NULL;
+    }
+
+    return THREAD_SUCCESS;
+}
 
+THREAD_RESULT parse_thread_affinity(const char * cpu_list, THREAD_AFFINITY * aff)
+{
+    const char * p = cpu_list;
+    char * end;
+    long first, last;
+
+    memset(aff, 0, sizeof(THREAD_AFFINITY));
+    if (!p)
+    {
+        return THREAD_INVALID_ARG;
+    }
+
+    while (1)
+    {
+        while (*p == ',' || *p == ' ' || *p == '\n')
+        {
+            p++;
+        }
+        if (*p == 0)
+        {
+            break;
+        }
+
+        //single CPU or range of CPUs
+        first = strtol(p, &end, 10);
+        if (end == p || first < 0 || first >= THREAD_MAX_CPU)
+        {
+            return THREAD_INVALID_ARG;
+        }
+        last = first;
+        p = end;
+        if (*p == '-')
+        {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first || last >= THREAD_MAX_CPU)
+            {
+                return THREAD_INVALID_ARG;
+            }
+            p = end;
+        }
+
+        for (; first <= last; first++)
+        {
+            if (!(aff->cpu_mask[first >> 6] & (1ULL << (first & 63))))
+            {
+                aff->cpu_mask[first >> 6] |= 1ULL << (first & 63);
+                aff->cpu_cnt++;
+            }
+        }
+    }
     return THREAD_SUCCESS;
 }
 
@@ -34,8 +34,18 @@
 typedef void* POOL_THREAD;
 typedef int (*THREAD_ENTRY) (void * arg);
 typedef struct _THREAD_CONTROLLER THREAD_CONTROLLER;
+typedef struct _THREAD_POOL THREAD_POOL;
 typedef void* SYNC_OBJ;
 
+#define THREAD_MAX_CPU 1024
+
+/* set of logical CPUs which threads are allowed to run on, no restriction when cpu_cnt is 0 */
+typedef struct _THREAD_AFFINITY
+{
+    unsigned long long cpu_mask[THREAD_MAX_CPU / 64];
+    int cpu_cnt;
+}THREAD_AFFINITY;
+
 /*****************************  Salient points  ****************************************************
 ******************************  Thread Controller object will create, run and destroy***************
 ******************************  threads. Thread Controller has to be initialised *******************
@@ -73,11 +83,32 @@ struct _THREAD_CONTROLLER
     THREAD_RESULT (*release)(POOL_THREAD *thread_id);
     //handle for mask number of allowed thread
     int max_task_cnt;
+    //CPUs worker threads are pinned to when they are created
+    THREAD_AFFINITY affinity;
+    //queue of the controller in a shared pool, NULL when the controller owns its threads
+    void * client;
 };
 
 THREAD_RESULT init_thread_controller(THREAD_CONTROLLER * tc, int maxtask);
 THREAD_RESULT dinit_thread_controller(THREAD_CONTROLLER * tc);
 
+/*** Shared pool: a fixed set of worker threads serving the tasks of several thread controllers *****
+**** create() of a shared controller returns a task slot instead of a thread, run() queues the task *
+**** and join() runs the task on the calling thread when no worker has picked it up yet. Workers   *
+**** take one task per controller in turn, so that controllers with many tasks cannot starve the  *
+**** others. The pool has to outlive all the controllers attached to it ****************************/
+
+THREAD_POOL * create_thread_pool(int thread_cnt, const THREAD_AFFINITY * aff);
+THREAD_RESULT release_thread_pool(THREAD_POOL ** pool); //fails while controllers are attached
+THREAD_RESULT init_shared_thread_controller(THREAD_CONTROLLER * tc, THREAD_POOL * pool, int maxtask);
+
+/*** CPU affinity helpers, CPU lists use the "0-7,16,18" format of taskset and sysfs *****/
+
+THREAD_RESULT parse_thread_affinity(const char * cpu_list, THREAD_AFFINITY * aff);
+THREAD_RESULT get_numa_node_affinity(int node, THREAD_AFFINITY * aff);
+THREAD_RESULT get_thread_affinity(THREAD_AFFINITY * aff); //affinity of the calling thread
+THREAD_RESULT set_thread_affinity(const THREAD_AFFINITY * aff); //pin the calling thread
+
 /*** Create a synchronization object which can be used to control race conditions across threads, synchronization object will be on encoding context*****/
 
 SYNC_OBJ get_synchronized_object();
@@ -85,6 +116,20 @@ THREAD_RESULT release_synchornized_object(SYNC_OBJ * sobj); //sync object will b
 int spinlock_wait(volatile int * addr, int val);
 void threadsafe_assign(volatile int * addr, int val);
 int threadsafe_decrement(SYNC_OBJ sobj, volatile int * pcnt);
+int threadsafe_increment(SYNC_OBJ sobj, volatile int * pcnt);
+
+/*** Run an initializer exactly once per process, e.g. to build read-only tables shared by all encoder instances *****/
+
+#if defined(WIN32) || defined(WIN64)
+typedef void* THREAD_ONCE; //storage of INIT_ONCE
+#define THREAD_ONCE_INIT NULL
+#else
+#include <pthread.h>
+typedef pthread_once_t THREAD_ONCE;
+#define THREAD_ONCE_INIT PTHREAD_ONCE_INIT
+#endif
+
+THREAD_RESULT threadsafe_once(THREAD_ONCE * once, void (*init)(void));
 
 #endif
 
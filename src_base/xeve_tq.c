@@ -396,27 +396,48 @@ static void xeve_trans(s16 * coef, int log2_cuw, int log2_cuh, int bit_depth)
     (*xeve_func_txb)[log2_cuh - 1](tb, coef, (shift1 + shift2), 1 << log2_cuw, 1);
 }
 
-void xeve_init_err_scale(XEVE_CTX * ctx)
+/* RDOQ error scales only depend on the transform and the bit depth,
+   so one table serves every encoder instance of the process */
+static s64         err_scale_tbl[2][ERR_SCALE_BIT_DEPTH_NUM][6][NUM_CU_LOG2 + 1];
+static THREAD_ONCE err_scale_once = THREAD_ONCE_INIT;
+
+static void init_err_scale_tbl(void)
 {
     double err_scale;
-    int qp;
+    int iqt, bd, qp;
     int i;
 
-    for (qp = 0; qp < 6; qp++)
+    for (iqt = 0; iqt < 2; iqt++)
     {
-        int q_value = xeve_quant_scale[ctx->param.tool_iqt][qp];
-
-        for (i = 0; i < NUM_CU_LOG2 + 1; i++)
+        for (bd = 0; bd < ERR_SCALE_BIT_DEPTH_NUM; bd++)
         {
-            int tr_shift = MAX_TX_DYNAMIC_RANGE - ctx->param.codec_bit_depth - (i + 1);
+            int bit_depth = bd + 8;
+
+            for (qp = 0; qp < 6; qp++)
+            {
+                int q_value = xeve_quant_scale[iqt][qp];
+
+                for (i = 0; i < NUM_CU_LOG2 + 1; i++)
+                {
+                    int tr_shift = MAX_TX_DYNAMIC_RANGE - bit_depth - (i + 1);
 
-            err_scale = (double)(1 << SCALE_BITS) * pow(2.0, -tr_shift);
-            err_scale = err_scale / q_value / (1 << ((ctx->param.codec_bit_depth - 8)));
-            ctx->err_scale[qp][i] = (s64)(err_scale * (double)(1 << ERR_SCALE_PRECISION_BITS));
+                    err_scale = (double)(1 << SCALE_BITS) * pow(2.0, -tr_shift);
+                    err_scale = err_scale / q_value / (1 << ((bit_depth - 8)));
+                    err_scale_tbl[iqt][bd][qp][i] = (s64)(err_scale * (double)(1 << ERR_SCALE_PRECISION_BITS));
+                }
+            }
         }
     }
 }
 
+void xeve_init_err_scale(XEVE_CTX * ctx)
+{
+    xeve_assert(ctx->param.codec_bit_depth >= 8 && ctx->param.codec_bit_depth < 8 + ERR_SCALE_BIT_DEPTH_NUM);
+
+    threadsafe_once(&err_scale_once, init_err_scale_tbl);
+    ctx->err_scale = err_scale_tbl[ctx->param.tool_iqt][ctx->param.codec_bit_depth - 8];
+}
+
 static __inline s64 get_ic_rate_cost_rl(u32 abs_level, u32 run, s32 ctx_run, u32 ctx_level, s64 lambda, XEVE_CORE * core)
 {
     s32 rate;
@@ -46,6 +46,7 @@
 /* support RDOQ */
 #define SCALE_BITS               15    /* Inherited from TMuC, pressumably for fractional bit estimates in RDOQ */
 #define ERR_SCALE_PRECISION_BITS 20
+#define ERR_SCALE_BIT_DEPTH_NUM  7     /* codec bit depth 8 to 14 */
 
 /* XEVE encoder magic code */
 #define XEVE_MAGIC_CODE      0x45565945 /* EVYE */
@@ -83,6 +84,8 @@
 
 /* maximum inbuf count */
 #define XEVE_MAX_INBUF_CNT   70
+/* number of forecast pyramid levels (half, quarter, eighth) */
+#define XEVE_FCST_LVL_MAX    3
 /* maximum cost value */
 #define MAX_COST                (1.7e+308)
 
@@ -162,6 +165,8 @@ typedef struct _XEVE_IBC_HASH XEVE_IBC_HASH;
 typedef struct _XEVE_RC_PARAM XEVE_RC_PARAM;
 typedef struct _XEVE_RCORE XEVE_RCORE;
 typedef struct _XEVE_RC XEVE_RC;
+typedef struct _XEVE_PASS XEVE_PASS;
+typedef struct _XEVE_PASS_BLK XEVE_PASS_BLK;
 
 /*****************************************************************************
  * pre-defined function structure
@@ -177,6 +182,10 @@ typedef struct _XEVE_FCST
     int                   w_blk;
     int                   h_blk;
     int                   f_blk;
+    /* pyramid level the cost maps are computed at and the coarsest level
+       seeding its motion search (1: half, 2: quarter, 3: eighth) */
+    int                   lvl;
+    int                   lvl_top;
 
 }XEVE_FCST;
 
@@ -238,6 +247,8 @@ typedef struct _XEVE_SPIC_INFO
     s8                    * map_qp_scu;
     /* lcu-tree transfer cost */
     u16                  * transfer_cost;
+    /* variance of each AQ block per plane, taken when the picture is pushed */
+    u64                  * map_aq_var[N_C];
 
 
 }XEVE_SPIC_INFO;
@@ -260,6 +271,8 @@ typedef struct _XEVE_PICO
     XEVE_SPIC_INFO      sinfo;
     /* address of sub-picture org */
     XEVE_PIC          * spic;
+    /* forecast pyramid ([0]: spic, [1]: quarter, [2]: eighth size) */
+    XEVE_PIC          * spic_pyr[XEVE_FCST_LVL_MAX];
 
 } XEVE_PICO;
 
@@ -438,6 +451,9 @@ struct _XEVE_PINTER
     int                 sps_amvr_flag;
     int                 skip_merge_cand_num;
     int                 me_complexity;
+    /* first pass analysis of the current picture, NULL if not available */
+    const XEVE_PASS_BLK * pass_blk;
+    int                 pass_w_blk;
     s64                 best_ssd;
     const s16        (* mc_l_coeff)[8];
     const s16        (* mc_c_coeff)[4];
@@ -524,6 +540,16 @@ typedef struct _XEVE_RCBE
     double       decayed;
 } XEVE_RCBE;
 
+/* values of XEVE_SBAC.is_bitcount */
+#define SBAC_BITCOUNT_OFF          0 /* write bins to the bitstream */
+#define SBAC_BITCOUNT_EXACT        1 /* count bits by running the arithmetic coder */
+#define SBAC_BITCOUNT_EST          2 /* count fractional bits from the context states */
+/* fractional precision of SBAC_BITCOUNT_EST */
+#define SBAC_EST_BITS_SHIFT        15
+
+/* log2 size in bytes of a context model group tracked by SBAC checkpoint */
+#define SBAC_CKPT_GRP_LOG2         5
+
 typedef struct _XEVE_SBAC
 {
     u32                 range;
@@ -533,12 +559,27 @@ typedef struct _XEVE_SBAC
     u32                 stacked_zero;
     u32                 pending_byte;
     u32                 is_pending_byte;
-    XEVE_SBAC_CTX       ctx;
     u32                 bitcounter;
     u8                  is_bitcount;
     u32                 bin_counter;
+    /* estimated bits in 1/32768 unit (SBAC_BITCOUNT_EST) */
+    u32                 frac_bits;
+    /* context models should be kept at the end of coding state */
+    XEVE_SBAC_CTX       ctx;
+
+    /* checkpoint information, not copied by SBAC_LOAD/SBAC_STORE.
+       when enabled, a copy from the same unchanged source only restores the
+       coding state and the context model groups touched since the last copy */
+    u8                  ckpt_on;
+    u32                 ckpt_dirty;
+    u32                 ckpt_ver;
+    struct _XEVE_SBAC * ckpt_src;
+    /* incremented whenever the context models are modified */
+    u32                 ver;
 } XEVE_SBAC;
 
+#define SBAC_STATE_SIZE            (offsetof(XEVE_SBAC, ctx) + sizeof(XEVE_SBAC_CTX))
+
 typedef struct _XEVE_DQP
 {
     s8                  prev_qp;
@@ -716,6 +757,15 @@ struct _XEVE_CORE
     u32                inter_satd;
     s32                dist_cu;
     s32                dist_cu_best; //dist of the best intra mode (note: only updated in intra coding now)
+    /* split candidates seen and pruned by the fast split prediction */
+    u32                fsplit_cand;
+    u32                fsplit_pruned;
+    /* current CTU is unchanged from the collocated one of the first reference */
+    u8                 ctu_static;
+    /* skip mode of the largest CU of a static CTU is kept without further RDO */
+    u8                 static_hit;
+    /* largest inter CUs of static CTUs coded as skip without further RDO */
+    u32                static_cu;
     u8                 deblock_is_hor;
 #if TRACE_ENC_CU_DATA
     u64  trace_idx;
@@ -747,6 +797,30 @@ struct _XEVE_CORE
     s32                rdoq_est_last[NUM_CTX_CC_LAST][2];
 };
 
+/* band of CTU rows of a picture padded by one thread, and the planes whose
+   signature the same thread computes (bit i for plane i) */
+typedef struct _XEVE_PAD_BAND
+{
+    XEVE_CTX         * ctx;
+    XEVE_PIC         * pic;
+    int                row_start;
+    int                row_end;
+    int                sign_planes;
+    /* quality metrics of the band rows, see calc_metrics */
+    int                metrics;
+    u64                sse[N_C];
+    double             ssim;
+} XEVE_PAD_BAND;
+
+/* band of luma rows of a pushed picture ingested by one thread */
+typedef struct _XEVE_INGEST_BAND
+{
+    XEVE_CTX         * ctx;
+    XEVE_IMGB        * src;
+    int                row_start;
+    int                row_end;
+} XEVE_INGEST_BAND;
+
 /******************************************************************************
  * CONTEXT used for encoding process.
  *
@@ -845,6 +919,12 @@ struct _XEVE_CTX
     XEVE_IMGB        * inbuf[XEVE_MAX_INBUF_CNT];
     /* last coded intra picture's picture order count */
     int                last_intra_poc;
+    /* CTU columns [ir_col_beg, ir_col_end) are refreshed by intra coding in
+       the current picture */
+    int                ir_col_beg;
+    int                ir_col_end;
+    /* picture order count of the first picture of the intra refresh cycle */
+    int                ir_poc_beg;
     /* maximum CU width and height */
     u16                max_cuwh;
     /* log2 of maximum CU width and height */
@@ -901,15 +981,27 @@ struct _XEVE_CTX
     XEVE_RCORE         * rcore;
     /* rate control for sequence */
     XEVE_RC          * rc;
+    /* multi-pass encoding state, NULL for single pass */
+    XEVE_PASS        * pass;
     /* temporary tile bitstream store buffer if needed */
     u8               * bs_tbuf[XEVE_MAX_NUM_TILES_ROW * XEVE_MAX_NUM_TILES_COL];
     /* bs_tbuf byte size for one tile */
     int                bs_tbuf_size;
     THREAD_CONTROLLER * tc;
     POOL_THREAD        thread_pool[XEVE_MAX_THREADS];
+    /* shared pool the tasks are queued to, NULL when the encoder has threads of its own */
+    THREAD_POOL      * pool;
+    /* CPUs the encoder threads run on, and affinity of the creating thread to restore */
+    THREAD_AFFINITY    affinity;
+    THREAD_AFFINITY    affinity_org;
     int                parallel_rows;
     volatile s32     * sync_flag;
     SYNC_OBJ           sync_block;
+    XEVE_PAD_BAND      pad_band[XEVE_MAX_THREADS];
+    /* quality metrics of the current picture gathered from the pad bands */
+    u64                metric_sse[N_C];
+    double             metric_ssim;
+    XEVE_INGEST_BAND   ingest_band[XEVE_MAX_THREADS];
     /* address of core structure */
     XEVE_CORE        * core[XEVE_MAX_THREADS];
     XEVE_BSW           bs[XEVE_MAX_THREADS];
@@ -925,7 +1017,7 @@ struct _XEVE_CTX
     int               qp_chroma_dynamic_ext[2][XEVE_MAX_QP_TABLE_SIZE_EXT];
 
     u16               split_check[SPLIT_CHECK_NUM][2];
-    s64               err_scale[6][NUM_CU_LOG2 + 1];
+    s64            (* err_scale)[NUM_CU_LOG2 + 1];
     XEVE_TS_INFO      ts_info;
 
     int   (*fn_ready)(XEVE_CTX * ctx);
@@ -1011,6 +1103,7 @@ typedef struct _ALF_SLICE_PARAM ALF_SLICE_PARAM;
 #include "xeve_fcst.h"
 #include "xeve_mode.h"
 #include "xeve_pred.h"
+#include "xeve_pass.h"
 #include "xeve_rc.h"
 #include "xeve_tq.h"
 #include "xeve_df.h"
@@ -1022,9 +1115,12 @@ typedef struct _ALF_SLICE_PARAM ALF_SLICE_PARAM;
 #include "xeve_itdq_sse.h"
 #include "xeve_itdq_avx.h"
 #include "xeve_tq_avx.h"
+#include "xeve_util_sse.h"
+#include "xeve_util_avx.h"
 #else
 #include "xeve_itdq_neon.h"
 #include "xeve_tq_neon.h"
+#include "xeve_util_neon.h"
 #endif
 #include "xeve_enc.h"
 
@@ -94,11 +94,12 @@ XEVE_PIC * xeve_picbuf_alloc(int w, int h, int pad_l, int pad_c, int bit_depth,
     pad[1] = pad_c;
     pad[2] = pad_c;
 
-    cs = XEVE_CS_SET(XEVE_CF_FROM_CFI(chroma_format_idc), bit_depth, 0);
+    /* samples are held in pels whatever the bit depth, so that 8bit planes
+       are allocated as 10bit ones and then labelled with their bit depth */
+    cs = XEVE_CS_SET(XEVE_CF_FROM_CFI(chroma_format_idc), XEVE_MAX(bit_depth, 10), 0);
     imgb = xeve_imgb_create(w, h, cs, opt, pad, align);
-    imgb->cs = XEVE_CS_SET(cs, bit_depth, 0);
-
     xeve_assert_gv(imgb != NULL, ret, XEVE_ERR_OUT_OF_MEMORY, ERR);
+    imgb->cs = XEVE_CS_SET_BIT_DEPTH(cs, bit_depth);
 
     /* set XEVE_PIC */
     pic->buf_y = imgb->baddr[0];
@@ -186,78 +187,122 @@ void xeve_picbuf_free(XEVE_PIC *pic)
         xeve_mfree(pic->map_unrefined_mv);
         xeve_mfree(pic->map_refi);
         xeve_mfree(pic->map_dqp_lah);
+        xeve_mfree(pic->buf_y8);
         xeve_mfree(pic);
     }
 }
 
-static void picbuf_expand(pel *a, int s, int w, int h, int exp)
+int xeve_picbuf_alloc_y8(XEVE_PIC *pic)
 {
-    int i, j;
-    pel pixel;
-    pel *src, *dst;
+    int size = (int)(pic->imgb->bsize[0] / sizeof(pel));
 
-    /* left */
-    src = a;
-    dst = a - exp;
+    pic->buf_y8 = xeve_malloc_fast(size);
+    xeve_assert_rv(pic->buf_y8 != NULL, XEVE_ERR_OUT_OF_MEMORY);
+    pic->y8 = pic->buf_y8 + (pic->y - pic->buf_y);
+    return XEVE_OK;
+}
 
-    for(i = 0; i < h; i++)
+/* copy n 8bit samples out of pels */
+static void picbuf_pack_y8(u8 *dst, pel *src, int n)
+{
+    int i;
+
+    for(i = 0; i < n; i++)
     {
-        pixel = *src; /* get boundary pixel */
-        for(j = 0; j < exp; j++)
-        {
-            dst[j] = pixel;
-        }
-        dst += s;
-        src += s;
+        dst[i] = (u8)src[i];
     }
+}
 
-    /* right */
-    src = a + (w - 1);
-    dst = a + w;
+/* fill n samples with one value; the bulk goes out in 128-bit stores */
+static void picbuf_fill(pel *dst, pel val, int n)
+{
+    int i = 0;
+#if X86_SSE
+    __m128i v = _mm_set1_epi16(val);
 
-    for(i = 0; i < h; i++)
+    for(; i + 8 <= n; i += 8)
     {
-        pixel = *src; /* get boundary pixel */
-        for(j = 0; j < exp; j++)
-        {
-            dst[j] = pixel;
-        }
-        dst += s;
-        src += s;
+        _mm_storeu_si128((__m128i *)(dst + i), v);
     }
+#endif
+    for(; i < n; i++)
+    {
+        dst[i] = val;
+    }
+}
 
-    /* upper */
-    src = a - exp;
-    dst = a - exp - (exp * s);
+/* pad rows [y0, y1) to the left and right, and the top and bottom borders
+   when the range includes the first or the last row */
+static void picbuf_expand(pel *a, int s, int w, int h, int y0, int y1, int exp)
+{
+    int i;
+    pel *src, *dst;
 
-    for(i = 0; i < exp; i++)
+    /* left and right */
+    for(i = y0; i < y1; i++)
     {
-        xeve_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        src = a + i * s;
+        picbuf_fill(src - exp, src[0], exp);
+        picbuf_fill(src + w, src[w - 1], exp);
     }
 
-    /* below */
-    src = a + ((h - 1)*s) - exp;
-    dst = a + ((h - 1)*s) - exp + s;
+    /* upper */
+    if(y0 == 0)
+    {
+        src = a - exp;
+        dst = a - exp - (exp * s);
 
-    for(i = 0; i < exp; i++)
+        for(i = 0; i < exp; i++)
+        {
+            xeve_mcpy(dst, src, s*sizeof(pel));
+            dst += s;
+        }
+    }
+
+    /* below */
+    if(y1 == h)
     {
-        xeve_mcpy(dst, src, s*sizeof(pel));
-        dst += s;
+        src = a + ((h - 1)*s) - exp;
+        dst = a + ((h - 1)*s) - exp + s;
+
+        for(i = 0; i < exp; i++)
+        {
+            xeve_mcpy(dst, src, s*sizeof(pel));
+            dst += s;
+        }
     }
 }
 
-
-void xeve_picbuf_expand(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc)
+void xeve_picbuf_expand_rows(XEVE_PIC *pic, int y0, int y1, int exp_l, int exp_c, int chroma_format_idc)
 {
-    picbuf_expand(pic->y, pic->s_l, pic->w_l, pic->h_l, exp_l);
+    int h_shift = XEVE_GET_CHROMA_H_SHIFT(chroma_format_idc);
+    int y0_c, y1_c;
+
+    y1 = XEVE_MIN(y1, pic->h_l);
+    picbuf_expand(pic->y, pic->s_l, pic->w_l, pic->h_l, y0, y1, exp_l);
+    if(pic->y8)
+    {
+        /* the rows with their padding, the top and bottom borders included */
+        int r0 = (y0 == 0) ? -exp_l : y0;
+        int r1 = (y1 == pic->h_l) ? pic->h_l + exp_l : y1;
+        int offset = r0 * pic->s_l - exp_l;
+
+        picbuf_pack_y8(pic->y8 + offset, pic->y + offset, (r1 - r0) * pic->s_l);
+    }
     if(chroma_format_idc)
     {
-        picbuf_expand(pic->u, pic->s_c, pic->w_c, pic->h_c, exp_c);
-        picbuf_expand(pic->v, pic->s_c, pic->w_c, pic->h_c, exp_c);
+        y0_c = y0 >> h_shift;
+        y1_c = (y1 == pic->h_l) ? pic->h_c : (y1 >> h_shift);
+        picbuf_expand(pic->u, pic->s_c, pic->w_c, pic->h_c, y0_c, y1_c, exp_c);
+        picbuf_expand(pic->v, pic->s_c, pic->w_c, pic->h_c, y0_c, y1_c, exp_c);
     }
 }
 
+void xeve_picbuf_expand(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc)
+{
+    xeve_picbuf_expand_rows(pic, 0, pic->h_l, exp_l, exp_c, chroma_format_idc);
+}
+
 void xeve_poc_derivation(XEVE_SPS sps, int tid, XEVE_POC *poc)
 {
     int sub_gop_length = (int)pow(2.0, sps.log2_sub_gop_length);
@@ -1067,21 +1112,28 @@ void xeve_md5_finish(XEVE_MD5 *md5, u8 digest[16])
     xeve_mset(md5, 0, sizeof(XEVE_MD5));
 }
 
-int xeve_md5_imgb(XEVE_IMGB *imgb, u8 digest[N_C][16])
+void xeve_md5_imgb_plane(XEVE_IMGB *imgb, int plane, u8 digest[16])
 {
-    XEVE_MD5 md5[N_C];
-    int i, j;
+    XEVE_MD5 md5;
+    int j;
 
-    for (i = 0; i < imgb->np; i++)
+    xeve_md5_init(&md5);
+
+    for (j = 0; j < imgb->ah[plane]; j++)
     {
-        xeve_md5_init(&md5[i]);
+        xeve_md5_update(&md5, ((u8 *)imgb->a[plane]) + j * imgb->s[plane], imgb->aw[plane] * 2);
+    }
 
-        for (j = 0; j < imgb->ah[i]; j++)
-        {
-            xeve_md5_update(&md5[i], ((u8 *)imgb->a[i]) + j * imgb->s[i], imgb->aw[i] * 2);
-        }
+    xeve_md5_finish(&md5, digest);
+}
 
-        xeve_md5_finish(&md5[i], digest[i]);
+int xeve_md5_imgb(XEVE_IMGB *imgb, u8 digest[N_C][16])
+{
+    int i;
+
+    for (i = 0; i < imgb->np; i++)
+    {
+        xeve_md5_imgb_plane(imgb, i, digest[i]);
     }
 
     return XEVE_OK;
@@ -1700,24 +1752,21 @@ static void imgb_cpy_shift_right(XEVE_IMGB * dst, XEVE_IMGB * src, int shift)
     }
 }
 
+/* dst is an encoder picture, held in pels whatever its bit depth */
 void xeve_imgb_cpy(XEVE_IMGB * dst, XEVE_IMGB * src)
 {
     int i, bd_src, bd_dst;
     bd_src = XEVE_CS_GET_BIT_DEPTH(src->cs);
     bd_dst = XEVE_CS_GET_BIT_DEPTH(dst->cs);
 
-    if(src->cs == dst->cs)
+    if(src->cs == dst->cs && bd_dst > 8)
     {
         imgb_cpy_plane(dst, src);
     }
-    else if(bd_src == 8 && bd_dst > 8)
+    else if(bd_src == 8 && (bd_dst > 8 || src->cs == dst->cs))
     {
         imgb_cpy_shift_left_8b(dst, src, bd_dst - bd_src);
     }
-    else if(bd_src > 8 && bd_dst == 8)
-    {
-        imgb_cpy_shift_right_8b(dst, src, bd_src - bd_dst);
-    }
     else if(bd_src < bd_dst)
     {
         imgb_cpy_shift_left(dst, src, bd_dst - bd_src);
@@ -1731,6 +1780,13 @@ void xeve_imgb_cpy(XEVE_IMGB * dst, XEVE_IMGB * src)
         xeve_trace("ERROR: unsupported image copy\n");
         return;
     }
+    xeve_imgb_cpy_info(dst, src);
+}
+
+void xeve_imgb_cpy_info(XEVE_IMGB * dst, XEVE_IMGB * src)
+{
+    int i;
+
     for(i = 0; i < XEVE_IMGB_MAX_PLANE; i++)
     {
         dst->x[i] = src->x[i];
@@ -1744,6 +1800,179 @@ void xeve_imgb_cpy(XEVE_IMGB * dst, XEVE_IMGB * src)
     }
 }
 
+/* one byte per sample copy of an 8bit encoder picture, for handing it out
+   of the encoder */
+XEVE_IMGB * xeve_imgb_create_8b(XEVE_IMGB * src)
+{
+    XEVE_IMGB * dst;
+
+    dst = xeve_imgb_create(src->aw[0], src->ah[0], src->cs, XEVE_IMGB_OPT_NONE, NULL, NULL);
+    xeve_assert_rv(dst != NULL, NULL);
+
+    imgb_cpy_shift_right_8b(dst, src, 0);
+    xeve_imgb_cpy_info(dst, src);
+    return dst;
+}
+
+XEVE_FN_INGEST xeve_func_ingest = xeve_ingest;
+
+void xeve_ingest(const void * src, int s_src, int src_8b, pel * dst, int s_dst, int w, int h, int shift, pel * sub, int s_sub, u64 * var)
+{
+    const u8  * s;
+    const u16 * d0, * d1;
+    u16       * d;
+    u32         sum, ssum;
+    int         i, j, k, bs = 1 << LOG2_AQ_BLK_SIZE;
+
+    for(i = 0; i < h; i++)
+    {
+        s = (const u8 *)src + i * s_src;
+        d = (u16 *)dst + i * s_dst;
+        for(j = 0; j < w; j++)
+        {
+            d[j] = (u16)((src_8b ? s[j] : ((const u16 *)s)[j]) << shift);
+        }
+    }
+
+    if(sub != NULL)
+    {
+        for(i = 0; i + 1 < h; i += 2)
+        {
+            d0 = (const u16 *)dst + i * s_dst;
+            d1 = d0 + s_dst;
+            for(j = 0; j < (w >> 1); j++)
+            {
+                k = j << 1;
+                sub[(i >> 1) * s_sub + j] = (pel)((d0[k] + d1[k] + d0[k + 1] + d1[k + 1] + 2) >> 2);
+            }
+        }
+    }
+
+    if(var != NULL && h == bs)
+    {
+        for(k = 0; k + bs <= w; k += bs)
+        {
+            sum = ssum = 0;
+            for(i = 0; i < bs; i++)
+            {
+                d0 = (const u16 *)dst + i * s_dst + k;
+                for(j = 0; j < bs; j++)
+                {
+                    sum += d0[j];
+                    ssum += (u32)d0[j] * d0[j];
+                }
+            }
+            var[k >> LOG2_AQ_BLK_SIZE] = (u64)ssum - (((u64)sum * sum) >> (LOG2_AQ_BLK_SIZE << 1));
+        }
+    }
+}
+
+/* the ingest kernels only widen and shift left into 16-bit samples, and
+   fill the whole allocated area of dst as xeve_imgb_cpy() would. dst is
+   held in pels whatever its bit depth */
+int xeve_imgb_ingest_check(XEVE_IMGB * dst, XEVE_IMGB * src)
+{
+    int i, bd_src, bd_dst;
+
+    bd_src = XEVE_CS_GET_BIT_DEPTH(src->cs);
+    bd_dst = XEVE_CS_GET_BIT_DEPTH(dst->cs);
+    if(bd_src > bd_dst || (bd_src == bd_dst && src->cs != dst->cs) || src->np != dst->np)
+    {
+        return 0;
+    }
+    for(i = 0; i < dst->np; i++)
+    {
+        if(src->w[i] != dst->aw[i] || src->h[i] != dst->ah[i])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ingest luma rows [y0, y1) and the matching chroma rows. y0 has to be a
+   multiple of the AQ block height in every plane. a NULL src re-reads dst in
+   place, for pictures that were copied and filtered before */
+void xeve_imgb_ingest_rows(XEVE_IMGB * dst, XEVE_IMGB * src, int y0, int y1, pel * sub, int s_sub, u64 * map_var[N_C])
+{
+    const u8 * s;
+    int        i, y, ys, ye, h_shift, bs, src_8b, shift, s_src, w_blk;
+
+    bs = 1 << LOG2_AQ_BLK_SIZE;
+    src_8b = src != NULL && XEVE_CS_GET_BYTE_DEPTH(src->cs) == 1;
+    if(src == NULL)
+    {
+        src = dst;
+    }
+    shift = XEVE_CS_GET_BIT_DEPTH(dst->cs) - XEVE_CS_GET_BIT_DEPTH(src->cs);
+
+    for(i = 0; i < dst->np; i++)
+    {
+        h_shift = (dst->h[0] == dst->h[i]) ? 0 : 1;
+        ys = y0 >> h_shift;
+        ye = (y1 >= dst->h[0]) ? dst->h[i] : (y1 >> h_shift);
+        s_src = src->s[i];
+        w_blk = dst->w[i] >> LOG2_AQ_BLK_SIZE;
+
+        for(y = ys; y < ye; y += bs)
+        {
+            s = (const u8 *)src->a[i] + y * s_src;
+            xeve_func_ingest(s, s_src, src_8b, (pel *)dst->a[i] + y * (dst->s[i] >> 1), dst->s[i] >> 1, dst->w[i], XEVE_MIN(bs, ye - y), shift,
+                             (i == 0 && sub != NULL) ? sub + (y >> 1) * s_sub : NULL, s_sub,
+                             (map_var != NULL) ? map_var[i] + (y >> LOG2_AQ_BLK_SIZE) * w_blk : NULL);
+        }
+    }
+}
+
+XEVE_FN_SSE xeve_func_sse = xeve_sse;
+XEVE_FN_SSIM_4X4 xeve_func_ssim_4x4 = xeve_ssim_4x4;
+
+u64 xeve_sse(const pel * src1, int s_src1, const pel * src2, int s_src2, int w, int h)
+{
+    u64 sse = 0;
+    s32 d;
+    int i, j;
+
+    for(i = 0; i < h; i++)
+    {
+        for(j = 0; j < w; j++)
+        {
+            d = src1[j] - src2[j];
+            sse += (u32)(d * d);
+        }
+        src1 += s_src1;
+        src2 += s_src2;
+    }
+    return sse;
+}
+
+void xeve_ssim_4x4(const pel * org, int s_org, const pel * rec, int s_rec, int w, s32 (*sums)[4])
+{
+    s32 a, b, s1, s2, ss, s12;
+    int i, j, k;
+
+    for(k = 0; k + 4 <= w; k += 4)
+    {
+        s1 = s2 = ss = s12 = 0;
+        for(i = 0; i < 4; i++)
+        {
+            for(j = 0; j < 4; j++)
+            {
+                a = org[i * s_org + k + j];
+                b = rec[i * s_rec + k + j];
+                s1 += a;
+                s2 += b;
+                ss += a * a + b * b;
+                s12 += a * b;
+            }
+        }
+        sums[k >> 2][0] = s1;
+        sums[k >> 2][1] = s2;
+        sums[k >> 2][2] = ss;
+        sums[k >> 2][3] = s12;
+    }
+}
+
 XEVE_IMGB * xeve_imgb_create(int w, int h, int cs, int opt, int pad[XEVE_IMGB_MAX_PLANE], int align[XEVE_IMGB_MAX_PLANE])
 {
     int i, p_size, a_size;
@@ -1843,7 +2072,10 @@ static unsigned long long __xgetbv(unsigned int i)
 #endif
 #define GET_CPU_INFO(A,B) ((B[((A >> 5) & 0x03)] >> (A & 0x1f)) & 1)
 
-int xeve_check_cpu_info()
+static THREAD_ONCE cpu_info_once = THREAD_ONCE_INIT;
+static int         cpu_info_flags;
+
+static void check_cpu_info(void)
 {
     int support_sse  = 0;
     int support_avx  = 0;
@@ -1871,7 +2103,13 @@ int xeve_check_cpu_info()
         }
     }
 
-    return (support_sse << 1) | support_avx | (support_avx2 << 2);
+    cpu_info_flags = (support_sse << 1) | support_avx | (support_avx2 << 2);
+}
+
+int xeve_check_cpu_info()
+{
+    threadsafe_once(&cpu_info_once, check_cpu_info);
+    return cpu_info_flags;
 }
 #endif
 
@@ -1916,30 +2154,114 @@ void xeve_update_core_loc_param_mt(XEVE_CTX * ctx, XEVE_CORE * core)
     core->y_scu = core->y_lcu << (MAX_CU_LOG2 - MIN_CU_LOG2); // set y_scu location
 }
 
-int xeve_mt_get_next_ctu_num(XEVE_CTX * ctx, XEVE_CORE * core, int skip_ctb_line_cnt)
+/* claim the next CTU row of a tile for the calling thread, and return the
+   core of its row lane (row % parallel_rows) placed at the first CTU of the
+   row, or NULL when all rows are taken. the lane core, its entropy coder and
+   QP predictor carry over from row to row as with a fixed row per thread, so
+   the output does not depend on which thread takes a row. rows complete in
+   order, so the previous row of a lane is done once its next row is claimed */
+XEVE_CORE * xeve_mt_claim_row(XEVE_CTX * ctx, XEVE_TILE * tile)
 {
-    int sp_x_lcu = ctx->tile[core->tile_num].ctba_rs_first % ctx->w_lcu;
-    int sp_y_lcu = ctx->tile[core->tile_num].ctba_rs_first / ctx->w_lcu;
-    core->x_lcu = (core->lcu_num) % ctx->w_lcu; //entry point lcu's x location
+    XEVE_CORE * core;
+    int         row;
 
-    /* check to move next ctb line */
-    core->x_lcu++;
-    if (core->x_lcu == sp_x_lcu + ctx->tile[core->tile_num].w_ctb)
+    row = threadsafe_increment(ctx->sync_block, &tile->next_row) - 1;
+    if (row >= tile->h_ctb)
     {
-        core->x_lcu = sp_x_lcu;
-        core->y_lcu += skip_ctb_line_cnt;
+        return NULL;
     }
-
+    core = ctx->core[tile->core_base + row % tile->parallel_rows];
+    core->x_lcu = tile->ctba_rs_first % ctx->w_lcu;
+    core->y_lcu = tile->ctba_rs_first / ctx->w_lcu + row;
     core->lcu_num = core->y_lcu * ctx->w_lcu + core->x_lcu;
-    /* check to exceed height of ctb line */
-    if (core->y_lcu >= sp_y_lcu + ctx->tile[core->tile_num].h_ctb)
+    xeve_update_core_loc_param_mt(ctx, core);
+
+    return core;
+}
+
+void xeve_pic_progress_reset(XEVE_PIC * pic)
+{
+    threadsafe_assign(&pic->rows_recon, 0);
+    threadsafe_assign(&pic->rows_filtered, 0);
+    threadsafe_assign(&pic->rows_padded, 0);
+}
+
+void xeve_pic_progress_ctu_done(XEVE_CTX * ctx, XEVE_CORE * core)
+{
+    /* CTU rows of a single tile complete in order as the wavefront keeps
+       each row behind the one above. with several tiles, rows are reported
+       once the whole picture is reconstructed */
+    if (ctx->tile_cnt == 1 && (core->lcu_num % ctx->w_lcu) == ctx->w_lcu - 1)
     {
-        return -1;
+        threadsafe_assign(&PIC_CURR(ctx)->rows_recon, core->lcu_num / ctx->w_lcu + 1);
     }
+}
 
-    xeve_update_core_loc_param_mt(ctx, core);
+void xeve_pic_progress_wait(volatile s32 * rows_done, int rows)
+{
+    while (*rows_done < rows)
+    {
+        /* busy waiting like spinlock_wait() */
+    }
+}
+
+/* wait for the rows of the reference pictures the motion of the current CTU can reach */
+void xeve_refp_wait_lcu(XEVE_CTX * ctx, XEVE_CORE * core)
+{
+    int i, j, rows, y_max;
+
+    if (ctx->slice_type == SLICE_I)
+    {
+        return;
+    }
+
+    /* search range around the CTU, plus interpolation taps and refinement */
+    y_max = ((core->y_lcu + 1) << ctx->log2_max_cuwh) + ctx->param.me_range + XEVE_PIC_PROGRESS_MARGIN;
+    rows = XEVE_MIN((y_max + ctx->max_cuwh - 1) >> ctx->log2_max_cuwh, (int)ctx->h_lcu);
+
+    for (i = 0; i < (ctx->slice_type == SLICE_B ? REFP_NUM : 1); i++)
+    {
+        for (j = 0; j < ctx->rpm.num_refp[i]; j++)
+        {
+            if (ctx->refp[j][i].pic != NULL)
+            {
+                xeve_pic_progress_wait(&ctx->refp[j][i].pic->rows_padded, rows);
+            }
+        }
+    }
+}
+
+/* width of the reference picture area that the current CTU can predict from
+   without breaking intra refresh. CTUs on the left of the refresh column are
+   clean, so they can only use the area refreshed in the same cycle */
+int xeve_ir_ref_clean_w(XEVE_CTX * ctx, XEVE_CORE * core, int lidx, int refi)
+{
+    XEVE_REFP * refp = &ctx->refp[refi][lidx];
 
-    return core->lcu_num;
+    if (!ctx->param.intra_refresh || core->x_lcu >= ctx->ir_col_beg)
+    {
+        return ctx->w;
+    }
+    return ((int)refp->poc < ctx->ir_poc_beg) ? 0 : refp->pic->ir_clean_w;
+}
+
+int xeve_ir_check_motion(XEVE_CTX * ctx, XEVE_CORE * core, int x, int cuw, s8 refi[REFP_NUM], s16 mv[REFP_NUM][MV_D])
+{
+    int lidx, clean_w;
+
+    for (lidx = 0; lidx < REFP_NUM; lidx++)
+    {
+        if (REFI_IS_VALID(refi[lidx]))
+        {
+            clean_w = xeve_ir_ref_clean_w(ctx, core, lidx, refi[lidx]);
+            /* 4 samples on the right are read by the interpolation filters */
+            if (clean_w < ctx->w && x + cuw + (mv[lidx][MV_X] >> 2) + 4 > clean_w)
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
 }
 
 int xeve_malloc_1d(void** dst, int size)
@@ -92,7 +92,9 @@ u16  xeve_get_avail_inter(int x_scu, int y_scu, int w_scu, int h_scu, int scup,
 u16  xeve_get_avail_intra(int x_scu, int y_scu, int w_scu, int h_scu, int scup, int log2_cuw, int log2_cuh, u32 *map_scu, u8* map_tidx);
 XEVE_PIC* xeve_picbuf_alloc(int w, int h, int pad_l, int pad_c, int bit_depth, int *err, int chroma_format_idc);
 void xeve_picbuf_free(XEVE_PIC *pic);
+int xeve_picbuf_alloc_y8(XEVE_PIC *pic);
 void xeve_picbuf_expand(XEVE_PIC *pic, int exp_l, int exp_c, int chroma_format_idc);
+void xeve_picbuf_expand_rows(XEVE_PIC *pic, int y0, int y1, int exp_l, int exp_c, int chroma_format_idc);
 void xeve_poc_derivation(XEVE_SPS sps, int tid, XEVE_POC *poc);
 void xeve_picbuf_rc_free(XEVE_PIC *pic);
 void xeve_check_motion_availability(int scup, int cuw, int cuh, int w_scu, int h_scu, int neb_addr[MAX_NUM_POSSIBLE_SCAND], int valid_flag[MAX_NUM_POSSIBLE_SCAND], u32 *map_scu, u16 avail_lr, int num_mvp, int is_ibc, u8 * map_tidx);
@@ -146,6 +148,7 @@ void xeve_md5_init(XEVE_MD5 * md5);
 void xeve_md5_update(XEVE_MD5 * md5, void * buf, u32 len);
 void xeve_md5_update_16(XEVE_MD5 * md5, void * buf, u32 len);
 void xeve_md5_finish(XEVE_MD5 * md5, u8 digest[16]);
+void xeve_md5_imgb_plane(XEVE_IMGB * imgb, int plane, u8 digest[16]);
 int  xeve_md5_imgb(XEVE_IMGB * imgb, u8 digest[N_C][16]);
 int  xeve_picbuf_signature(XEVE_PIC * pic, u8 md5_out[N_C][16]);
 int  xeve_atomic_inc(volatile int * pcnt);
@@ -173,7 +176,29 @@ BOOL xeve_signal_mode_cons(TREE_CONS* parent, TREE_CONS* cur_split);
 #define XEVE_IMGB_OPT_NONE                 (0)
 XEVE_IMGB * xeve_imgb_create(int w, int h, int cs, int opt, int pad[XEVE_IMGB_MAX_PLANE], int align[XEVE_IMGB_MAX_PLANE]);
 void xeve_imgb_cpy(XEVE_IMGB * dst, XEVE_IMGB * src);
+XEVE_IMGB * xeve_imgb_create_8b(XEVE_IMGB * src);
+void xeve_imgb_cpy_info(XEVE_IMGB * dst, XEVE_IMGB * src);
+
+/* copy up to 1 << LOG2_AQ_BLK_SIZE rows of a plane with a left shift, writing
+   the 2x2 averaged sub-picture rows and the variance of each full AQ block
+   on the way. sub and var may be NULL */
+typedef void (*XEVE_FN_INGEST)(const void * src, int s_src, int src_8b, pel * dst, int s_dst, int w, int h, int shift, pel * sub, int s_sub, u64 * var);
+extern XEVE_FN_INGEST xeve_func_ingest;
+void xeve_ingest(const void * src, int s_src, int src_8b, pel * dst, int s_dst, int w, int h, int shift, pel * sub, int s_sub, u64 * var);
+int  xeve_imgb_ingest_check(XEVE_IMGB * dst, XEVE_IMGB * src);
+void xeve_imgb_ingest_rows(XEVE_IMGB * dst, XEVE_IMGB * src, int y0, int y1, pel * sub, int s_sub, u64 * map_var[N_C]);
 void xeve_imgb_garbage_free(XEVE_IMGB * imgb);
+
+/* sum of squared differences of two sample blocks, without normalization
+   to 8-bit */
+typedef u64 (*XEVE_FN_SSE)(const pel * src1, int s_src1, const pel * src2, int s_src2, int w, int h);
+extern XEVE_FN_SSE xeve_func_sse;
+u64 xeve_sse(const pel * src1, int s_src1, const pel * src2, int s_src2, int w, int h);
+/* sums of org, rec, org^2 + rec^2 and org * rec over each 4x4 block of a
+   row of w / 4 blocks, for SSIM */
+typedef void (*XEVE_FN_SSIM_4X4)(const pel * org, int s_org, const pel * rec, int s_rec, int w, s32 (*sums)[4]);
+extern XEVE_FN_SSIM_4X4 xeve_func_ssim_4x4;
+void xeve_ssim_4x4(const pel * org, int s_org, const pel * rec, int s_rec, int w, s32 (*sums)[4]);
 #define XEVE_CPU_INFO_SSE2     0x7A // ((3 << 5) | 26)
 #define XEVE_CPU_INFO_SSE3     0x40 // ((2 << 5) |  0)
 #define XEVE_CPU_INFO_SSSE3    0x49 // ((2 << 5) |  9)
@@ -187,7 +212,13 @@ int  xeve_check_cpu_info();
 void xeve_copy_chroma_qp_mapping_params(XEVE_CHROMA_TABLE *dst, XEVE_CHROMA_TABLE *src);
 void xeve_update_core_loc_param(XEVE_CTX * ctx, XEVE_CORE * core);
 void xeve_update_core_loc_param_mt(XEVE_CTX * ctx, XEVE_CORE * core);
-int  xeve_mt_get_next_ctu_num(XEVE_CTX * ctx, XEVE_CORE * core, int skip_ctb_line_cnt);
+XEVE_CORE * xeve_mt_claim_row(XEVE_CTX * ctx, XEVE_TILE * tile);
+void xeve_pic_progress_reset(XEVE_PIC * pic);
+void xeve_pic_progress_ctu_done(XEVE_CTX * ctx, XEVE_CORE * core);
+void xeve_pic_progress_wait(volatile s32 * rows_done, int rows);
+void xeve_refp_wait_lcu(XEVE_CTX * ctx, XEVE_CORE * core);
+int  xeve_ir_ref_clean_w(XEVE_CTX * ctx, XEVE_CORE * core, int lidx, int refi);
+int  xeve_ir_check_motion(XEVE_CTX * ctx, XEVE_CORE * core, int x, int cuw, s8 refi[REFP_NUM], s16 mv[REFP_NUM][MV_D]);
 int  xeve_create_cu_data(XEVE_CU_DATA *cu_data, int log2_cuw, int log2_cuh, int chroma_format_idc);
 int  xeve_delete_cu_data(XEVE_CU_DATA *cu_data, int log2_cuw, int log2_cuh);
 void xeve_set_tile_in_slice(XEVE_CTX * ctx);
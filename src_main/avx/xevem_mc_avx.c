@@ -0,0 +1,305 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "xeve_def.h"
+#include "xevem_mc.h"
+#include "xevem_mc_sse.h"
+#include "xevem_mc_avx.h"
+
+#if X86_SSE
+/****************************************************************************
+ * enhanced interpolation filter (EIF) for affine motion compensation
+ ****************************************************************************/
+/* one bilinear sample of the C code, used for the columns left over by the
+   8-sample loop */
+static __inline pel eif_bilinear_sample(pel *p_ref, int ref_stride, int x, int y, int mv_x, int mv_y, int shift1, int shift2, int offset2)
+{
+    const int frac_mask = (1 << EIF_MV_PRECISION_BILINEAR) - 1;
+    pel *r = p_ref + (y + (mv_y >> EIF_MV_PRECISION_BILINEAR)) * ref_stride + x + (mv_x >> EIF_MV_PRECISION_BILINEAR);
+    pel s1 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[mv_x & frac_mask], r[0], r[1], 0, shift1);
+    pel s2 = MAC_BL_NN_S1(tbl_bl_eif_32_phases_mc_l_coeff[mv_x & frac_mask], r[ref_stride], r[ref_stride + 1], 0, shift1);
+
+    return MAC_BL_NN_S2(tbl_bl_eif_32_phases_mc_l_coeff[mv_y & frac_mask], s1, s2, offset2, shift2);
+}
+
+/* per-sample MVs of eight neighbouring samples are interpolated in 32-bit
+   lanes; the two reference samples of each filter row are fetched by one
+   32-bit gather, which keeps them as the 16-bit pair madd expects */
+static void eif_bilinear_avx(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], int mv_max[MV_D], int mv_min[MV_D]
+                           , pel* p_ref, int ref_stride, pel* p_dst, int dst_stride, int bit_depth)
+{
+    const int mv_shift = EIF_MV_PRECISION_INTERNAL - EIF_MV_PRECISION_BILINEAR;
+    const int shift1 = XEVE_MIN(4, bit_depth - 8);
+    const int shift2 = XEVE_MAX(8, 20 - bit_depth);
+    const int offset2 = (1 << (shift2 - 1));
+    const int width = block_width + 2;
+    const int w_simd = width & ~7;
+    const int *tbl = (const int *)tbl_bl_eif_32_phases_mc_l_coeff;
+    int line[MV_D] = {mv0[MV_X] - d_x[MV_X] - d_y[MV_X], mv0[MV_Y] - d_x[MV_Y] - d_y[MV_Y]}; //set to pos (-1, -1)
+    __m256i m_ramp, m_ramp_x, m_ramp_y, m_step_x, m_step_y, m_max_x, m_max_y, m_min_x, m_min_y;
+    __m256i m_frac, m_stride, m_off2, mvx, mvy, mx, my, pos, off, r0, r1, cx, cy, s1, s2;
+    __m128i m_shift1, m_shift2;
+    int x, y;
+
+    m_ramp   = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    m_ramp_x = _mm256_mullo_epi32(m_ramp, _mm256_set1_epi32(d_x[MV_X]));
+    m_ramp_y = _mm256_mullo_epi32(m_ramp, _mm256_set1_epi32(d_x[MV_Y]));
+    m_step_x = _mm256_set1_epi32(d_x[MV_X] << 3);
+    m_step_y = _mm256_set1_epi32(d_x[MV_Y] << 3);
+    m_frac   = _mm256_set1_epi32((1 << EIF_MV_PRECISION_BILINEAR) - 1);
+    m_stride = _mm256_set1_epi32(ref_stride);
+    m_off2   = _mm256_set1_epi32(offset2);
+    m_shift1 = _mm_cvtsi32_si128(shift1);
+    m_shift2 = _mm_cvtsi32_si128(shift2);
+    m_max_x  = _mm256_set1_epi32(mv_max ? mv_max[MV_X] : 0);
+    m_max_y  = _mm256_set1_epi32(mv_max ? mv_max[MV_Y] : 0);
+    m_min_x  = _mm256_set1_epi32(mv_min ? mv_min[MV_X] : 0);
+    m_min_y  = _mm256_set1_epi32(mv_min ? mv_min[MV_Y] : 0);
+
+    for(y = -1; y <= block_height; ++y, p_dst += dst_stride, line[MV_X] += d_y[MV_X], line[MV_Y] += d_y[MV_Y])
+    {
+        mvx = _mm256_add_epi32(_mm256_set1_epi32(line[MV_X]), m_ramp_x);
+        mvy = _mm256_add_epi32(_mm256_set1_epi32(line[MV_Y]), m_ramp_y);
+        pos = _mm256_add_epi32(_mm256_set1_epi32(y * ref_stride - 1), m_ramp);
+
+        for(x = 0; x < w_simd; x += 8)
+        {
+            mx = _mm256_srai_epi32(mvx, mv_shift);
+            my = _mm256_srai_epi32(mvy, mv_shift);
+            if(mv_max)
+            {
+                mx = _mm256_max_epi32(m_min_x, _mm256_min_epi32(m_max_x, mx));
+                my = _mm256_max_epi32(m_min_y, _mm256_min_epi32(m_max_y, my));
+            }
+
+            off = _mm256_add_epi32(pos, _mm256_srai_epi32(mx, EIF_MV_PRECISION_BILINEAR));
+            off = _mm256_add_epi32(off, _mm256_mullo_epi32(_mm256_srai_epi32(my, EIF_MV_PRECISION_BILINEAR), m_stride));
+
+            r0 = _mm256_i32gather_epi32((const int *)p_ref, off, 2);
+            r1 = _mm256_i32gather_epi32((const int *)(p_ref + ref_stride), off, 2);
+            cx = _mm256_i32gather_epi32(tbl, _mm256_and_si256(mx, m_frac), 4);
+            cy = _mm256_i32gather_epi32(tbl, _mm256_and_si256(my, m_frac), 4);
+
+            s1 = _mm256_sra_epi32(_mm256_madd_epi16(r0, cx), m_shift1);
+            s2 = _mm256_sra_epi32(_mm256_madd_epi16(r1, cx), m_shift1);
+            /* the 16-bit pair truncates s1 and s2 to pel as the C code does */
+            s1 = _mm256_blend_epi16(s1, _mm256_slli_epi32(s2, 16), 0xAA);
+            s1 = _mm256_sra_epi32(_mm256_add_epi32(_mm256_madd_epi16(s1, cy), m_off2), m_shift2);
+            s1 = _mm256_permute4x64_epi64(_mm256_packs_epi32(s1, s1), 0x08);
+            _mm_storeu_si128((__m128i *)(p_dst + x), _mm256_castsi256_si128(s1));
+
+            mvx = _mm256_add_epi32(mvx, m_step_x);
+            mvy = _mm256_add_epi32(mvy, m_step_y);
+            pos = _mm256_add_epi32(pos, _mm256_set1_epi32(8));
+        }
+
+        for(; x < width; x++)
+        {
+            int mv_x = (line[MV_X] + x * d_x[MV_X]) >> mv_shift;
+            int mv_y = (line[MV_Y] + x * d_x[MV_Y]) >> mv_shift;
+
+            if(mv_max)
+            {
+                mv_x = XEVE_CLIP3(mv_min[MV_X], mv_max[MV_X], mv_x);
+                mv_y = XEVE_CLIP3(mv_min[MV_Y], mv_max[MV_Y], mv_y);
+            }
+            p_dst[x] = eif_bilinear_sample(p_ref, ref_stride, x - 1, y, mv_x, mv_y, shift1, shift2, offset2);
+        }
+    }
+}
+
+void xevem_eif_bilinear_clip_avx(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], int mv_max[MV_D], int mv_min[MV_D]
+                               , pel* p_ref, int ref_stride, pel* p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth)
+{
+    /* intermediate samples of more than 12-bit input overflow 16-bit */
+    if(EIF_MV_PRECISION_BILINEAR != 5 || bit_depth > 12)
+    {
+        xeve_eif_bilinear_clip(block_width, block_height, mv0, d_x, d_y, mv_max, mv_min, p_ref, ref_stride, p_dst, dst_stride, shifts, offsets, bit_depth);
+        return;
+    }
+    eif_bilinear_avx(block_width, block_height, mv0, d_x, d_y, mv_max, mv_min, p_ref, ref_stride, p_dst, dst_stride, bit_depth);
+}
+
+void xevem_eif_bilinear_no_clip_avx(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], pel* p_ref, int ref_stride
+                                  , pel* p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth)
+{
+    if(EIF_MV_PRECISION_BILINEAR != 5 || bit_depth > 12)
+    {
+        xeve_eif_bilinear_no_clip(block_width, block_height, mv0, d_x, d_y, p_ref, ref_stride, p_dst, dst_stride, shifts, offsets, bit_depth);
+        return;
+    }
+    eif_bilinear_avx(block_width, block_height, mv0, d_x, d_y, NULL, NULL, p_ref, ref_stride, p_dst, dst_stride, bit_depth);
+}
+
+/* (-a + 10 * b - c + offset) >> shift of sixteen samples, truncated to pel */
+static __inline __m256i eif_3tap_avx(pel *a, pel *b, pel *c, __m256i offset, __m128i shift)
+{
+    __m256i v[2];
+    int i;
+
+    for(i = 0; i < 2; i++)
+    {
+        __m256i ma = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(a + (i << 3))));
+        __m256i mb = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(b + (i << 3))));
+        __m256i mc = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(c + (i << 3))));
+
+        mb = _mm256_add_epi32(_mm256_slli_epi32(mb, 3), _mm256_slli_epi32(mb, 1));
+        v[i] = _mm256_sra_epi32(_mm256_add_epi32(_mm256_sub_epi32(mb, _mm256_add_epi32(ma, mc)), offset), shift);
+        v[i] = _mm256_srai_epi32(_mm256_slli_epi32(v[i], 16), 16);
+    }
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(v[0], v[1]), 0xD8);
+}
+
+void xevem_eif_filter_avx(int block_width, int block_height, pel* p_tmp_buf, int tmp_buf_stride, pel *p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth)
+{
+    const int w_simd = block_width & ~15;
+    const pel max_val = (1 << bit_depth) - 1;
+    __m256i m_off, m_min, m_max;
+    __m128i m_shift;
+    pel *p_buf;
+    int x, y;
+
+    /* horizontal pass in place: each output only overwrites its own left
+       input, which the loads of the next 16 samples do not touch */
+    m_off = _mm256_set1_epi32(offsets[2]);
+    m_shift = _mm_cvtsi32_si128(shifts[2]);
+    p_buf = p_tmp_buf;
+
+    for(y = 0; y <= block_height + 1; ++y, p_buf += tmp_buf_stride)
+    {
+        for(x = 0; x < w_simd; x += 16)
+        {
+            _mm256_storeu_si256((__m256i *)(p_buf + x), eif_3tap_avx(p_buf + x, p_buf + x + 1, p_buf + x + 2, m_off, m_shift));
+        }
+        for(; x < block_width; x++)
+        {
+            p_buf[x] = (-p_buf[x] + (p_buf[x + 1] * 10) - p_buf[x + 2] + offsets[2]) >> shifts[2];
+        }
+    }
+
+    m_off = _mm256_set1_epi32(offsets[3]);
+    m_shift = _mm_cvtsi32_si128(shifts[3]);
+    m_min = _mm256_setzero_si256();
+    m_max = _mm256_set1_epi16(max_val);
+    p_buf = p_tmp_buf + tmp_buf_stride;
+
+    for(y = 0; y < block_height; ++y, p_buf += tmp_buf_stride, p_dst += dst_stride)
+    {
+        for(x = 0; x < w_simd; x += 16)
+        {
+            __m256i res = eif_3tap_avx(p_buf + x - tmp_buf_stride, p_buf + x, p_buf + x + tmp_buf_stride, m_off, m_shift);
+            _mm256_storeu_si256((__m256i *)(p_dst + x), _mm256_min_epi16(_mm256_max_epi16(res, m_min), m_max));
+        }
+        for(; x < block_width; x++)
+        {
+            pel res = (-p_buf[x - tmp_buf_stride] + (p_buf[x] * 10) - p_buf[x + tmp_buf_stride] + offsets[3]) >> shifts[3];
+            p_dst[x] = XEVE_CLIP3(0, max_val, res);
+        }
+    }
+}
+
+/****************************************************************************
+ * DMVR bilateral cost
+ ****************************************************************************/
+static __inline __m256i dmvr_sad_16pel_avx(pel *s1, pel *s2)
+{
+    __m256i d = _mm256_sub_epi16(_mm256_loadu_si256((__m256i *)s1), _mm256_loadu_si256((__m256i *)s2));
+
+    return _mm256_madd_epi16(_mm256_abs_epi16(d), _mm256_set1_epi16(1));
+}
+
+static __inline s32 dmvr_sad_sum_avx(__m256i sad)
+{
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sad), _mm256_extracti128_si256(sad, 1));
+
+    s = _mm_add_epi32(s, _mm_unpackhi_epi64(s, s));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x55));
+    return _mm_cvtsi128_si32(s);
+}
+
+s32 xevem_dmvr_cost_avx(int w, int h, pel *src1, pel *src2, int s_src1, int s_src2)
+{
+    __m256i sad = _mm256_setzero_si256();
+    int i, j;
+
+    if(w & 15)
+    {
+        return xevem_dmvr_cost_sse(w, h, src1, src2, s_src1, s_src2);
+    }
+
+    for(i = 0; i < h; i++, src1 += s_src1, src2 += s_src2)
+    {
+        for(j = 0; j < w; j += 16)
+        {
+            sad = _mm256_add_epi32(sad, dmvr_sad_16pel_avx(src1 + j, src2 + j));
+        }
+    }
+    return dmvr_sad_sum_avx(sad);
+}
+
+void xevem_dmvr_cross_cost_avx(int w, int h, pel *ref_l0, int s_ref_l0, pel *ref_l1, int s_ref_l1, s32 *cost)
+{
+    __m256i sad[4];
+    int i, j;
+
+    if(w & 15)
+    {
+        xevem_dmvr_cross_cost_sse(w, h, ref_l0, s_ref_l0, ref_l1, s_ref_l1, cost);
+        return;
+    }
+
+    sad[0] = sad[1] = sad[2] = sad[3] = _mm256_setzero_si256();
+
+    for(i = 0; i < h; i++, ref_l0 += s_ref_l0, ref_l1 += s_ref_l1)
+    {
+        for(j = 0; j < w; j += 16)
+        {
+            pel *p0 = ref_l0 + j;
+            pel *p1 = ref_l1 + j;
+
+            sad[SAD_BOTTOM] = _mm256_add_epi32(sad[SAD_BOTTOM], dmvr_sad_16pel_avx(p0 + s_ref_l0, p1 - s_ref_l1));
+            sad[SAD_TOP]    = _mm256_add_epi32(sad[SAD_TOP],    dmvr_sad_16pel_avx(p0 - s_ref_l0, p1 + s_ref_l1));
+            sad[SAD_RIGHT]  = _mm256_add_epi32(sad[SAD_RIGHT],  dmvr_sad_16pel_avx(p0 + 1, p1 - 1));
+            sad[SAD_LEFT]   = _mm256_add_epi32(sad[SAD_LEFT],   dmvr_sad_16pel_avx(p0 - 1, p1 + 1));
+        }
+    }
+
+    for(i = SAD_BOTTOM; i <= SAD_LEFT; i++)
+    {
+        cost[i] = dmvr_sad_sum_avx(sad[i]);
+    }
+}
+#endif /* X86_SSE */
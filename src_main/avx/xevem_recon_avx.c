@@ -0,0 +1,154 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_def.h"
+#include "xevem_recon.h"
+#include "xevem_recon_sse.h"
+#include "xevem_recon_avx.h"
+
+#if X86_SSE
+/* +-tbl(abs(z)) for abs(z) < thr, otherwise z (see read_table() of C code) */
+static __inline __m256i htdf_read_table_avx(__m256i z, __m256i tbl, __m256i thr, __m256i rnd, __m128i shift)
+{
+    __m256i sg  = _mm256_srai_epi16(z, 15);
+    __m256i v   = _mm256_abs_epi16(z);
+    __m256i idx = _mm256_srl_epi16(_mm256_and_si256(_mm256_add_epi16(v, rnd), thr), shift);
+    /* upper byte of index has MSB set to be zeroed by the shuffle */
+    __m256i w   = _mm256_shuffle_epi8(tbl, _mm256_or_si256(idx, _mm256_set1_epi16((s16)0x8000)));
+
+    w = _mm256_blendv_epi8(v, w, _mm256_cmpgt_epi16(thr, v));
+    return _mm256_xor_si256(_mm256_add_epi16(w, sg), sg);
+}
+
+void xevem_htdf_filter_block_avx(pel *block, pel *acc_block, const u8 *tbl, int stride_block, int stride_acc, int width, int height, int tbl_thr_log2, int bit_depth)
+{
+    const int table_shift = tbl_thr_log2 - HTDF_LUT_SIZE_LOG2;
+    const int table_round = (1 << table_shift) >> 1;
+    const int thr = (1 << tbl_thr_log2) - (1 << table_shift);
+    const int w_simd = ((width - 1) >> 4) << 4;
+    __m256i m_tbl, m_thr, m_rnd, m_max, m_zero, m_cnt_rnd;
+    __m128i m_shift;
+    __m256i x0, x1, x2, x3, y0, y1, y2, y3, t0, t1, t2, t3, z1, z2, z3;
+    __m256i a0, a1, a2, a3, prev1, prev3, o0, o2;
+    pel *in, *out;
+    int r, c;
+
+    /* transform coefficients of more than 10-bit samples overflow 16-bit */
+    if(bit_depth > 10)
+    {
+        xeve_htdf_filter_block(block, acc_block, tbl, stride_block, stride_acc, width, height, tbl_thr_log2, bit_depth);
+        return;
+    }
+    if(w_simd == 0)
+    {
+        xevem_htdf_filter_block_sse(block, acc_block, tbl, stride_block, stride_acc, width, height, tbl_thr_log2, bit_depth);
+        return;
+    }
+
+    /* shuffle works in 128-bit lanes, so each lane has the whole table */
+    m_tbl     = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)tbl));
+    m_thr     = _mm256_set1_epi16(thr);
+    m_rnd     = _mm256_set1_epi16(table_round);
+    m_shift   = _mm_cvtsi32_si128(table_shift);
+    m_max     = _mm256_set1_epi16((1 << bit_depth) - 1);
+    m_zero    = _mm256_setzero_si256();
+    m_cnt_rnd = _mm256_set1_epi16(HTDF_CNT_SCALE_RND);
+
+    for(r = 0; r < height - 1; r++)
+    {
+        in  = block + r * stride_block;
+        out = acc_block + r * stride_acc;
+        prev1 = prev3 = m_zero;
+
+        for(c = 0; c < w_simd; c += 16)
+        {
+            x0 = _mm256_loadu_si256((__m256i *)(in + c));
+            x1 = _mm256_loadu_si256((__m256i *)(in + c + 1));
+            x2 = _mm256_loadu_si256((__m256i *)(in + stride_block + c));
+            x3 = _mm256_loadu_si256((__m256i *)(in + stride_block + c + 1));
+
+            /* forward transform */
+            y0 = _mm256_add_epi16(x0, x2);
+            y1 = _mm256_add_epi16(x1, x3);
+            y2 = _mm256_sub_epi16(x0, x2);
+            y3 = _mm256_sub_epi16(x1, x3);
+
+            t0 = _mm256_add_epi16(y0, y1);
+            t1 = _mm256_sub_epi16(y0, y1);
+            t2 = _mm256_add_epi16(y2, y3);
+            t3 = _mm256_sub_epi16(y2, y3);
+
+            /* filtering, DC is skipped */
+            z1 = htdf_read_table_avx(t1, m_tbl, m_thr, m_rnd, m_shift);
+            z2 = htdf_read_table_avx(t2, m_tbl, m_thr, m_rnd, m_shift);
+            z3 = htdf_read_table_avx(t3, m_tbl, m_thr, m_rnd, m_shift);
+
+            /* backward transform */
+            y0 = _mm256_add_epi16(t0, z2);
+            y1 = _mm256_add_epi16(z1, z3);
+            y2 = _mm256_sub_epi16(t0, z2);
+            y3 = _mm256_sub_epi16(z1, z3);
+
+            a0 = _mm256_srai_epi16(_mm256_add_epi16(y0, y1), HTDF_BIT_RND4);
+            a1 = _mm256_srai_epi16(_mm256_sub_epi16(y0, y1), HTDF_BIT_RND4);
+            a2 = _mm256_srai_epi16(_mm256_add_epi16(y2, y3), HTDF_BIT_RND4);
+            a3 = _mm256_srai_epi16(_mm256_sub_epi16(y2, y3), HTDF_BIT_RND4);
+
+            /* right samples of each window go to the next column */
+            o0 = _mm256_loadu_si256((__m256i *)(out + c));
+            o2 = _mm256_loadu_si256((__m256i *)(out + stride_acc + c));
+            o0 = _mm256_add_epi16(o0, _mm256_add_epi16(a0, _mm256_alignr_epi8(a1, _mm256_permute2x128_si256(prev1, a1, 0x21), 14)));
+            o2 = _mm256_add_epi16(o2, _mm256_add_epi16(a2, _mm256_alignr_epi8(a3, _mm256_permute2x128_si256(prev3, a3, 0x21), 14)));
+            _mm256_storeu_si256((__m256i *)(out + c), o0);
+            _mm256_storeu_si256((__m256i *)(out + stride_acc + c), o2);
+            prev1 = a1;
+            prev3 = a3;
+
+            /* normalization, accumulation of these samples is done */
+            o0 = _mm256_srai_epi16(_mm256_add_epi16(o0, m_cnt_rnd), HTDF_CNT_SCALE);
+            o0 = _mm256_min_epi16(_mm256_max_epi16(o0, m_zero), m_max);
+            _mm256_storeu_si256((__m256i *)(in + c), o0);
+        }
+        out[w_simd] += (pel)_mm256_extract_epi16(prev1, 15);
+        out[stride_acc + w_simd] += (pel)_mm256_extract_epi16(prev3, 15);
+    }
+
+    /* remaining windows only touch samples right of the ones done above */
+    if(w_simd < width - 1)
+    {
+        xevem_htdf_filter_block_sse(block + w_simd, acc_block + w_simd, tbl, stride_block, stride_acc, width - w_simd, height, tbl_thr_log2, bit_depth);
+    }
+}
+#endif /* X86_SSE */
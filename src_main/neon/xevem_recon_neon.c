@@ -0,0 +1,146 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_def.h"
+#include "xevem_recon.h"
+#include "xevem_recon_neon.h"
+
+#if ARM_NEON
+/* +-tbl(abs(z)) for abs(z) < thr, otherwise z (see read_table() of C code) */
+static __inline int16x8_t htdf_read_table_neon(int16x8_t z, uint8x16_t tbl, int16x8_t thr, int16x8_t rnd, int16x8_t shift)
+{
+    int16x8_t  sg  = vshrq_n_s16(z, 15);
+    int16x8_t  v   = vabsq_s16(z);
+    uint16x8_t idx = vshlq_u16(vreinterpretq_u16_s16(vandq_s16(vaddq_s16(v, rnd), thr)), shift);
+    /* upper byte of index is out of the table to be zeroed by the lookup */
+    int16x8_t  w   = vreinterpretq_s16_u8(vqtbl1q_u8(tbl, vreinterpretq_u8_u16(vorrq_u16(idx, vdupq_n_u16(0x8000)))));
+
+    w = vbslq_s16(vcltq_s16(v, thr), w, v);
+    return veorq_s16(vaddq_s16(w, sg), sg);
+}
+
+void xevem_htdf_filter_block_neon(pel *block, pel *acc_block, const u8 *tbl, int stride_block, int stride_acc, int width, int height, int tbl_thr_log2, int bit_depth)
+{
+    const int table_shift = tbl_thr_log2 - HTDF_LUT_SIZE_LOG2;
+    const int table_round = (1 << table_shift) >> 1;
+    const int thr = (1 << tbl_thr_log2) - (1 << table_shift);
+    const int w_simd = ((width - 1) >> 3) << 3;
+    uint8x16_t m_tbl;
+    int16x8_t m_thr, m_rnd, m_shift, m_max, m_zero;
+    int16x8_t x0, x1, x2, x3, y0, y1, y2, y3, t0, t1, t2, t3, z1, z2, z3;
+    int16x8_t a0, a1, a2, a3, prev1, prev3, o0, o2;
+    pel *in, *out;
+    int r, c;
+
+    /* transform coefficients of more than 10-bit samples overflow 16-bit */
+    if(bit_depth > 10 || w_simd == 0)
+    {
+        xeve_htdf_filter_block(block, acc_block, tbl, stride_block, stride_acc, width, height, tbl_thr_log2, bit_depth);
+        return;
+    }
+
+    m_tbl   = vld1q_u8(tbl);
+    m_thr   = vdupq_n_s16(thr);
+    m_rnd   = vdupq_n_s16(table_round);
+    m_shift = vdupq_n_s16(-table_shift);
+    m_max   = vdupq_n_s16((1 << bit_depth) - 1);
+    m_zero  = vdupq_n_s16(0);
+
+    for(r = 0; r < height - 1; r++)
+    {
+        in  = block + r * stride_block;
+        out = acc_block + r * stride_acc;
+        prev1 = prev3 = m_zero;
+
+        for(c = 0; c < w_simd; c += 8)
+        {
+            x0 = vld1q_s16(in + c);
+            x1 = vld1q_s16(in + c + 1);
+            x2 = vld1q_s16(in + stride_block + c);
+            x3 = vld1q_s16(in + stride_block + c + 1);
+
+            /* forward transform */
+            y0 = vaddq_s16(x0, x2);
+            y1 = vaddq_s16(x1, x3);
+            y2 = vsubq_s16(x0, x2);
+            y3 = vsubq_s16(x1, x3);
+
+            t0 = vaddq_s16(y0, y1);
+            t1 = vsubq_s16(y0, y1);
+            t2 = vaddq_s16(y2, y3);
+            t3 = vsubq_s16(y2, y3);
+
+            /* filtering, DC is skipped */
+            z1 = htdf_read_table_neon(t1, m_tbl, m_thr, m_rnd, m_shift);
+            z2 = htdf_read_table_neon(t2, m_tbl, m_thr, m_rnd, m_shift);
+            z3 = htdf_read_table_neon(t3, m_tbl, m_thr, m_rnd, m_shift);
+
+            /* backward transform */
+            y0 = vaddq_s16(t0, z2);
+            y1 = vaddq_s16(z1, z3);
+            y2 = vsubq_s16(t0, z2);
+            y3 = vsubq_s16(z1, z3);
+
+            a0 = vshrq_n_s16(vaddq_s16(y0, y1), HTDF_BIT_RND4);
+            a1 = vshrq_n_s16(vsubq_s16(y0, y1), HTDF_BIT_RND4);
+            a2 = vshrq_n_s16(vaddq_s16(y2, y3), HTDF_BIT_RND4);
+            a3 = vshrq_n_s16(vsubq_s16(y2, y3), HTDF_BIT_RND4);
+
+            /* right samples of each window go to the next column */
+            o0 = vld1q_s16(out + c);
+            o2 = vld1q_s16(out + stride_acc + c);
+            o0 = vaddq_s16(o0, vaddq_s16(a0, vextq_s16(prev1, a1, 7)));
+            o2 = vaddq_s16(o2, vaddq_s16(a2, vextq_s16(prev3, a3, 7)));
+            vst1q_s16(out + c, o0);
+            vst1q_s16(out + stride_acc + c, o2);
+            prev1 = a1;
+            prev3 = a3;
+
+            /* normalization, accumulation of these samples is done */
+            o0 = vshrq_n_s16(vaddq_s16(o0, vdupq_n_s16(HTDF_CNT_SCALE_RND)), HTDF_CNT_SCALE);
+            o0 = vminq_s16(vmaxq_s16(o0, m_zero), m_max);
+            vst1q_s16(in + c, o0);
+        }
+        out[w_simd] += vgetq_lane_s16(prev1, 7);
+        out[stride_acc + w_simd] += vgetq_lane_s16(prev3, 7);
+    }
+
+    /* remaining windows only touch samples right of the ones done above */
+    if(w_simd < width - 1)
+    {
+        xeve_htdf_filter_block(block + w_simd, acc_block + w_simd, tbl, stride_block, stride_acc, width - w_simd, height, tbl_thr_log2, bit_depth);
+    }
+}
+#endif /* ARM_NEON */
@@ -1524,3 +1524,73 @@ void xevem_equal_coeff_computer_sse(pel *residue, int residue_stride, int **deri
         }
     }
 }
+
+/****************************************************************************
+ * DMVR bilateral cost
+ ****************************************************************************/
+static __inline __m128i dmvr_sad_8pel_sse(__m128i s1, __m128i s2)
+{
+    return _mm_madd_epi16(_mm_abs_epi16(_mm_sub_epi16(s1, s2)), _mm_set1_epi16(1));
+}
+
+static __inline s32 dmvr_sad_sum_sse(__m128i sad)
+{
+    sad = _mm_add_epi32(sad, _mm_unpackhi_epi64(sad, sad));
+    sad = _mm_add_epi32(sad, _mm_shuffle_epi32(sad, 0x55));
+    return _mm_cvtsi128_si32(sad);
+}
+
+s32 xevem_dmvr_cost_sse(int w, int h, pel *src1, pel *src2, int s_src1, int s_src2)
+{
+    __m128i sad = _mm_setzero_si128();
+    int i, j;
+
+    if(w & 7)
+    {
+        return xeve_dmvr_cost(w, h, src1, src2, s_src1, s_src2);
+    }
+
+    for(i = 0; i < h; i++, src1 += s_src1, src2 += s_src2)
+    {
+        for(j = 0; j < w; j += 8)
+        {
+            sad = _mm_add_epi32(sad, dmvr_sad_8pel_sse(_mm_loadu_si128((__m128i *)(src1 + j)), _mm_loadu_si128((__m128i *)(src2 + j))));
+        }
+    }
+    return dmvr_sad_sum_sse(sad);
+}
+
+/* costs of the four cross positions, indexed by SAD_BOTTOM..SAD_LEFT, in one
+   pass over the two predictions; list 1 moves opposite to list 0 */
+void xevem_dmvr_cross_cost_sse(int w, int h, pel *ref_l0, int s_ref_l0, pel *ref_l1, int s_ref_l1, s32 *cost)
+{
+    __m128i sad[4];
+    int i, j;
+
+    if(w & 7)
+    {
+        xeve_dmvr_cross_cost(w, h, ref_l0, s_ref_l0, ref_l1, s_ref_l1, cost);
+        return;
+    }
+
+    sad[0] = sad[1] = sad[2] = sad[3] = _mm_setzero_si128();
+
+    for(i = 0; i < h; i++, ref_l0 += s_ref_l0, ref_l1 += s_ref_l1)
+    {
+        for(j = 0; j < w; j += 8)
+        {
+            pel *p0 = ref_l0 + j;
+            pel *p1 = ref_l1 + j;
+
+            sad[SAD_BOTTOM] = _mm_add_epi32(sad[SAD_BOTTOM], dmvr_sad_8pel_sse(_mm_loadu_si128((__m128i *)(p0 + s_ref_l0)), _mm_loadu_si128((__m128i *)(p1 - s_ref_l1))));
+            sad[SAD_TOP]    = _mm_add_epi32(sad[SAD_TOP],    dmvr_sad_8pel_sse(_mm_loadu_si128((__m128i *)(p0 - s_ref_l0)), _mm_loadu_si128((__m128i *)(p1 + s_ref_l1))));
+            sad[SAD_RIGHT]  = _mm_add_epi32(sad[SAD_RIGHT],  dmvr_sad_8pel_sse(_mm_loadu_si128((__m128i *)(p0 + 1)), _mm_loadu_si128((__m128i *)(p1 - 1))));
+            sad[SAD_LEFT]   = _mm_add_epi32(sad[SAD_LEFT],   dmvr_sad_8pel_sse(_mm_loadu_si128((__m128i *)(p0 - 1)), _mm_loadu_si128((__m128i *)(p1 + 1))));
+        }
+    }
+
+    for(i = SAD_BOTTOM; i <= SAD_LEFT; i++)
+    {
+        cost[i] = dmvr_sad_sum_sse(sad[i]);
+    }
+}
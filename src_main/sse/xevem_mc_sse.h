@@ -45,6 +45,8 @@ extern const XEVEM_MC xeve_tbl_bl_mc_l_sse[2][2];
 void xevem_scaled_horizontal_sobel_filter_sse(pel *pred, int pred_stride, int *derivate, int derivate_buf_stride, int width, int height);
 void xevem_scaled_vertical_sobel_filter_sse(pel *pred, int pred_stride, int *derivate, int derivate_buf_stride, int width, int height);
 void xevem_equal_coeff_computer_sse(pel *residue, int residue_stride, int **derivate, int derivate_buf_stride, s64(*equal_coeff)[7], int width, int height, int vertex_num);
+s32  xevem_dmvr_cost_sse(int w, int h, pel *src1, pel *src2, int s_src1, int s_src2);
+void xevem_dmvr_cross_cost_sse(int w, int h, pel *ref_l0, int s_ref_l0, pel *ref_l1, int s_ref_l1, s32 *cost);
 #endif /* X86_SSE */
 
 #endif /* _XEVEM_MC_SSE_H_ */
@@ -0,0 +1,146 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xeve_def.h"
+#include "xevem_recon.h"
+#include "xevem_recon_sse.h"
+
+#if X86_SSE
+/* +-tbl(abs(z)) for abs(z) < thr, otherwise z (see read_table() of C code) */
+static __inline __m128i htdf_read_table_sse(__m128i z, __m128i tbl, __m128i thr, __m128i rnd, __m128i shift)
+{
+    __m128i sg  = _mm_srai_epi16(z, 15);
+    __m128i v   = _mm_abs_epi16(z);
+    __m128i idx = _mm_srl_epi16(_mm_and_si128(_mm_add_epi16(v, rnd), thr), shift);
+    /* upper byte of index has MSB set to be zeroed by the shuffle */
+    __m128i w   = _mm_shuffle_epi8(tbl, _mm_or_si128(idx, _mm_set1_epi16((s16)0x8000)));
+
+    w = _mm_blendv_epi8(v, w, _mm_cmpgt_epi16(thr, v));
+    return _mm_xor_si128(_mm_add_epi16(w, sg), sg);
+}
+
+void xevem_htdf_filter_block_sse(pel *block, pel *acc_block, const u8 *tbl, int stride_block, int stride_acc, int width, int height, int tbl_thr_log2, int bit_depth)
+{
+    const int table_shift = tbl_thr_log2 - HTDF_LUT_SIZE_LOG2;
+    const int table_round = (1 << table_shift) >> 1;
+    const int thr = (1 << tbl_thr_log2) - (1 << table_shift);
+    const int w_simd = ((width - 1) >> 3) << 3;
+    __m128i m_tbl, m_thr, m_rnd, m_shift, m_max, m_zero, m_cnt_rnd;
+    __m128i x0, x1, x2, x3, y0, y1, y2, y3, t0, t1, t2, t3, z1, z2, z3;
+    __m128i a0, a1, a2, a3, prev1, prev3, o0, o2;
+    pel *in, *out;
+    int r, c;
+
+    /* transform coefficients of more than 10-bit samples overflow 16-bit */
+    if(bit_depth > 10 || w_simd == 0)
+    {
+        xeve_htdf_filter_block(block, acc_block, tbl, stride_block, stride_acc, width, height, tbl_thr_log2, bit_depth);
+        return;
+    }
+
+    m_tbl     = _mm_loadu_si128((const __m128i *)tbl);
+    m_thr     = _mm_set1_epi16(thr);
+    m_rnd     = _mm_set1_epi16(table_round);
+    m_shift   = _mm_cvtsi32_si128(table_shift);
+    m_max     = _mm_set1_epi16((1 << bit_depth) - 1);
+    m_zero    = _mm_setzero_si128();
+    m_cnt_rnd = _mm_set1_epi16(HTDF_CNT_SCALE_RND);
+
+    for(r = 0; r < height - 1; r++)
+    {
+        in  = block + r * stride_block;
+        out = acc_block + r * stride_acc;
+        prev1 = prev3 = m_zero;
+
+        for(c = 0; c < w_simd; c += 8)
+        {
+            x0 = _mm_loadu_si128((__m128i *)(in + c));
+            x1 = _mm_loadu_si128((__m128i *)(in + c + 1));
+            x2 = _mm_loadu_si128((__m128i *)(in + stride_block + c));
+            x3 = _mm_loadu_si128((__m128i *)(in + stride_block + c + 1));
+
+            /* forward transform */
+            y0 = _mm_add_epi16(x0, x2);
+            y1 = _mm_add_epi16(x1, x3);
+            y2 = _mm_sub_epi16(x0, x2);
+            y3 = _mm_sub_epi16(x1, x3);
+
+            t0 = _mm_add_epi16(y0, y1);
+            t1 = _mm_sub_epi16(y0, y1);
+            t2 = _mm_add_epi16(y2, y3);
+            t3 = _mm_sub_epi16(y2, y3);
+
+            /* filtering, DC is skipped */
+            z1 = htdf_read_table_sse(t1, m_tbl, m_thr, m_rnd, m_shift);
+            z2 = htdf_read_table_sse(t2, m_tbl, m_thr, m_rnd, m_shift);
+            z3 = htdf_read_table_sse(t3, m_tbl, m_thr, m_rnd, m_shift);
+
+            /* backward transform */
+            y0 = _mm_add_epi16(t0, z2);
+            y1 = _mm_add_epi16(z1, z3);
+            y2 = _mm_sub_epi16(t0, z2);
+            y3 = _mm_sub_epi16(z1, z3);
+
+            a0 = _mm_srai_epi16(_mm_add_epi16(y0, y1), HTDF_BIT_RND4);
+            a1 = _mm_srai_epi16(_mm_sub_epi16(y0, y1), HTDF_BIT_RND4);
+            a2 = _mm_srai_epi16(_mm_add_epi16(y2, y3), HTDF_BIT_RND4);
+            a3 = _mm_srai_epi16(_mm_sub_epi16(y2, y3), HTDF_BIT_RND4);
+
+            /* right samples of each window go to the next column */
+            o0 = _mm_loadu_si128((__m128i *)(out + c));
+            o2 = _mm_loadu_si128((__m128i *)(out + stride_acc + c));
+            o0 = _mm_add_epi16(o0, _mm_add_epi16(a0, _mm_alignr_epi8(a1, prev1, 14)));
+            o2 = _mm_add_epi16(o2, _mm_add_epi16(a2, _mm_alignr_epi8(a3, prev3, 14)));
+            _mm_storeu_si128((__m128i *)(out + c), o0);
+            _mm_storeu_si128((__m128i *)(out + stride_acc + c), o2);
+            prev1 = a1;
+            prev3 = a3;
+
+            /* normalization, accumulation of these samples is done */
+            o0 = _mm_srai_epi16(_mm_add_epi16(o0, m_cnt_rnd), HTDF_CNT_SCALE);
+            o0 = _mm_min_epi16(_mm_max_epi16(o0, m_zero), m_max);
+            _mm_storeu_si128((__m128i *)(in + c), o0);
+        }
+        out[w_simd] += (pel)_mm_extract_epi16(prev1, 7);
+        out[stride_acc + w_simd] += (pel)_mm_extract_epi16(prev3, 7);
+    }
+
+    /* remaining windows only touch samples right of the ones done above */
+    if(w_simd < width - 1)
+    {
+        xeve_htdf_filter_block(block + w_simd, acc_block + w_simd, tbl, stride_block, stride_acc, width - w_simd, height, tbl_thr_log2, bit_depth);
+    }
+}
+#endif /* X86_SSE */
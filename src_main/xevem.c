@@ -165,80 +165,84 @@ ERR:
     return ret;
 }
 
+/* CTU rows of a tile are claimed one at a time by the threads of the tile,
+   see xeve_mt_claim_row() */
 static int xevem_ctu_mt_core(void * arg)
 {
     assert(arg != NULL);
 
     XEVE_BSW  * bs;
-    XEVE_SH   * sh;
     XEVE_CORE * core = (XEVE_CORE *)arg;
     XEVE_CTX  * ctx = core->ctx;
-    int ctb_cnt_in_row, ret;
-    bs = &ctx->bs[core->thread_cnt];
-    sh = ctx->sh;
     int i = core->tile_num;
+    XEVE_TILE * tile = &ctx->tile[i];
+    int sp_y_lcu = tile->ctba_rs_first / ctx->w_lcu;
+    int bef_cu_qp, x, ret;
 
-    /* CABAC Initialize for each Tile */
-    ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
-    ctx->fn_eco_sbac_reset(&core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
-
-    /*Set entry point for each ctu row in the tile*/
-    int sp_x_lcu = ctx->tile[core->tile_num].ctba_rs_first % ctx->w_lcu;
-    int sp_y_lcu = ctx->tile[core->tile_num].ctba_rs_first / ctx->w_lcu;
-    ctb_cnt_in_row = ctx->tile[i].w_ctb; //Total LCUs in the current row
-    xeve_update_core_loc_param_mt(ctx, core);
-
-    int bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
-
-    /* LCU encoding loop */
-    while (ctx->tile[i].f_ctb > 0)
+    while ((core = xeve_mt_claim_row(ctx, tile)) != NULL)
     {
-        if (core->y_lcu != sp_y_lcu && core->x_lcu < (sp_x_lcu + ctx->tile[core->tile_idx].w_ctb - 1))
+        bs = &ctx->bs[core->thread_cnt];
+
+        /* CABAC Initialize for each Tile, at the first row of each lane */
+        if (core->y_lcu - sp_y_lcu < tile->parallel_rows)
         {
-            /* up-right CTB */
-            spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + 1], THREAD_TERMINATED);
+            ctx->fn_eco_sbac_reset(GET_SBAC_ENC(bs), ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
+            ctx->fn_eco_sbac_reset(&core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], ctx->sh->slice_type, ctx->sh->qp, ctx->sps.tool_cm_init);
         }
+        bef_cu_qp = tile->qp_prev_eco[core->thread_cnt];
 
-        /* initialize structures *****************************************/
-        ret = ctx->fn_mode_init_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret);
-        xeve_init_bef_data(core, ctx);
+        /* LCU encoding loop */
+        for (x = 0; x < tile->w_ctb; x++)
+        {
+            if (core->y_lcu != sp_y_lcu)
+            {
+                /* up-right CTB, or the above one at the right of the tile */
+                spinlock_wait(&ctx->sync_flag[core->lcu_num - ctx->w_lcu + (x < tile->w_ctb - 1)], THREAD_TERMINATED);
+            }
+            xeve_refp_wait_lcu(ctx, core);
+
+            /* initialize structures *****************************************/
+            ret = ctx->fn_mode_init_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
+            xeve_init_bef_data(core, ctx);
 
 #if GRAB_STAT
-        xeve_stat_set_enc_state(TRUE);
+            xeve_stat_set_enc_state(TRUE);
 #endif
 
-        /* mode decision *************************************************/
-        SBAC_LOAD(core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], *GET_SBAC_ENC(bs));
-        core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].is_bitcount = 1;
-        ret = ctx->fn_mode_analyze_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret);
+            /* mode decision *************************************************/
+            SBAC_LOAD(core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2], *GET_SBAC_ENC(bs));
+            core->s_curr_best[ctx->log2_max_cuwh - 2][ctx->log2_max_cuwh - 2].is_bitcount = ctx->param.rdo_bit_est ? SBAC_BITCOUNT_EST : SBAC_BITCOUNT_EXACT;
+            ret = ctx->fn_mode_analyze_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-        ret = ctx->fn_mode_post_lcu(ctx, core);
-        xeve_assert_rv(ret == XEVE_OK, ret)
+            ret = ctx->fn_mode_post_lcu(ctx, core);
+            xeve_assert_rv(ret == XEVE_OK, ret)
 
-        ctx->tile[i].qp_prev_eco[core->thread_cnt] = bef_cu_qp;
-        if (ctx->param.cabac_refine)
-        {
-            /* entropy coding ************************************************/
-            int split_mode_child[4];
-            int split_allow[6] = { 0, 0, 0, 0, 0, 1 };
-            ret = xevem_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 1, NO_SPLIT
-                              , split_mode_child, 0, split_allow, 0, 0, 0, xeve_get_default_tree_cons(), bs);
-            bef_cu_qp = ctx->tile[i].qp_prev_eco[core->thread_cnt];
-        }
+            tile->qp_prev_eco[core->thread_cnt] = bef_cu_qp;
+            if (ctx->param.cabac_refine)
+            {
+                /* entropy coding ************************************************/
+                int split_mode_child[4];
+                int split_allow[6] = { 0, 0, 0, 0, 0, 1 };
+                ret = xevem_eco_tree(ctx, core, core->x_pel, core->y_pel, 0, ctx->max_cuwh, ctx->max_cuwh, 0, 1, NO_SPLIT
+                                  , split_mode_child, 0, split_allow, 0, 0, 0, xeve_get_default_tree_cons(), bs);
+                bef_cu_qp = tile->qp_prev_eco[core->thread_cnt];
+            }
 #if GRAB_STAT
-        xeve_stat_set_enc_state(FALSE);
-        xeve_stat_write_lcu(core->x_pel, core->y_pel, ctx->w, ctx->h, ctx->max_cuwh, ctx->log2_culine, ctx, core, ctx->map_cu_data[core->lcu_num].split_mode, ctx->map_cu_data[core->lcu_num].suco_flag);
+            xeve_stat_set_enc_state(FALSE);
+            xeve_stat_write_lcu(core->x_pel, core->y_pel, ctx->w, ctx->h, ctx->max_cuwh, ctx->log2_culine, ctx, core, ctx->map_cu_data[core->lcu_num].split_mode, ctx->map_cu_data[core->lcu_num].suco_flag);
 #endif
-        xeve_assert_rv(ret == XEVE_OK, ret);
+            xeve_assert_rv(ret == XEVE_OK, ret);
 
-        threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
-        threadsafe_decrement(ctx->sync_block, (volatile s32 *)&ctx->tile[i].f_ctb);
+            threadsafe_assign(&ctx->sync_flag[core->lcu_num], THREAD_TERMINATED);
+            xeve_pic_progress_ctu_done(ctx, core);
+            threadsafe_decrement(ctx->sync_block, (volatile s32 *)&tile->f_ctb);
 
-        core->lcu_num = xeve_mt_get_next_ctu_num(ctx, core, ctx->parallel_rows);
-        if (core->lcu_num == -1)
-            break;
+            core->x_lcu++;
+            core->lcu_num++;
+            xeve_update_core_loc_param_mt(ctx, core);
+        }
     }
     return XEVE_OK;
 }
@@ -254,28 +258,27 @@ static int xevem_tile_mt_core(void * arg)
     int parallel_task = ctx->tile_cnt == 1 ? ((ctx->param.threads > ctx->tile[core->tile_idx].h_ctb) ?
                                              ctx->tile[core->tile_idx].h_ctb : ctx->param.threads): 1;
     ctx->parallel_rows = parallel_task;
+    ctx->tile[core->tile_idx].parallel_rows = parallel_task;
     ctx->tile[core->tile_idx].qp = ctx->sh->qp;
     for (i = 0; i < ctx->param.threads; i++)
     {
         ctx->tile[core->tile_idx].qp_prev_eco[i] = ctx->sh->qp;
     }
 
+    /* all lane cores are set up before any thread starts to claim rows */
     for (int thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++)
     {
         ctx->core[thread_cnt]->tile_idx = core->tile_idx;
-        ctx->core[thread_cnt]->x_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);               //entry point lcu's x location
-        ctx->core[thread_cnt]->y_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu) + thread_cnt; // entry point lcu's y location
-        ctx->core[thread_cnt]->lcu_num = ctx->core[thread_cnt]->y_lcu * ctx->w_lcu + ctx->core[thread_cnt]->x_lcu;
-
         xevem_init_core_mt(ctx, core->tile_idx, core, thread_cnt);
-
         ctx->core[thread_cnt]->thread_cnt = thread_cnt;
-        ctx->tc->run(ctx->thread_pool[thread_cnt], xevem_ctu_mt_core, (void*)ctx->core[thread_cnt]);
     }
+    ctx->tile[core->tile_idx].core_base = core->thread_cnt;
+    ctx->tile[core->tile_idx].next_row = 0;
 
-    core->x_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) % ctx->w_lcu);
-    core->y_lcu = ((ctx->tile[core->tile_num].ctba_rs_first) / ctx->w_lcu);
-    core->lcu_num = core->y_lcu * ctx->w_lcu + core->x_lcu;
+    for (int thread_cnt = 1; thread_cnt < parallel_task; thread_cnt++)
+    {
+        ctx->tc->run(ctx->thread_pool[thread_cnt], xevem_ctu_mt_core, (void*)ctx->core[thread_cnt]);
+    }
 
     xevem_ctu_mt_core(arg);
 
@@ -752,6 +755,7 @@ XEVE xeve_create(XEVE_CDSC * cdsc, int * err)
 
     /* set default value for encoding parameter */
     xeve_mcpy(&ctx->param, &(cdsc->param), sizeof(XEVE_PARAM));
+    ctx->pool = (THREAD_POOL *)cdsc->pool;
     ret = xevem_set_init_param(ctx, &ctx->param);
     xeve_assert_g(ret == XEVE_OK, ERR);
 
@@ -826,6 +830,16 @@ void xeve_delete(XEVE id)
     xeve_ctx_free(ctx);
 }
 
+XEVE_POOL xeve_pool_create(int threads, const char * cpu_set, int * err)
+{
+    return xeve_pool_alloc(threads, cpu_set, err);
+}
+
+int xeve_pool_delete(XEVE_POOL pool)
+{
+    return xeve_pool_free(pool);
+}
+
 int xeve_encode(XEVE id, XEVE_BITB * bitb, XEVE_STAT * stat)
 {
     XEVE_CTX * ctx;
@@ -1018,8 +1032,17 @@ int xeve_config(XEVE id, int cfg, void * buf, int * size)
                 }
             }
 
+            /* 8bit pictures are handed out with one byte per sample */
+            if (XEVE_CS_GET_BIT_DEPTH(imgb->cs) == 8)
+            {
+                imgb = xeve_imgb_create_8b(imgb);
+                xeve_assert_rv(imgb != NULL, XEVE_ERR_OUT_OF_MEMORY);
+            }
+            else
+            {
+                imgb->addref(imgb);
+            }
             *((XEVE_IMGB **)buf) = imgb;
-            imgb->addref(imgb);
             break;
         case XEVE_CFG_GET_USE_DEBLOCK:
             xeve_assert_rv(*size == sizeof(int), XEVE_ERR_INVALID_ARGUMENT);
@@ -1144,6 +1167,8 @@ int xeve_param_ppt(XEVE_PARAM* param, int profile, int preset, int tune)
         param->btt                = 0;
         param->ats_intra_fast     = 1;
         param->me_fast            = 1;
+        param->fast_split         = 2;
+        param->ipd_presel         = param->ipd_presel < 0 ? 8 : param->ipd_presel;
 
     }
     else if (preset == XEVE_PRESET_MEDIUM)
@@ -1172,6 +1197,8 @@ int xeve_param_ppt(XEVE_PARAM* param, int profile, int preset, int tune)
         param->framework_tris_min = 5;
         param->ats_intra_fast     = 1;
         param->me_fast            = 0;
+        param->fast_split         = 0;
+        param->ipd_presel         = param->ipd_presel < 0 ? 8 : param->ipd_presel;
     }
     else if (preset == XEVE_PRESET_SLOW)
     {
@@ -1199,6 +1226,8 @@ int xeve_param_ppt(XEVE_PARAM* param, int profile, int preset, int tune)
         param->framework_tris_min = 4;
         param->ats_intra_fast     = 1;
         param->me_fast            = 0;
+        param->fast_split         = 0;
+        param->ipd_presel         = param->ipd_presel < 0 ? 12 : param->ipd_presel;
     }
     else if (preset == XEVE_PRESET_PLACEBO)
     {
@@ -1226,6 +1255,8 @@ int xeve_param_ppt(XEVE_PARAM* param, int profile, int preset, int tune)
         param->framework_tris_min = 4;
         param->ats_intra_fast     = 0;
         param->me_fast            = 1;
+        param->fast_split         = 0;
+        param->ipd_presel         = param->ipd_presel < 0 ? 0 : param->ipd_presel;
     }
     else
     {
@@ -1284,6 +1315,8 @@ int xeve_param_check(const XEVE_PARAM* param)
         if (param->ibc_flag     == 1) { xeve_trace("IBC cannot be on in base profile\n"); ret = -1; }
         if (param->tool_rpl     == 1) { xeve_trace("RPL cannot be on in base profile\n"); ret = -1; }
         if (param->tool_pocs    == 1) { xeve_trace("POCS cannot be on in base profile\n"); ret = -1; }
+        if (param->fast_split   != 0) { xeve_trace("FAST_SPLIT cannot be on in base profile\n"); ret = -1; }
+        if (param->ipd_presel    > 0) { xeve_trace("IPD_PRESEL cannot be on in base profile\n"); ret = -1; }
     }
     else
     {
@@ -1294,7 +1327,19 @@ int xeve_param_check(const XEVE_PARAM* param)
         if (param->tool_eipd    == 0 && param->ibc_flag    == 1) { xeve_trace("IBC cannot be on when EIPD is off\n"); ret = -1; }
         if (param->tool_iqt     == 0 && param->tool_ats    == 1) { xeve_trace("ATS cannot be on when IQT is off\n"); ret = -1; }
         if (param->tool_cm_init == 0 && param->tool_adcc   == 1) { xeve_trace("ADCC cannot be on when CM_INIT is off\n"); ret = -1; }
+        if (param->fast_split < 0 || param->fast_split > 2) { xeve_trace("FAST_SPLIT should be in range of 0 to 2\n"); ret = -1; }
+        if (param->ipd_presel < -1 || param->ipd_presel > IPD_CNT) { xeve_trace("IPD_PRESEL should be in range of -1 to 33\n"); ret = -1; }
+        if (param->tool_dra     == 1 && param->codec_bit_depth == 8) { xeve_trace("DRA cannot be on with 8bit coding\n"); ret = -1; }
     }
+    if (param->rdo_bit_est < 0 || param->rdo_bit_est > 1) { xeve_trace("RDO_BIT_EST should be 0 or 1\n"); ret = -1; }
+    if (param->intra_refresh < 0 || param->intra_refresh > 1) { xeve_trace("INTRA_REFRESH should be 0 or 1\n"); ret = -1; }
+    if (param->intra_refresh == 1 && param->bframes > 0) { xeve_trace("INTRA_REFRESH cannot be on with B pictures\n"); ret = -1; }
+    if (param->pass < 0 || param->pass > 2) { xeve_trace("PASS should be 0, 1 or 2\n"); ret = -1; }
+    if (param->pass > 0 && param->stats_file[0] == 0) { xeve_trace("STATS_FILE is needed for multi-pass encoding\n"); ret = -1; }
+    if (param->fcst_level < 0 || param->fcst_level >= XEVE_FCST_LVL_MAX) { xeve_trace("FCST_LEVEL should be in range of 0 to 2\n"); ret = -1; }
+    if (param->static_th < 0 || param->static_th > 255) { xeve_trace("STATIC_TH should be in range of 0 to 255\n"); ret = -1; }
+    if (param->calc_metrics < 0 || param->calc_metrics > 2) { xeve_trace("CALC_METRICS should be in range of 0 to 2\n"); ret = -1; }
+    if (param->mc_cache < 0 || param->mc_cache > 1) { xeve_trace("MC_CACHE should be 0 or 1\n"); ret = -1; }
 
     if (param->btt == 1)
     {
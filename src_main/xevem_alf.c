@@ -2963,8 +2963,8 @@ double xeve_alf_merge_filters_cost(XEVE_ALF * enc_alf, ALF_SLICE_PARAM* alf_slic
 {
     int num_filter_best = 0;
     int num_filters = MAX_NUM_ALF_CLASSES;
-    static BOOL coded_var_bins[MAX_NUM_ALF_CLASSES];
-    static double err_force0_coef_tab[MAX_NUM_ALF_CLASSES][2];
+    BOOL coded_var_bins[MAX_NUM_ALF_CLASSES];
+    double err_force0_coef_tab[MAX_NUM_ALF_CLASSES][2];
 
     double cost, cost0, dist, dist_force0, cost_min = DBL_MAX;
     int pred_mode = 0, best_pred_mode = 0, coef_bits, coef_bits_force0;
@@ -3259,7 +3259,7 @@ int xeve_alf_length_filter_coef(ALF_FILTER_SHAPE* alf_shape, const int num_filte
 
 double xeve_alf_get_dist_force0(XEVE_ALF * enc_alf, ALF_FILTER_SHAPE* alf_shape, const int num_filters, double err_tab_force0_coef[MAX_NUM_ALF_CLASSES][2], BOOL* coded_var_bins)
 {
-    static int bits_var_bin[MAX_NUM_ALF_CLASSES];
+    int bits_var_bin[MAX_NUM_ALF_CLASSES];
 
     xeve_mset(enc_alf->bits_coef_scan, 0, sizeof(enc_alf->bits_coef_scan));
     for (int ind = 0; ind < num_filters; ++ind)
@@ -3416,8 +3416,8 @@ double xeve_alf_derive_filter_coef(XEVE_ALF * enc_alf, ALF_COVARIANCE* cov, ALF_
 double xeve_alf_derive_coef_quant(int *filter_coef_quant, double **E, double *y, const int num_coef, int* weights, const int bit_depth, const BOOL is_chroma)
 {
     const int factor = 1 << (bit_depth - 1);
-    static int filter_coef_quant_mod[MAX_NUM_ALF_LUMA_COEFF];
-    static double filter_coef[MAX_NUM_ALF_LUMA_COEFF];
+    int filter_coef_quant_mod[MAX_NUM_ALF_LUMA_COEFF];
+    double filter_coef[MAX_NUM_ALF_LUMA_COEFF];
 
     xeve_alf_gns_solve_chol(E, y, filter_coef, num_coef);
     xeve_alf_round_filt_coef(filter_coef_quant, filter_coef, num_coef, factor);
@@ -3563,9 +3563,9 @@ void xeve_alf_find_best_fixed_filter(ALF_SLICE_PARAM* alf_slice_param, ALF_COVAR
 
 void xeve_alf_merge_classes(ALF_COVARIANCE* cov, ALF_COVARIANCE* cov_merged, const int num_classes, short filter_indices[MAX_NUM_ALF_CLASSES][MAX_NUM_ALF_CLASSES])
 {
-    static BOOL avail_class[MAX_NUM_ALF_CLASSES];
-    static u8 index_list[MAX_NUM_ALF_CLASSES];
-    static u8 index_list_temp[MAX_NUM_ALF_CLASSES];
+    BOOL avail_class[MAX_NUM_ALF_CLASSES];
+    u8 index_list[MAX_NUM_ALF_CLASSES];
+    u8 index_list_temp[MAX_NUM_ALF_CLASSES];
     int num_remaining = num_classes;
 
     xeve_mset(filter_indices, 0, sizeof(short) * MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_CLASSES);
@@ -3793,7 +3793,7 @@ void xeve_alf_derive_stats_filtering(XEVE_ALF * enc_alf, YUV * org_yuv, YUV * re
 void xeve_alf_get_blk_stats(int ch, ALF_COVARIANCE* alf_cov, const ALF_FILTER_SHAPE* shape, ALF_CLASSIFIER** classifier, pel* org0
                           , const int org_stride, pel* rec0, const int rec_stride, const int x, const int y, const int width, const int height)
 {
-    static int E_local[MAX_NUM_ALF_LUMA_COEFF];
+    int E_local[MAX_NUM_ALF_LUMA_COEFF];
     int trans_idx = 0;
     int class_idx = 0;
     pel * rec = rec0 + y * rec_stride + x;
@@ -3920,7 +3920,7 @@ void xeve_alf_clac_covariance(int *E_local, const pel *rec, const int stride, co
 
 double xeve_alf_clac_err(ALF_COVARIANCE* cov)
 {
-    static double c[MAX_NUM_ALF_COEFF];
+    double c[MAX_NUM_ALF_COEFF];
 
     xeve_alf_gns_solve_chol(cov->E, cov->y, c, cov->num_coef);
 
@@ -3943,7 +3943,7 @@ double xeve_alf_clac_err(ALF_COVARIANCE* cov)
 //Find filter coeff related
 int xeve_alf_gns_cholesky_dec(double **input_matr, double out_matr[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF], int num_eq)
 {
-    static double inv_diag[MAX_NUM_ALF_COEFF];  /* Vector of the inverse of diagonal entries of out_matr */
+    double inv_diag[MAX_NUM_ALF_COEFF];  /* Vector of the inverse of diagonal entries of out_matr */
 
     for (int i = 0; i < num_eq; i++)
     {
@@ -4017,8 +4017,8 @@ void xeve_alf_gns_back_substitution(double R[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEF
 
 int xeve_alf_gns_solve_chol(double **LHS, double *rhs, double *x, int num_eq)
 {
-    static double aux[MAX_NUM_ALF_COEFF];     /* Auxiliary vector */
-    static double U[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF];    /* Upper triangular Cholesky factor of LHS */
+    double aux[MAX_NUM_ALF_COEFF];     /* Auxiliary vector */
+    double U[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF];    /* Upper triangular Cholesky factor of LHS */
     int res = 1;  // Signal that Cholesky factorization is successfully performed
                   /* The equation to be solved is LHSx = rhs */
                   /* Compute upper triangular U such that U'*U = LHS */
@@ -76,6 +76,8 @@ void xevem_sbac_reset(XEVE_SBAC *sbac, u8 slice_type, u8 slice_qp, int sps_cm_in
     sbac->stacked_ff = 0;
     sbac->stacked_zero = 0;
     sbac->bin_counter = 0;
+    sbac->ckpt_src = NULL;
+    sbac->ver++;
 
     xeve_mset(sbac_ctx, 0x00, sizeof(*sbac_ctx));
 
@@ -1990,7 +1992,7 @@ int xeve_eco_pic_signature_main(XEVE_CTX * ctx, XEVE_BSW * bs, u8 pic_sign[N_C][
 
     if (ctx->pps.pic_dra_enabled_flag == 0)
     {
-        ret = xeve_picbuf_signature(PIC_CURR(ctx), pic_sign);
+        ret = xeve_eco_pic_signature(ctx, bs, pic_sign);
         xeve_assert_rv(ret == XEVE_OK, ret);
     }
     else
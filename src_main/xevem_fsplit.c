@@ -0,0 +1,165 @@
+/* The copyright in this software is being made available under the BSD
+   License, included below. This software may be subject to contributor and
+   other third party rights, including patent rights, and no such rights are
+   granted under this license.
+
+   Copyright (c) 2020, Samsung Electronics Co., Ltd.
+   All Rights Reserved. */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+   
+   - Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+   
+   - Neither the name of the copyright owner, nor the names of its contributors
+   may be used to endorse or promote products derived from this software
+   without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+   AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+   IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+   ARE DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+   LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+   CONSEQUENTIAL DAMAGES(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+   SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+   INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+   ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+   POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "xevem_fsplit.h"
+#include "xeve_fcst.h"
+
+/* thresholds are given in bits, scaled by the luma lambda of the current CU */
+#define FSPLIT_FLAT_BITS                   8  /* flat node: no split at all */
+#define FSPLIT_FLAT_TT_BITS                32 /* nearly flat node: no ternary split */
+#define FSPLIT_STOP_BITS                   16 /* RD cost under which a node is not split (conservative) */
+#define FSPLIT_STOP_BITS_AGG               32 /* RD cost under which a node is not split (aggressive) */
+#define FSPLIT_SKIP_DEPTH                  2  /* no split below a skipped node from this depth */
+#define FSPLIT_STATIC_RATIO                4  /* lookahead intra/inter cost ratio of a static area */
+
+/* residual energy after removing the DC of each 16x16 sub-block, -1 if not measurable */
+static s64 fsplit_get_activity(XEVE_CTX * ctx, int x0, int y0, int log2_cuw, int log2_cuh)
+{
+    XEVE_PIC * pic = PIC_ORIG(ctx);
+
+    if(log2_cuw < LOG2_AQ_BLK_SIZE || log2_cuh < LOG2_AQ_BLK_SIZE)
+    {
+        return -1;
+    }
+    return (s64)(get_lcu_var(ctx, pic->y, log2_cuw, log2_cuh, x0, y0, pic->s_l) << (log2_cuw - LOG2_AQ_BLK_SIZE));
+}
+
+/* whether the lookahead found the area of the CU well predicted from the previous picture */
+static int fsplit_is_static(XEVE_CTX * ctx, int x0, int y0, int cuw, int cuh)
+{
+    int log2_blk, x_blk, y_blk;
+    s32 (*map_lcost)[4];
+
+    if(!ctx->param.use_fcst || ctx->slice_type == SLICE_I)
+    {
+        return 0;
+    }
+
+    log2_blk = ctx->fcst.log2_fcst_blk_spic + 1;
+    x_blk = (x0 + (cuw >> 1)) >> log2_blk;
+    y_blk = (y0 + (cuh >> 1)) >> log2_blk;
+    if(x_blk >= ctx->fcst.w_blk || y_blk >= ctx->fcst.h_blk)
+    {
+        return 0;
+    }
+
+    map_lcost = ctx->pico->sinfo.map_uni_lcost + y_blk * ctx->fcst.w_blk + x_blk;
+    return ((*map_lcost)[INTRA] > 0 && (*map_lcost)[INTER_UNI0] * FSPLIT_STATIC_RATIO < (*map_lcost)[INTRA]);
+}
+
+/* reduce split candidates of the current node before any of them is evaluated */
+void xevem_fsplit_pre(XEVE_CTX * ctx, XEVE_CORE * core, int x0, int y0, int log2_cuw, int log2_cuh, int * split_allow)
+{
+    int i, num_cand = 0, num_left = 0;
+    int prune_split = 0, prune_tt = 0;
+
+    for(i = 0; i < MAX_SPLIT_NUM; i++)
+    {
+        num_cand += split_allow[i];
+    }
+    core->fsplit_cand += num_cand;
+
+    if(ctx->param.fast_split < FSPLIT_AGGRESSIVE || num_cand <= 1)
+    {
+        return;
+    }
+
+    s64 act = fsplit_get_activity(ctx, x0, y0, log2_cuw, log2_cuh);
+    if(act >= 0)
+    {
+        if(log2_cuw + log2_cuh <= 10 && act < core->lambda[0] * FSPLIT_FLAT_BITS)
+        {
+            prune_split = 1;
+        }
+        else if(act < core->lambda[0] * FSPLIT_FLAT_TT_BITS)
+        {
+            prune_tt = 1;
+        }
+    }
+
+    if(fsplit_is_static(ctx, x0, y0, 1 << log2_cuw, 1 << log2_cuh))
+    {
+        prune_tt = 1;
+    }
+
+    for(i = 1; i < MAX_SPLIT_NUM; i++)
+    {
+        if(prune_split || (prune_tt && xeve_split_is_TT(i)))
+        {
+            core->fsplit_pruned += split_allow[i];
+            split_allow[i] = 0;
+        }
+        num_left += split_allow[i];
+    }
+
+    if(num_left == 0 && !split_allow[0])
+    {
+        split_allow[0] = 1;
+    }
+}
+
+/* decide whether the remaining split candidates are worth trying once NO_SPLIT was evaluated */
+int xevem_fsplit_post(XEVE_CTX * ctx, XEVE_CORE * core, int cud, int nev_max_depth, double cost_best, int * split_allow)
+{
+    int i, stop = 0;
+    double bits = ctx->param.fast_split >= FSPLIT_AGGRESSIVE ? FSPLIT_STOP_BITS_AGG : FSPLIT_STOP_BITS;
+
+    if(cost_best == MAX_COST || cost_best < 0)
+    {
+        return 0;
+    }
+
+    /* no neighbouring CU went deeper than the current node: splitting is less likely */
+    bits = (cud >= nev_max_depth) ? bits * 2 : bits / 2;
+    if(cost_best < core->lambda[0] * bits)
+    {
+        stop = 1;
+    }
+
+    if(ctx->param.fast_split >= FSPLIT_AGGRESSIVE && cud >= FSPLIT_SKIP_DEPTH
+       && (core->cu_mode == MODE_SKIP || core->cu_mode == MODE_SKIP_MMVD))
+    {
+        stop = 1;
+    }
+
+    if(stop)
+    {
+        for(i = 1; i < MAX_SPLIT_NUM; i++)
+        {
+            core->fsplit_pruned += split_allow[i];
+        }
+    }
+    return stop;
+}
@@ -40,9 +40,14 @@
 const XEVEM_MC (*xevem_func_dmvr_mc_l)[2];
 const XEVEM_MC (*xevem_func_dmvr_mc_c)[2];
 const XEVEM_MC     (*xevem_func_bl_mc_l)[2];
+XEVEM_DMVR_COST       xevem_func_dmvr_cost;
+XEVEM_DMVR_CROSS_COST xevem_func_dmvr_cross_cost;
 XEVE_AFFINE_H_SOBEL_FLT xevem_func_aff_h_sobel_flt;
 XEVE_AFFINE_V_SOBEL_FLT xevem_func_aff_v_sobel_flt;
 XEVE_AFFINE_EQUAL_COEF  xevem_func_aff_eq_coef_comp;
+XEVE_EIF_BILINEAR_CLIP    xevem_func_eif_bl_clip;
+XEVE_EIF_BILINEAR_NO_CLIP xevem_func_eif_bl_no_clip;
+XEVE_EIF_FILTER           xevem_func_eif_filter;
 
 // clang-format off
 
@@ -566,50 +571,44 @@ s32 xeve_dmvr_cost(int w, int h, pel *src1, pel *src2, int s_src1, int s_src2)
     return sad;
 }
 
+void xeve_dmvr_cross_cost(int w, int h, pel *ref_l0, int s_ref_l0, pel *ref_l1, int s_ref_l1, s32 *cost)
+{
+    s32 searchOffsetX[4] = {0,  0, 1, -1};
+    s32 searchOffsetY[4] = {1, -1, 0,  0};
+    int idx;
+
+    for(idx = SAD_BOTTOM; idx <= SAD_LEFT; ++idx)
+    {
+        cost[idx] = xeve_dmvr_cost(w, h, ref_l0 + searchOffsetX[idx] + (searchOffsetY[idx] * s_ref_l0)
+                                 , ref_l1 - searchOffsetX[idx] - (searchOffsetY[idx] * s_ref_l1), s_ref_l0, s_ref_l1);
+    }
+}
+
 void xeve_dmvr_refine(int w, int h, pel *ref_l0, int s_ref_l0, pel *ref_l1, int s_ref_l1
                       , s32 *minCost, s16 *delta_mvX, s16 *delta_mvY, s32 *SAD_Array)
 {
     enum SAD_POINT_INDEX idx;
-    s32 LineMeanL0[4] = {0, 0, 0, 0};
-    s32 LineMeanL1[4] = {0, 0, 0, 0};
-    s32 meanL0 = 0, meanL1 = 0;
     s32 searchOffsetX[5] = {0,  0, 1, -1, 0};
     s32 searchOffsetY[5] = {1, -1, 0,  0, 0};
-    pel *ref_l0_Orig = ref_l0;
-    pel *ref_l1_Orig = ref_l1;
 
-    for(idx = SAD_BOTTOM; idx <= SAD_TOP_LEFT; ++idx)
-    {
-        int sum = 0;
-        ref_l0 = ref_l0_Orig + searchOffsetX[idx] + (searchOffsetY[idx] * s_ref_l0);
-        ref_l1 = ref_l1_Orig - searchOffsetX[idx] - (searchOffsetY[idx] * s_ref_l1);
+    /* the four cross positions are independent of each other */
+    xevem_func_dmvr_cross_cost(w, h, ref_l0, s_ref_l0, ref_l1, s_ref_l1, SAD_Array);
 
-        s32 cost = xeve_dmvr_cost(w, h, ref_l0, ref_l1, s_ref_l0, s_ref_l1);
+    /* the diagonal position follows the better side of each direction */
+    searchOffsetX[SAD_TOP_LEFT] = (SAD_Array[SAD_RIGHT] <= SAD_Array[SAD_LEFT]) ? 1 : -1;
+    searchOffsetY[SAD_TOP_LEFT] = (SAD_Array[SAD_BOTTOM] <= SAD_Array[SAD_TOP]) ? 1 : -1;
+    SAD_Array[SAD_TOP_LEFT] = xevem_func_dmvr_cost(w, h, ref_l0 + searchOffsetX[SAD_TOP_LEFT] + (searchOffsetY[SAD_TOP_LEFT] * s_ref_l0)
+                                                 , ref_l1 - searchOffsetX[SAD_TOP_LEFT] - (searchOffsetY[SAD_TOP_LEFT] * s_ref_l1), s_ref_l0, s_ref_l1);
 
-        *(SAD_Array + idx) = cost;
-        if(idx == SAD_LEFT)
-        {
-            s32 down = -1, right = -1;
-            if(*(SAD_Array + SAD_BOTTOM) <= *(SAD_Array + SAD_TOP))
-            {
-                down = 1;
-            }
-            if(*(SAD_Array + SAD_RIGHT) <= *(SAD_Array + SAD_LEFT))
-            {
-                right = 1;
-            }
-            searchOffsetX[SAD_TOP_LEFT] = right;
-            searchOffsetY[SAD_TOP_LEFT] = down;
-        }
-        if(cost < *minCost)
+    for(idx = SAD_BOTTOM; idx <= SAD_TOP_LEFT; ++idx)
+    {
+        if(SAD_Array[idx] < *minCost)
         {
-            *minCost = cost;
+            *minCost = SAD_Array[idx];
             *delta_mvX = searchOffsetX[idx];
             *delta_mvY = searchOffsetY[idx];
         }
-    }/*end of search point loop*/
-    ref_l0 = ref_l0_Orig;
-    ref_l1 = ref_l1_Orig;
+    }
 }
 
 __inline static s32 div_for_maxq7(s64 N, s64 D)
@@ -975,7 +974,7 @@ static void processDMVR(int x, int y, int pic_w, int pic_h, int w, int h, s8 ref
 
                 if(i == 0)
                 {
-                    min_cost = xeve_dmvr_cost(dx, dy, addr_l0, addr_l1, stride, stride);
+                    min_cost = xevem_func_dmvr_cost(dx, dy, addr_l0, addr_l1, stride, stride);
                 }
 
                 if((i > 0 && min_cost == 0) || (i == 0 && min_cost < dy*dx))
@@ -1756,14 +1755,14 @@ void xeve_eif_mc(int block_width, int block_height, int x, int y, int mv_scale_h
 
     if (is_mv_clip_needed)
     {
-        xeve_eif_bilinear_clip(block_width, block_height, mv0, d_x, d_y, mv_max, mv_min, p_ref, ref_stride, p_tmp_buf, tmp_buf_stride, shifts, offsets, bit_depth);
+        xevem_func_eif_bl_clip(block_width, block_height, mv0, d_x, d_y, mv_max, mv_min, p_ref, ref_stride, p_tmp_buf, tmp_buf_stride, shifts, offsets, bit_depth);
     }
     else
     {
-        xeve_eif_bilinear_no_clip(block_width, block_height, mv0, d_x, d_y, p_ref, ref_stride, p_tmp_buf, tmp_buf_stride, shifts, offsets, bit_depth);
+        xevem_func_eif_bl_no_clip(block_width, block_height, mv0, d_x, d_y, p_ref, ref_stride, p_tmp_buf, tmp_buf_stride, shifts, offsets, bit_depth);
     }
 
-    xeve_eif_filter(block_width, block_height, p_tmp_buf, tmp_buf_stride, p_dst, dst_stride, shifts, offsets, bit_depth);
+    xevem_func_eif_filter(block_width, block_height, p_tmp_buf, tmp_buf_stride, p_dst, dst_stride, shifts, offsets, bit_depth);
 }
 
 void xeve_affine_mc(int x, int y, int pic_w, int pic_h, int w, int h, s8 refi[REFP_NUM], s16 mv[REFP_NUM][VER_NUM][MV_D], XEVE_REFP(*refp)[REFP_NUM]
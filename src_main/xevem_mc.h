@@ -45,6 +45,8 @@ extern const s16 tbl_bl_eif_32_phases_mc_l_coeff[32][2];
 
 typedef void (*XEVEM_MC) (pel *ref, int gmv_x, int gmv_y, int s_ref, int s_pred, pel *pred, int w, int h, int bit_depth);
 typedef int  (*XEVE_DMVR_SAD_MR)(int w, int h, void * src1, void * src2, int s_src1, int s_src2, s16 delta);
+typedef s32  (*XEVEM_DMVR_COST)(int w, int h, pel *src1, pel *src2, int s_src1, int s_src2);
+typedef void (*XEVEM_DMVR_CROSS_COST)(int w, int h, pel *ref_l0, int s_ref_l0, pel *ref_l1, int s_ref_l1, s32 *cost);
 
 extern const XEVEM_MC xevem_tbl_dmvr_mc_l[2][2];
 extern const XEVEM_MC xevem_tbl_dmvr_mc_c[2][2];
@@ -53,6 +55,11 @@ extern const XEVEM_MC xevem_tbl_bl_mc_l[2][2];
 extern const XEVEM_MC (*xevem_func_dmvr_mc_l)[2];
 extern const XEVEM_MC (*xevem_func_dmvr_mc_c)[2];
 extern const XEVEM_MC (*xevem_func_bl_mc_l)[2];
+extern XEVEM_DMVR_COST       xevem_func_dmvr_cost;
+extern XEVEM_DMVR_CROSS_COST xevem_func_dmvr_cross_cost;
+
+s32  xeve_dmvr_cost(int w, int h, pel *src1, pel *src2, int s_src1, int s_src2);
+void xeve_dmvr_cross_cost(int w, int h, pel *ref_l0, int s_ref_l0, pel *ref_l1, int s_ref_l1, s32 *cost);
 
 #define xeve_dmvr_mc_l(ref, gmv_x, gmv_y, s_ref, s_pred, pred, w, h, bit_depth) \
        (xevem_func_dmvr_mc_l[((gmv_x) | ((gmv_x)>>1) | ((gmv_x)>>2) | ((gmv_x)>>3)) & 0x1])\
@@ -92,4 +99,20 @@ extern XEVE_AFFINE_H_SOBEL_FLT xevem_func_aff_h_sobel_flt;
 extern XEVE_AFFINE_V_SOBEL_FLT xevem_func_aff_v_sobel_flt;
 extern XEVE_AFFINE_EQUAL_COEF  xevem_func_aff_eq_coef_comp;
 
+void xeve_eif_bilinear_clip(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], int mv_max[MV_D], int mv_min[MV_D]
+                          , pel* p_ref, int ref_stride, pel* p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth);
+void xeve_eif_bilinear_no_clip(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], pel* p_ref, int ref_stride
+                             , pel* p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth);
+void xeve_eif_filter(int block_width, int block_height, pel* p_tmp_buf, int tmp_buf_stride, pel *p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth);
+
+typedef void (*XEVE_EIF_BILINEAR_CLIP)(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], int mv_max[MV_D], int mv_min[MV_D]
+                                      , pel* p_ref, int ref_stride, pel* p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth);
+typedef void (*XEVE_EIF_BILINEAR_NO_CLIP)(int block_width, int block_height, int mv0[MV_D], int d_x[MV_D], int d_y[MV_D], pel* p_ref, int ref_stride
+                                         , pel* p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth);
+typedef void (*XEVE_EIF_FILTER)(int block_width, int block_height, pel* p_tmp_buf, int tmp_buf_stride, pel *p_dst, int dst_stride, int shifts[4], int offsets[4], int bit_depth);
+
+extern XEVE_EIF_BILINEAR_CLIP    xevem_func_eif_bl_clip;
+extern XEVE_EIF_BILINEAR_NO_CLIP xevem_func_eif_bl_no_clip;
+extern XEVE_EIF_FILTER           xevem_func_eif_filter;
+
 #endif /* _XEVEM_MC_H_ */
@@ -35,6 +35,7 @@
 
 #include "xevem_type.h"
 #include "xevem_mode.h"
+#include "xevem_fsplit.h"
 
 typedef int(*LOSSY_ES_FUNC)(XEVE_CU_DATA *, int, double, int, int, int, int, int, int);
 
@@ -1124,10 +1125,14 @@ static double mode_coding_unit_main(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y
 
     cost_best = MAX_COST;
     core->cost_best = MAX_COST;
+    core->static_hit = 0;
 
     cost_best = mode_check_inter(ctx, core, x, y, log2_cuw, log2_cuh, cud, mi, cost_best);
-    cost_best = mode_check_ibc(ctx, core, x, y, log2_cuw, log2_cuh, cud, mi, cost_best);
-    cost_best = mode_check_intra(ctx, core, x, y, log2_cuw, log2_cuh, cud, mi, cost_best);
+    if(!core->static_hit)
+    {
+        cost_best = mode_check_ibc(ctx, core, x, y, log2_cuw, log2_cuh, cud, mi, cost_best);
+        cost_best = mode_check_intra(ctx, core, x, y, log2_cuw, log2_cuh, cud, mi, cost_best);
+    }
 
     return cost_best;
 }
@@ -1508,6 +1513,16 @@ static double mode_coding_tree_main(XEVE_CTX *ctx, XEVE_CORE *core, int x0, int
         }
 
         check_run_split(core, log2_cuw, log2_cuh, cup, next_split, do_curr, do_split, bef_data_idx, split_allow, boundary, tree_cons);
+
+        if(ctx->param.fast_split && !boundary && next_split)
+        {
+            xevem_fsplit_pre(ctx, core, x0, y0, log2_cuw, log2_cuh, split_allow);
+        }
+
+        if(ctx->pass && !boundary && next_split)
+        {
+            xeve_pass_split_prune(ctx, x0, y0, log2_cuw, log2_cuh, split_allow);
+        }
     }
     else
     {
@@ -1668,6 +1683,12 @@ static double mode_coding_tree_main(XEVE_CTX *ctx, XEVE_CORE *core, int x0, int
         next_split = 0;
     }
 
+    if(cost_best != MAX_COST && core->static_hit && core->cu_mode == MODE_SKIP)
+    {
+        core->static_cu++;
+        next_split = 0;
+    }
+
     if(cost_best != MAX_COST && ctx->sh->slice_type == SLICE_I && mcore->ibc_flag != 1)
     {
         int dist_cu = core->dist_cu_best;
@@ -1684,6 +1705,11 @@ static double mode_coding_tree_main(XEVE_CTX *ctx, XEVE_CORE *core, int x0, int
         }
     }
 
+    if(ctx->param.fast_split && next_split && !boundary && xevem_fsplit_post(ctx, core, cud, nev_max_depth, cost_best, split_allow))
+    {
+        next_split = 0;
+    }
+
     if((cuw > MIN_CU_SIZE || cuh > MIN_CU_SIZE) && next_split && (cuw > check_min_cu || cuh > check_min_cu))
     {
         SPLIT_MODE split_mode_order[MAX_SPLIT_NUM];
@@ -2203,6 +2229,10 @@ static int mode_init_lcu_main(XEVE_CTX *ctx, XEVE_CORE *core)
         }
     }
 
+    /* cached predictions and unit costs are only reused within a CTU */
+    mcore->mc_cache.stamp++;
+    mcore->ipd_presel.cur++;
+
     return XEVE_OK;
 }
 
@@ -1011,8 +1011,10 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
     s16 mvc[MV_D];  /* MV center for search */
     s16 gmvp[MV_D]; /* MVP in frame cordinate */
     s16 range[MV_RANGE_DIM][MV_D]; /* search range after clipping */
+    s16 range_h[MV_RANGE_DIM][MV_D];
     s16 mvi[MV_D];
     s16 mvt[MV_D];
+    s16 mvh[MV_D]; /* first pass motion hint */
     u32 cost, cost_best = XEVE_UINT32_MAX;
     s8 ri = 0;  /* reference buffer index */
     int tmpstep = 0;
@@ -1059,6 +1061,35 @@ static u32 pinter_me_epzs(XEVE_PINTER * pi, int x, int y, int log2_cuw, int log2
         }
     }
 
+    if(bi == BI_NON && xeve_pass_mv_hint(pi, x, y, log2_cuw, log2_cuh, ri, lidx, mvh)
+       && (abs(mvh[MV_X] - mv[MV_X]) > 4 || abs(mvh[MV_Y] - mv[MV_Y]) > 4))
+    {
+        /* refine around the first pass motion as well */
+        mvc[MV_X] = XEVE_CLIP3(pi->min_clip[MV_X], pi->max_clip[MV_X], x + (mvh[MV_X] >> 2));
+        mvc[MV_Y] = XEVE_CLIP3(pi->min_clip[MV_Y], pi->max_clip[MV_Y], y + (mvh[MV_Y] >> 2));
+
+        get_range_ipel(pi, mvc, range_h, 0, ri, lidx);
+
+        mvi[MV_X] = mvh[MV_X] + (x << 2);
+        mvi[MV_Y] = mvh[MV_Y] + (y << 2);
+
+        cost = me_ipel_diamond(pi, x, y, log2_cuw, log2_cuh, ri, lidx, range_h, gmvp, mvi, mvt, bi, &tmpstep, MAX_REFINE_SEARCH_STEP, bit_depth_luma);
+        if(cost < cost_best)
+        {
+            cost_best = cost;
+            mv[MV_X] = mvt[MV_X];
+            mv[MV_Y] = mvt[MV_Y];
+            if(abs(mvp[MV_X] - mv[MV_X]) < 2 && abs(mvp[MV_Y] - mv[MV_Y]) < 2)
+            {
+                beststep = 0;
+            }
+            else
+            {
+                beststep = tmpstep;
+            }
+        }
+    }
+
     int cost_init = XEVE_UINT32_MAX;
     /* Do raster search with best cost found so far */
     cost_init = cost_best;
@@ -1401,6 +1432,166 @@ __inline static int mmvd_info_bit_cost(int mvp_idx, int type)
     return bits;
 }
 
+static void mc_cache_key(XEVE_MC_CACHE_ENTRY * key, int type, int x, int y, int log2_cuw, int log2_cuh, s8 refi[REFP_NUM], s16 mv[REFP_NUM][MV_D])
+{
+    int i;
+
+    key->type = (u8)type;
+    key->x = (u16)x;
+    key->y = (u16)y;
+    key->log2_cuw = (u8)log2_cuw;
+    key->log2_cuh = (u8)log2_cuh;
+    for(i = 0; i < REFP_NUM; i++)
+    {
+        /* motion of an unused list does not take part in the prediction */
+        key->refi[i] = REFI_IS_VALID(refi[i]) ? refi[i] : REFI_INVALID;
+        key->mv[i][MV_X] = REFI_IS_VALID(refi[i]) ? mv[i][MV_X] : 0;
+        key->mv[i][MV_Y] = REFI_IS_VALID(refi[i]) ? mv[i][MV_Y] : 0;
+    }
+}
+
+static int mc_cache_same(XEVE_MC_CACHE_ENTRY * e, XEVE_MC_CACHE_ENTRY * key)
+{
+    return e->type == key->type && e->x == key->x && e->y == key->y && e->log2_cuw == key->log2_cuw && e->log2_cuh == key->log2_cuh
+        && e->refi[REFP_0] == key->refi[REFP_0] && e->refi[REFP_1] == key->refi[REFP_1]
+        && e->mv[REFP_0][MV_X] == key->mv[REFP_0][MV_X] && e->mv[REFP_0][MV_Y] == key->mv[REFP_0][MV_Y]
+        && e->mv[REFP_1][MV_X] == key->mv[REFP_1][MV_X] && e->mv[REFP_1][MV_Y] == key->mv[REFP_1][MV_Y];
+}
+
+/* returns the entry of the key made in the current CTU, or NULL and the
+   entry to be replaced by it */
+static XEVE_MC_CACHE_ENTRY * mc_cache_find(XEVE_MC_CACHE * mc, XEVE_MC_CACHE_ENTRY * key, XEVE_MC_CACHE_ENTRY ** slot)
+{
+    XEVE_MC_CACHE_ENTRY * e[2];
+    u32                   h;
+    int                   i;
+
+    h = ((u32)key->x << 16 | key->y) * 0x9E3779B1u;
+    h ^= ((u32)key->log2_cuw << 24 | (u32)key->log2_cuh << 16 | (u32)key->type << 8 | (u8)key->refi[REFP_0] << 4 | (u8)(key->refi[REFP_1] + 1)) * 0x85EBCA77u;
+    h ^= ((u32)(u16)key->mv[REFP_0][MV_X] << 16 | (u16)key->mv[REFP_0][MV_Y]) * 0xC2B2AE3Du;
+    h ^= ((u32)(u16)key->mv[REFP_1][MV_X] << 16 | (u16)key->mv[REFP_1][MV_Y]) * 0x27D4EB2Fu;
+    h = (h ^ (h >> 15)) & ((MC_CACHE_ENTRY_NUM - 1) & ~1);
+
+    e[0] = &mc->entry[h];
+    e[1] = &mc->entry[h + 1];
+    for(i = 0; i < 2; i++)
+    {
+        if(e[i]->stamp == mc->stamp && mc_cache_same(e[i], key))
+        {
+            if(e[i]->type == MC_CACHE_SATD_MMVD || mc->pos - e[i]->pos <= MC_CACHE_BUF_SIZE)
+            {
+                return e[i];
+            }
+            *slot = e[i];
+            return NULL;
+        }
+    }
+    if(e[0]->stamp != mc->stamp)
+    {
+        *slot = e[0];
+    }
+    else if(e[1]->stamp != mc->stamp)
+    {
+        *slot = e[1];
+    }
+    else
+    {
+        *slot = (s32)(e[0]->seq - e[1]->seq) < 0 ? e[0] : e[1];
+    }
+    return NULL;
+}
+
+static void mc_cache_put(XEVE_MC_CACHE * mc, XEVE_MC_CACHE_ENTRY * slot, XEVE_MC_CACHE_ENTRY * key, int size)
+{
+    *slot = *key;
+    slot->stamp = mc->stamp;
+    slot->seq = mc->seq++;
+    if(size > 0)
+    {
+        /* keep the stored prediction contiguous in the ring */
+        if((mc->pos & (MC_CACHE_BUF_SIZE - 1)) + size > MC_CACHE_BUF_SIZE)
+        {
+            mc->pos += MC_CACHE_BUF_SIZE - (mc->pos & (MC_CACHE_BUF_SIZE - 1));
+        }
+        slot->pos = mc->pos;
+        mc->pos += size;
+    }
+}
+
+/* motion compensation of a skip, merge or MMVD candidate and the sum of
+   squared errors of each component, reused from the CTU cache when the
+   candidate was already predicted at the same position and size */
+static void pinter_mc_cached(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log2_cuw, int log2_cuh, s8 refi[REFP_NUM], s16 mv[REFP_NUM][MV_D]
+                           , pel pred[REFP_NUM][N_C][MAX_CU_DIM], int apply_dmvr, s16 dmvr_mv[MAX_CU_CNT_IN_LCU][REFP_NUM][MV_D], s64 dist[N_C])
+{
+    XEVEM_CORE          * mcore = (XEVEM_CORE *)core;
+    XEVE_PINTER         * pi = &ctx->pinter[core->thread_cnt];
+    XEVE_MC_CACHE       * mc = &mcore->mc_cache;
+    XEVE_MC_CACHE_ENTRY   key, *e = NULL, *slot = NULL;
+    int                   w_shift = ctx->param.cs_w_shift;
+    int                   h_shift = ctx->param.cs_h_shift;
+    int                   size[N_C], size_mv, i;
+    u8                  * buf;
+
+    size[Y_C] = (1 << (log2_cuw + log2_cuh)) * sizeof(pel);
+    size[U_C] = size[V_C] = ctx->sps.chroma_format_idc ? size[Y_C] >> (w_shift + h_shift) : 0;
+    size_mv = (1 << (log2_cuw + log2_cuh - (MIN_CU_LOG2 << 1))) * REFP_NUM * MV_D * sizeof(s16);
+
+    if(ctx->param.mc_cache)
+    {
+        mc_cache_key(&key, apply_dmvr && ctx->sps.tool_dmvr ? MC_CACHE_PRED_DMVR : MC_CACHE_PRED, x, y, log2_cuw, log2_cuh, refi, mv);
+        e = mc_cache_find(mc, &key, &slot);
+    }
+
+    if(e != NULL)
+    {
+        buf = mc->buf + (e->pos & (MC_CACHE_BUF_SIZE - 1));
+        for(i = 0; i < N_C; i++)
+        {
+            xeve_mcpy(pred[0][i], buf, size[i]);
+            buf += size[i];
+            dist[i] = e->dist[i];
+        }
+        mcore->dmvr_flag = e->dmvr_flag;
+        if(e->dmvr_flag && dmvr_mv != NULL)
+        {
+            xeve_mcpy(dmvr_mv, buf, size_mv);
+        }
+        return;
+    }
+
+    pi->fn_mc(ctx, core, x, y, 1 << log2_cuw, 1 << log2_cuh, refi, mv, pi->refp, pred, ctx->poc.poc_val, apply_dmvr, dmvr_mv);
+
+    dist[Y_C] = xeve_ssd_16b(log2_cuw, log2_cuh, pred[0][Y_C], pi->o[Y_C] + x + y * pi->s_o[Y_C], 1 << log2_cuw, pi->s_o[Y_C]
+                           , ctx->sps.bit_depth_luma_minus8 + 8);
+    dist[U_C] = dist[V_C] = 0;
+    if(ctx->sps.chroma_format_idc)
+    {
+        for(i = U_C; i < N_C; i++)
+        {
+            dist[i] = xeve_ssd_16b(log2_cuw - w_shift, log2_cuh - h_shift, pred[0][i], pi->o[i] + (x >> w_shift) + (y >> h_shift) * pi->s_o[i]
+                                 , 1 << (log2_cuw - w_shift), pi->s_o[i], ctx->sps.bit_depth_chroma_minus8 + 8);
+        }
+    }
+
+    if(slot != NULL)
+    {
+        mc_cache_put(mc, slot, &key, size[Y_C] + size[U_C] + size[V_C] + (mcore->dmvr_flag ? size_mv : 0));
+        slot->dmvr_flag = mcore->dmvr_flag;
+        buf = mc->buf + (slot->pos & (MC_CACHE_BUF_SIZE - 1));
+        for(i = 0; i < N_C; i++)
+        {
+            xeve_mcpy(buf, pred[0][i], size[i]);
+            buf += size[i];
+            slot->dist[i] = dist[i];
+        }
+        if(mcore->dmvr_flag)
+        {
+            xeve_mcpy(buf, dmvr_mv, size_mv);
+        }
+    }
+}
+
 static double pinter_residue_rdo_mmvd(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log2_cuw, int log2_cuh, pel pred[2][N_C][MAX_CU_DIM], int pidx)
 {
     XEVE_PINTER * pi = &ctx->pinter[core->thread_cnt];
@@ -1409,18 +1600,38 @@ static double pinter_residue_rdo_mmvd(XEVE_CTX *ctx, XEVE_CORE *core, int x, int
     int           bit_cnt;
     double        cost = 0.0;
     pel         * y_org;
+    XEVE_MC_CACHE_ENTRY key, *e = NULL, *slot = NULL;
 
     w = 1 << log2_cuw;
     h = 1 << log2_cuh;
     log2_w = log2_cuw;
     log2_h = log2_cuh;
 
-    /* prediction */
-    xeve_mc_mmvd(x, y, ctx->w, ctx->h, w, h, pi->refi[pidx], pi->mv[pidx], pi->refp, pred, ctx->sps.bit_depth_luma_minus8 + 8, &mcore->mmvd_opt);
+    if(ctx->param.mc_cache)
+    {
+        mc_cache_key(&key, MC_CACHE_SATD_MMVD, x, y, log2_cuw, log2_cuh, pi->refi[pidx], pi->mv[pidx]);
+        e = mc_cache_find(&mcore->mc_cache, &key, &slot);
+    }
 
-    /* get distortion */
-    y_org = pi->o[Y_C] + x + y * pi->s_o[Y_C];
-    cost = xeve_satd_16b(log2_w, log2_h, pred[0][Y_C], y_org, w, pi->s_o[Y_C], ctx->sps.bit_depth_luma_minus8 + 8);
+    if(e != NULL)
+    {
+        cost = (double)e->dist[Y_C];
+    }
+    else
+    {
+        /* prediction */
+        xeve_mc_mmvd(x, y, ctx->w, ctx->h, w, h, pi->refi[pidx], pi->mv[pidx], pi->refp, pred, ctx->sps.bit_depth_luma_minus8 + 8, &mcore->mmvd_opt);
+
+        /* get distortion */
+        y_org = pi->o[Y_C] + x + y * pi->s_o[Y_C];
+        cost = xeve_satd_16b(log2_w, log2_h, pred[0][Y_C], y_org, w, pi->s_o[Y_C], ctx->sps.bit_depth_luma_minus8 + 8);
+
+        if(slot != NULL)
+        {
+            mc_cache_put(&mcore->mc_cache, slot, &key, 0);
+            slot->dist[Y_C] = (s64)cost;
+        }
+    }
 
     /* get bits */
     bit_cnt = mmvd_info_bit_cost(pi->mmvd_idx[pidx], ctx->sh->mmvd_group_enable_flag && !((1 << core->log2_cuw)*(1 << core->log2_cuh) <= NUM_SAMPLES_BLOCK));
@@ -1770,6 +1981,7 @@ static double pinter_residue_rdo(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, i
     u8     ats_inter_info_match = 255;
     u8     num_rdo_tried = 0;
     s64    dist_idx = -1;
+    int    pred_dist = 0;
     int    w_shift = ctx->param.cs_w_shift;
     int    h_shift = ctx->param.cs_h_shift;
 
@@ -1812,6 +2024,11 @@ static double pinter_residue_rdo(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, i
         xeve_affine_mc(x, y, ctx->w, ctx->h, w[0], h[0], pi->refi[pidx], pi->affine_mv[pidx], pi->refp, pred, mcore->affine_flag + 1, mcore->eif_tmp_buffer
                      , ctx->sps.bit_depth_luma_minus8 + 8, ctx->sps.bit_depth_chroma_minus8 + 8, ctx->sps.chroma_format_idc);
     }
+    else if(pidx == PRED_DIR || pidx == PRED_DIR_MMVD)
+    {
+        pinter_mc_cached(ctx, core, x, y, log2_cuw, log2_cuh, pi->refi[pidx], pi->mv[pidx], pred, apply_dmvr, pi->dmvr_mv[pidx], dist[0]);
+        pred_dist = 1;
+    }
     else
     {
         pi->fn_mc(ctx, core, x, y, w[0], h[0], pi->refi[pidx], pi->mv[pidx], pi->refp, pred, ctx->poc.poc_val, apply_dmvr, pi->dmvr_mv[pidx]);
@@ -1825,7 +2042,7 @@ static double pinter_residue_rdo(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, i
     {
         if(!ctx->sps.chroma_format_idc && i != 0)
             dist[0][i] = 0;
-        else
+        else if(!pred_dist)
         dist[0][i] = xeve_ssd_16b(log2_w[i], log2_h[i], pred[0][i], org[i], w[i], pi->s_o[i], bit_depth_tbl[i]);
         dist_no_resi[i] = dist[0][i];
     }
@@ -2782,7 +2999,6 @@ static double analyze_skip(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log
 {
     XEVEM_CORE      * mcore = (XEVEM_CORE *)core;
     XEVE_PINTER     * pi = &ctx->pinter[core->thread_cnt];
-    pel             * y_org, *u_org, *v_org;
     s16               mvp[REFP_NUM][MV_D];
     s16               dmvr_mv[MAX_CU_CNT_IN_LCU][REFP_NUM][MV_D];
     int               best_dmvr = 0;
@@ -2792,19 +3008,14 @@ static double analyze_skip(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log
     int               j;
     int               cuw, cuh, idx0, idx1, bit_cnt;
     s64               cy, cu, cv;
+    s64               dist[N_C];
     int               w_shift = ctx->param.cs_w_shift;
     int               h_shift = ctx->param.cs_h_shift;
 
     mcore->ats_inter_info = 0;
     cuw = (1 << log2_cuw);
     cuh = (1 << log2_cuh);
-    y_org = pi->o[Y_C] + x + y * pi->s_o[Y_C];
     cu = cv = cy = 0;
-    if(ctx->sps.chroma_format_idc)
-    {
-        u_org = pi->o[U_C] + (x >> w_shift) + ((y >> h_shift) * pi->s_o[U_C]);
-        v_org = pi->o[V_C] + (x >> w_shift) + ((y >> h_shift) * pi->s_o[V_C]);
-    }
     mcore->mmvd_flag = 0;
 
     for(j = 0; j < MAX_NUM_MVP; j++)
@@ -2848,14 +3059,10 @@ static double analyze_skip(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, int log
                 continue;
             }
 
-            pi->fn_mc(ctx, core, x, y, cuw, cuh, refi, mvp, pi->refp, pi->pred[PRED_NUM], ctx->poc.poc_val, TRUE, dmvr_mv);
-
-            cy = xeve_ssd_16b(log2_cuw, log2_cuh, pi->pred[PRED_NUM][0][Y_C], y_org, cuw, pi->s_o[Y_C], ctx->sps.bit_depth_luma_minus8 + 8);
-            if(ctx->sps.chroma_format_idc)
-            {
-                cu = xeve_ssd_16b(log2_cuw - w_shift, log2_cuh - h_shift, pi->pred[PRED_NUM][0][U_C], u_org, cuw >> w_shift, pi->s_o[U_C], ctx->sps.bit_depth_chroma_minus8 + 8);
-                cv = xeve_ssd_16b(log2_cuw - w_shift, log2_cuh - h_shift, pi->pred[PRED_NUM][0][V_C], v_org, cuw >> w_shift, pi->s_o[V_C], ctx->sps.bit_depth_chroma_minus8 + 8);
-            }
+            pinter_mc_cached(ctx, core, x, y, log2_cuw, log2_cuh, refi, mvp, pi->pred[PRED_NUM], TRUE, dmvr_mv, dist);
+            cy = dist[Y_C];
+            cu = dist[U_C];
+            cv = dist[V_C];
 
             if(ctx->param.rdo_dbk_switch)
             {
@@ -3141,12 +3348,12 @@ static double analyze_skip_mmvd(XEVE_CTX * ctx, XEVE_CORE * core, int x, int y,
 {
     XEVEM_CORE      *mcore = (XEVEM_CORE*)core;
     XEVE_PINTER     *pi = &ctx->pinter[core->thread_cnt];
-    pel             *y_org, *u_org, *v_org;
     s16              mvp[REFP_NUM][MV_D];
     s8               refi[REFP_NUM];
     double           cost, cost_best = MAX_COST;
     int              cuw, cuh, bit_cnt;
     s64              cy, cu, cv;
+    s64              dist[N_C];
     int              c_num = 0;
     int              t_base_num = 0;
     int              best_idx_num = -1;
@@ -3168,12 +3375,6 @@ static double analyze_skip_mmvd(XEVE_CTX * ctx, XEVE_CORE * core, int x, int y,
 
     cuw = (1 << log2_cuw);
     cuh = (1 << log2_cuh);
-    y_org = pi->o[Y_C] + x + y * pi->s_o[Y_C];
-    if(ctx->sps.chroma_format_idc)
-    {
-        u_org = pi->o[U_C] + (x >> w_shift) + ((y >> h_shift) * pi->s_o[U_C]);
-        v_org = pi->o[V_C] + (x >> w_shift) + ((y >> h_shift) * pi->s_o[V_C]);
-    }
 
     pi->mvp_idx[PRED_SKIP_MMVD][REFP_0] = 0;
     pi->mvp_idx[PRED_SKIP_MMVD][REFP_1] = 0;
@@ -3216,14 +3417,10 @@ static double analyze_skip_mmvd(XEVE_CTX * ctx, XEVE_CORE * core, int x, int y,
             continue;
         }
 
-        pi->fn_mc(ctx, core, x, y, cuw, cuh, refi, mvp, pi->refp, pi->pred[PRED_NUM], ctx->poc.poc_val, FALSE, NULL);
-
-        cy = xeve_ssd_16b(log2_cuw, log2_cuh, pi->pred[PRED_NUM][0][Y_C], y_org, cuw, pi->s_o[Y_C], ctx->sps.bit_depth_luma_minus8 + 8);
-        if(ctx->sps.chroma_format_idc)
-        {
-            cu = xeve_ssd_16b(log2_cuw - w_shift, log2_cuh - h_shift, pi->pred[PRED_NUM][0][U_C], u_org, cuw >> w_shift, pi->s_o[U_C], ctx->sps.bit_depth_chroma_minus8 + 8);
-            cv = xeve_ssd_16b(log2_cuw - w_shift, log2_cuh - h_shift, pi->pred[PRED_NUM][0][V_C], v_org, cuw >> w_shift, pi->s_o[V_C], ctx->sps.bit_depth_chroma_minus8 + 8);
-        }
+        pinter_mc_cached(ctx, core, x, y, log2_cuw, log2_cuh, refi, mvp, pi->pred[PRED_NUM], FALSE, NULL, dist);
+        cy = dist[Y_C];
+        cu = dist[U_C];
+        cv = dist[V_C];
 
         if(ctx->param.rdo_dbk_switch)
         {
@@ -4591,54 +4788,60 @@ static double pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, in
         xeve_mcpy(pi->nnz_sub_best[PRED_SKIP], core->nnz_sub, sizeof(int) * N_C * MAX_SUB_TB_NUM);
     }
 
-    cost = cost_inter[PRED_DIR] = analyze_merge(ctx, core, x, y, log2_cuw, log2_cuh);
-    if(cost < cost_best)
-    {
-        core->cu_mode = MODE_DIR;
-        best_idx = PRED_DIR;
-        cost_inter[best_idx] = cost_best = cost;
-        best_dmvr = mcore->dmvr_flag;
-        mcore->dmvr_flag = 0;
-
-        for(i = 0; i < N_C; i++)
-        {
-            if(i != 0 && !ctx->sps.chroma_format_idc)
-                continue;
-            int size_tmp = (cuw * cuh) >> (i == 0 ? 0 : w_shift + h_shift);
-            xeve_mcpy(pi->pred[best_idx][0][i], pi->pred[PRED_NUM][0][i], size_tmp * sizeof(pel));
-            xeve_mcpy(pi->coef[best_idx][i], pi->coef[PRED_NUM][i], size_tmp * sizeof(s16));
-        }
-        SBAC_STORE(core->s_next_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_best_merge);
-        DQP_STORE(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], core->dqp_temp_best_merge);
-    }
+    /* a static CTU keeps the skip mode of its largest inter CU when it is good enough */
+    core->static_hit = cost_best < MAX_COST && xeve_pinter_static_skip(ctx, core, x, y, log2_cuw, log2_cuh);
 
-    if(ctx->sps.tool_mmvd && ((pi->slice_type == SLICE_B) || (pi->slice_type == SLICE_P)))
+    if(!core->static_hit)
     {
-        /* MMVD mode for merge */
-        cost = cost_inter[PRED_DIR_MMVD] = analyze_merge_mmvd(ctx, core, x, y, log2_cuw, log2_cuh, real_mv);
+        cost = cost_inter[PRED_DIR] = analyze_merge(ctx, core, x, y, log2_cuw, log2_cuh);
         if(cost < cost_best)
         {
-            core->cu_mode = MODE_DIR_MMVD;
-            best_idx = PRED_DIR_MMVD;
+            core->cu_mode = MODE_DIR;
+            best_idx = PRED_DIR;
             cost_inter[best_idx] = cost_best = cost;
-            best_dmvr = 0;
-            cost_best = cost;
-            SBAC_STORE(core->s_next_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_best);
-            DQP_STORE(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], core->dqp_temp_best);
+            best_dmvr = mcore->dmvr_flag;
+            mcore->dmvr_flag = 0;
+
+            for(i = 0; i < N_C; i++)
+            {
+                if(i != 0 && !ctx->sps.chroma_format_idc)
+                    continue;
+                int size_tmp = (cuw * cuh) >> (i == 0 ? 0 : w_shift + h_shift);
+                xeve_mcpy(pi->pred[best_idx][0][i], pi->pred[PRED_NUM][0][i], size_tmp * sizeof(pel));
+                xeve_mcpy(pi->coef[best_idx][i], pi->coef[PRED_NUM][i], size_tmp * sizeof(s16));
+            }
+            SBAC_STORE(core->s_next_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_best_merge);
+            DQP_STORE(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], core->dqp_temp_best_merge);
         }
 
-        /* MMVD mode for skip */
-        cost = cost_inter[PRED_SKIP_MMVD] = analyze_skip_mmvd(ctx, core, x, y, log2_cuw, log2_cuh, real_mv);
-        if(cost < cost_best)
+        if(ctx->sps.tool_mmvd && ((pi->slice_type == SLICE_B) || (pi->slice_type == SLICE_P)))
         {
-            core->cu_mode = MODE_SKIP_MMVD;
-            best_idx = PRED_SKIP_MMVD;
-            best_dmvr = 0;
-            cost_inter[best_idx] = cost_best = cost;
-            SBAC_STORE(core->s_next_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_best);
-            DQP_STORE(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], core->dqp_temp_best);
-            xeve_mset(pi->nnz_best[PRED_SKIP_MMVD], 0, sizeof(int) * N_C);
-            xeve_mcpy(pi->nnz_sub_best[PRED_SKIP_MMVD], core->nnz_sub, sizeof(int) * N_C * MAX_SUB_TB_NUM);
+            /* MMVD mode for merge */
+            cost = cost_inter[PRED_DIR_MMVD] = analyze_merge_mmvd(ctx, core, x, y, log2_cuw, log2_cuh, real_mv);
+            if(cost < cost_best)
+            {
+                core->cu_mode = MODE_DIR_MMVD;
+                best_idx = PRED_DIR_MMVD;
+                cost_inter[best_idx] = cost_best = cost;
+                best_dmvr = 0;
+                cost_best = cost;
+                SBAC_STORE(core->s_next_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_best);
+                DQP_STORE(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], core->dqp_temp_best);
+            }
+
+            /* MMVD mode for skip */
+            cost = cost_inter[PRED_SKIP_MMVD] = analyze_skip_mmvd(ctx, core, x, y, log2_cuw, log2_cuh, real_mv);
+            if(cost < cost_best)
+            {
+                core->cu_mode = MODE_SKIP_MMVD;
+                best_idx = PRED_SKIP_MMVD;
+                best_dmvr = 0;
+                cost_inter[best_idx] = cost_best = cost;
+                SBAC_STORE(core->s_next_best[log2_cuw - 2][log2_cuh - 2], core->s_temp_best);
+                DQP_STORE(core->dqp_next_best[log2_cuw - 2][log2_cuh - 2], core->dqp_temp_best);
+                xeve_mset(pi->nnz_best[PRED_SKIP_MMVD], 0, sizeof(int) * N_C);
+                xeve_mcpy(pi->nnz_sub_best[PRED_SKIP_MMVD], core->nnz_sub, sizeof(int) * N_C * MAX_SUB_TB_NUM);
+            }
         }
     }
 
@@ -4870,7 +5073,7 @@ static double pinter_analyze_cu(XEVE_CTX *ctx, XEVE_CORE *core, int x, int y, in
         }
     }
 
-    if(ctx->slice_depth < 4)
+    if(ctx->slice_depth < 4 && !core->static_hit)
     {
         if(allow_affine && cuw >= 8 && cuh >= 8)
         {
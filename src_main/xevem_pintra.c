@@ -178,7 +178,95 @@ static void pintra_ipred(XEVE_CTX * ctx, XEVE_CORE * core, pel * pred_buf, int i
 }
 
 /* For Main profile */
-static int make_ipred_list(XEVE_CTX * ctx, XEVE_CORE * core, int log2_cuw, int log2_cuh, pel * org, int s_org, int * ipred_list)
+/* For Main profile */
+static u32 * pintra_unit_satd(XEVE_CTX * ctx, XEVE_CORE * core, int x, int y)
+{
+    XEVEM_CORE      * mcore = (XEVEM_CORE*)core;
+    XEVE_PINTRA     * pi = &ctx->pintra[core->thread_cnt];
+    XEVE_IPD_PRESEL * ps = &mcore->ipd_presel;
+    int               idx = ((y - core->y_pel) >> IPD_UNIT_LOG2) * IPD_UNIT_STRIDE + ((x - core->x_pel) >> IPD_UNIT_LOG2);
+    int               s_org = pi->s_o[Y_C];
+    int               bit_depth = ctx->sps.bit_depth_luma_minus8 + 8;
+    int               size = 1 << IPD_UNIT_LOG2;
+    pel             * org = pi->o[Y_C] + y * s_org + x;
+    pel               nb[N_REF][MAX_CU_SIZE * 3];
+    pel               pred[1 << (IPD_UNIT_LOG2 << 1)];
+    pel             * left = nb[0] + 2, * up = nb[1] + size, * right = nb[2] + 2;
+    int               i;
+
+    if(ps->stamp[idx] == ps->cur)
+    {
+        return ps->satd[idx];
+    }
+
+    /* reference samples from the original picture, replicated at the
+       picture boundaries */
+    for(i = -size; i < (size << 1); i++)
+    {
+        up[i] = y > 0 ? org[-s_org + XEVE_CLIP3(-x, ctx->w - 1 - x, i)] : 1 << (bit_depth - 1);
+    }
+    left[-1] = up[-1];
+    for(i = 0; i < (size << 1); i++)
+    {
+        left[i] = x > 0 ? org[XEVE_MIN(i, ctx->h - 1 - y) * s_org - 1] : up[-1];
+    }
+    left[-2] = left[-1];
+    for(i = -2; i < (size << 1); i++)
+    {
+        right[i] = up[size];
+    }
+
+    for(i = 0; i < IPD_CNT; i++)
+    {
+        xevem_ipred(left, up, right, LR_10, pred, i, size, size, bit_depth);
+        ps->satd[idx][i] = xeve_satd_16b(IPD_UNIT_LOG2, IPD_UNIT_LOG2, org, pred, s_org, size, bit_depth);
+    }
+    ps->stamp[idx] = ps->cur;
+
+    return ps->satd[idx];
+}
+
+/* For Main profile */
+static void pintra_presel_ipd(XEVE_CTX * ctx, XEVE_CORE * core, int x, int y, int log2_cuw, int log2_cuh, int num, u8 * presel)
+{
+    u64   satd[IPD_CNT];
+    u32 * unit;
+    int   i, j, k, best;
+
+    xeve_mset(satd, 0, sizeof(satd));
+    for(j = 0; j < (1 << log2_cuh); j += (1 << IPD_UNIT_LOG2))
+    {
+        for(i = 0; i < (1 << log2_cuw); i += (1 << IPD_UNIT_LOG2))
+        {
+            unit = pintra_unit_satd(ctx, core, x + i, y + j);
+            for(k = 0; k < IPD_CNT; k++)
+            {
+                satd[k] += unit[k];
+            }
+        }
+    }
+
+    xeve_mset(presel, 0, IPD_CNT);
+    for(i = 0; i < num; i++)
+    {
+        best = -1;
+        for(k = 0; k < IPD_CNT; k++)
+        {
+            if(!presel[k] && (best < 0 || satd[k] < satd[best]))
+            {
+                best = k;
+            }
+        }
+        presel[best] = 1;
+    }
+
+    /* the most probable modes are cheap to signal, and DC fills the list */
+    presel[core->mpm[0]] = 1;
+    presel[core->mpm[1]] = 1;
+    presel[IPD_DC] = 1;
+}
+
+static int make_ipred_list(XEVE_CTX * ctx, XEVE_CORE * core, int x, int y, int log2_cuw, int log2_cuh, pel * org, int s_org, int * ipred_list)
 {
     XEVE_PINTRA *pi = &ctx->pintra[core->thread_cnt];
 
@@ -187,6 +275,8 @@ static int make_ipred_list(XEVE_CTX * ctx, XEVE_CORE * core, int log2_cuw, int l
     u32 cand_satd_cost[IPD_RDO_CNT];
     u32 cost_satd;
     const int ipd_rdo_cnt = XEVE_ABS(log2_cuw - log2_cuh) >= 2 ? IPD_RDO_CNT - 1 : IPD_RDO_CNT;
+    u8 presel[IPD_CNT];
+    int use_presel;
 
     cuw = 1 << log2_cuw;
     cuh = 1 << log2_cuh;
@@ -200,11 +290,25 @@ static int make_ipred_list(XEVE_CTX * ctx, XEVE_CORE * core, int log2_cuw, int l
 
     pred_cnt = (ctx->sps.tool_eipd) ? IPD_CNT : IPD_CNT_B;
 
+    /* CUs of several units only predict the modes ranked best by the unit
+       costs */
+    use_presel = ctx->param.ipd_presel > 0 && ctx->sps.tool_eipd && log2_cuw >= IPD_UNIT_LOG2 && log2_cuh >= IPD_UNIT_LOG2
+              && log2_cuw + log2_cuh > (IPD_UNIT_LOG2 << 1);
+    if(use_presel)
+    {
+        pintra_presel_ipd(ctx, core, x, y, log2_cuw, log2_cuh, XEVE_MAX(ctx->param.ipd_presel, ipd_rdo_cnt), presel);
+    }
+
     for(i = 0; i < pred_cnt; i++)
     {
         int bit_cnt, shift = 0;
         pel * pred_buf = NULL;
 
+        if(use_presel && !presel[i])
+        {
+            continue;
+        }
+
         pred_buf = pi->pred_cache[i];
 
         pintra_ipred(ctx, core, pred_buf, i, cuw, cuh);
@@ -374,7 +478,7 @@ static double pintra_analyze_cu(XEVE_CTX* ctx, XEVE_CORE* core, int x, int y, in
 
     if(xeve_check_luma(core->tree_cons))
     {
-        pred_cnt = make_ipred_list(ctx, core, log2_cuw, log2_cuh, org, s_org, ipred_list);
+        pred_cnt = make_ipred_list(ctx, core, x, y, log2_cuw, log2_cuh, org, s_org, ipred_list);
         if(pred_cnt == 0)
         {
             return MAX_COST;
@@ -38,6 +38,8 @@
 #include "xevem_recon.h"
 #include <math.h>
 
+XEVEM_HTDF_FILTER xevem_func_htdf_filter;
+
 
 void xeve_recon_w_ats(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, u8 ats_inter_info, int bit_depth)
 {
@@ -123,15 +125,6 @@ void xeve_recon_w_ats(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s
 
 
 
-#define HTDF_LUT_QP_NUM                                   5   // num of LUTs
-#define HTDF_LUT_SIZE_LOG2                                4   // table size in bits
-#define HTDF_LUT_MIN_QP                                   20  // LUT min QP
-#define HTDF_LUT_STEP_QP_LOG2                             3   // LUT QP step
-#define HTDF_FAST_TBL                                     1   // bit mask check & abs operations, SW friendly implementation
-#define HTDF_BIT_RND4                                     2
-#define HTDF_CNT_SCALE                                    2
-#define HTDF_CNT_SCALE_RND                                (1 << (HTDF_CNT_SCALE - 1))
-
 // clang-format off
 
 static u8 HTDF_table_thr_log2[HTDF_LUT_QP_NUM] = { 6, 7, 7, 8, 8 };
@@ -242,7 +235,7 @@ static void filter_block_luma(pel *block, const u8 HTDF_table[HTDF_LUT_QP_NUM][1
     idx = XEVE_MAX(idx, 0);
     idx = XEVE_MIN(idx, HTDF_LUT_QP_NUM - 1);
 
-    xeve_htdf_filter_block(block, acc_block, HTDF_table[idx], stride, width, width, height, HTDF_table_thr_log2[idx],  bit_depth);
+    xevem_func_htdf_filter(block, acc_block, HTDF_table[idx], stride, width, width, height, HTDF_table_thr_log2[idx],  bit_depth);
 }
 
 BOOL xeve_htdf_skip_condition(int width, int height, int IntraBlockFlag, int *qp)
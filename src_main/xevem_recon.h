@@ -36,6 +36,20 @@
 #ifndef _XEVEM_RECON_H_
 #define _XEVEM_RECON_H_
 
+#define HTDF_LUT_QP_NUM                                   5   // num of LUTs
+#define HTDF_LUT_SIZE_LOG2                                4   // table size in bits
+#define HTDF_LUT_MIN_QP                                   20  // LUT min QP
+#define HTDF_LUT_STEP_QP_LOG2                             3   // LUT QP step
+#define HTDF_FAST_TBL                                     1   // bit mask check & abs operations, SW friendly implementation
+#define HTDF_BIT_RND4                                     2
+#define HTDF_CNT_SCALE                                    2
+#define HTDF_CNT_SCALE_RND                                (1 << (HTDF_CNT_SCALE - 1))
+
+typedef void (*XEVEM_HTDF_FILTER)(pel *block, pel *acc_block, const u8 *tbl, int stride_block, int stride_acc, int width, int height, int tbl_thr_log2, int bit_depth);
+extern XEVEM_HTDF_FILTER xevem_func_htdf_filter;
+
+void xeve_htdf_filter_block(pel *block, pel *acc_block, const u8 *tbl, int stride_block, int stride_acc, int width, int height, int tbl_thr_log2, int bit_depth);
+
 void xeve_recon_w_ats(s16 *coef, pel *pred, int is_coef, int cuw, int cuh, int s_rec, pel *rec, u8 ats_inter_info, int bit_depth);
 
 void xeve_htdf(s16* rec, int qp, int w, int h, int s, BOOL intra_block_flag, pel* rec_pic, int s_pic, int avail_cu
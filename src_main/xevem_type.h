@@ -80,6 +80,68 @@ struct _XEVE_MMVD_OPT
     int                enabled;
 };
 
+/* the skip, merge and MMVD analyses of a CU try the same candidates, and
+   the split trees of a CTU reach the same CU position and size several
+   times, so the motion compensated prediction of a candidate and its
+   distortion are kept by position, size and motion until the next CTU */
+#define MC_CACHE_LOG2_ENTRY     12
+#define MC_CACHE_ENTRY_NUM      (1 << MC_CACHE_LOG2_ENTRY)
+#define MC_CACHE_BUF_SIZE       (1 << 20)
+
+enum MC_CACHE_TYPE
+{
+    MC_CACHE_NONE,
+    /* prediction without DMVR */
+    MC_CACHE_PRED,
+    /* prediction with DMVR and the refined motion */
+    MC_CACHE_PRED_DMVR,
+    /* luma SATD of the bilinear MMVD pre-selection */
+    MC_CACHE_SATD_MMVD
+};
+
+typedef struct _XEVE_MC_CACHE_ENTRY
+{
+    /* CTU the entry was made in */
+    u32                stamp;
+    /* insertion order, the older of two colliding entries is replaced */
+    u32                seq;
+    /* position of the stored prediction in the ring buffer */
+    u32                pos;
+    u16                x, y;
+    u8                 log2_cuw, log2_cuh;
+    u8                 type;
+    u8                 dmvr_flag;
+    s8                 refi[REFP_NUM];
+    s16                mv[REFP_NUM][MV_D];
+    s64                dist[N_C];
+} XEVE_MC_CACHE_ENTRY;
+
+typedef struct _XEVE_MC_CACHE
+{
+    XEVE_MC_CACHE_ENTRY entry[MC_CACHE_ENTRY_NUM];
+    /* ring buffer of the stored predictions. an entry is valid as long as
+       no more than MC_CACHE_BUF_SIZE bytes were written from its position */
+    u8                 buf[MC_CACHE_BUF_SIZE];
+    u32                pos;
+    u32                seq;
+    u32                stamp;
+} XEVE_MC_CACHE;
+
+/* SATD of every intra mode for the 8x8 luma units of a CTU, predicted from
+   the original samples around each unit. the sums over the units of a CU
+   rank the intra modes before the CU is predicted with its own reference
+   samples */
+#define IPD_UNIT_LOG2           3
+#define IPD_UNIT_STRIDE         (1 << (MAX_CU_LOG2 - IPD_UNIT_LOG2))
+
+typedef struct _XEVE_IPD_PRESEL
+{
+    u32                satd[IPD_UNIT_STRIDE * IPD_UNIT_STRIDE][IPD_CNT];
+    /* CTU the SATD of each unit was computed in */
+    u32                stamp[IPD_UNIT_STRIDE * IPD_UNIT_STRIDE];
+    u32                cur;
+} XEVE_IPD_PRESEL;
+
 /*****************************************************************************
  * CORE information used for encoding process.
  *
@@ -111,6 +173,8 @@ typedef struct _XEVEM_CORE
     u8                  dmvr_flag;
     XEVE_BEF_DATA       bef_data[NUM_CU_LOG2][NUM_CU_LOG2][MAX_CU_CNT_IN_LCU][MAX_BEF_DATA_NUM];
     XEVE_MMVD_OPT       mmvd_opt;
+    XEVE_MC_CACHE       mc_cache;
+    XEVE_IPD_PRESEL     ipd_presel;
 }XEVEM_CORE;
 
 /******************************************************************************
@@ -173,6 +237,11 @@ typedef struct _XEVEM_CTX
 #include "xevem_itdq_avx.h"
 #include "xevem_itdq_sse.h"
 #include "xevem_mc_sse.h"
+#include "xevem_mc_avx.h"
+#include "xevem_recon_sse.h"
+#include "xevem_recon_avx.h"
+#else
+#include "xevem_recon_neon.h"
 #endif
 #if GRAB_STAT
 #include "xevem_stat.h"
@@ -2896,6 +2896,10 @@ XEVEM_CORE * xevem_core_alloc(int chroma_format_idc)
 
     core = (XEVE_CORE *)mcore;
 
+    /* RDO bit counting buffers restart from the same source many times */
+    core->s_temp_run.ckpt_on = 1;
+    core->s_temp_prev_comp_run.ckpt_on = 1;
+
     for (i = 0; i < MAX_CU_LOG2; i++)
     {
         for (j = 0; j < MAX_CU_LOG2; j++)
@@ -3042,6 +3046,8 @@ int xevem_set_init_param(XEVE_CTX * ctx, XEVE_PARAM * param)
     /* check input parameters */
 
     xeve_assert_rv(param->w > 0 && param->h > 0, XEVE_ERR_INVALID_ARGUMENT);
+    /* DRA works on 10bit pictures and their copies only */
+    xeve_assert_rv(param->tool_dra == 0 || param->codec_bit_depth > 8, XEVE_ERR_INVALID_ARGUMENT);
 
     if (!ctx->chroma_qp_table_struct.chroma_qp_table_present_flag)
     {
@@ -3740,7 +3746,7 @@ ERR:
         xeve_mfree(mctx->dra_array);
     }
 
-    if (ctx->param.tool_alf || ctx->param.tool_dra)
+    if ((ctx->param.tool_alf || ctx->param.tool_dra) && ctx->aps_gen_array)
     {
         if (ctx->param.tool_alf)
         {
@@ -3942,6 +3948,12 @@ void xevem_platform_init_func()
         xeve_func_intra_pred_ang = xeve_tbl_intra_pred_ang; /* to be updated */
         xeve_func_tx = &xeve_tbl_tx_avx;
         xeve_func_itx = &xeve_tbl_itx_avx;
+        xevem_func_htdf_filter = &xevem_htdf_filter_block_avx;
+        xevem_func_eif_bl_clip = &xevem_eif_bilinear_clip_avx;
+        xevem_func_eif_bl_no_clip = &xevem_eif_bilinear_no_clip_avx;
+        xevem_func_eif_filter = &xevem_eif_filter_avx;
+        xevem_func_dmvr_cost = &xevem_dmvr_cost_avx;
+        xevem_func_dmvr_cross_cost = &xevem_dmvr_cross_cost_avx;
     }
     else if (support_sse)
     {
@@ -3955,6 +3967,12 @@ void xevem_platform_init_func()
         xeve_func_intra_pred_ang = xeve_tbl_intra_pred_ang; /* to be updated */
         xeve_func_tx = &xeve_tbl_tx; /* to be updated */
         xeve_func_itx = &xeve_tbl_itx; /* to be updated */
+        xevem_func_htdf_filter = &xevem_htdf_filter_block_sse;
+        xevem_func_eif_bl_clip = &xeve_eif_bilinear_clip; /* to be updated */
+        xevem_func_eif_bl_no_clip = &xeve_eif_bilinear_no_clip; /* to be updated */
+        xevem_func_eif_filter = &xeve_eif_filter; /* to be updated */
+        xevem_func_dmvr_cost = &xevem_dmvr_cost_sse;
+        xevem_func_dmvr_cross_cost = &xevem_dmvr_cross_cost_sse;
     }
     else
 #endif
@@ -3969,6 +3987,16 @@ void xevem_platform_init_func()
         xeve_func_intra_pred_ang = xeve_tbl_intra_pred_ang;
         xeve_func_tx = &xeve_tbl_tx;
         xeve_func_itx = &xeve_tbl_itx;
+        xevem_func_eif_bl_clip = &xeve_eif_bilinear_clip;
+        xevem_func_eif_bl_no_clip = &xeve_eif_bilinear_no_clip;
+        xevem_func_eif_filter = &xeve_eif_filter;
+        xevem_func_dmvr_cost = &xeve_dmvr_cost;
+        xevem_func_dmvr_cross_cost = &xeve_dmvr_cross_cost;
+#if ARM_NEON
+        xevem_func_htdf_filter = &xevem_htdf_filter_block_neon;
+#else
+        xevem_func_htdf_filter = &xeve_htdf_filter_block;
+#endif
     }
 }
 
@@ -4020,7 +4048,7 @@ int xevem_platform_init(XEVE_CTX * ctx)
     ctx->fn_set_tile_info   = xevem_set_tile_info;
     ctx->fn_deblock_tree    = xevem_deblock_tree;
     ctx->fn_deblock_unit    = xevem_deblock_unit;
-    ctx->fn_pic_flt         = xevem_pic_filt;
+    ctx->fn_pic_flt         = ctx->param.tool_dra ? xevem_pic_filt : NULL;
     ctx->fn_deblock         = xevem_deblock;
     mctx->fn_alf            = xevem_alf_aps;
 